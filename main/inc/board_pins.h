@@ -1,6 +1,7 @@
 #pragma once
 
 #include "driver/spi_master.h"
+#include "driver/uart.h"
 
 // ESP32-035 (littleCdev) pinout, matches Hardware.md in https://github.com/littleCdev/ESP32-035
 // TFT ST7796 over SPI
@@ -28,4 +29,8 @@
 #define SD_PIN_MOSI  23
 #define SD_PIN_MISO  19
 #define SD_PIN_CS    5
-#define SD_HOST      SPI3_HOST
\ No newline at end of file
+#define SD_HOST      SPI3_HOST
+
+// Telemetry UART (binary position stream to a PC or rotator controller), TX only
+#define TLM_UART       UART_NUM_1
+#define PIN_NUM_TLM_TX 17
@@ -1,13 +1,22 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include "esp_err.h"
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
 #include "esp_lcd_touch.h"
 
+#include "orbit_sched.h"
+
 #define DEBUG_DISPLAY 0 // set to 1 to enable RGB debug sweeps
+#define BENCH_DISPLAY 0 // set to 1 to benchmark the flush pipeline (pclk/band/queue sweep) at boot
+
+// Set from main/CMakeLists.txt together with the image conversion format
+#ifndef DISPLAY_NATIVE_RGB565
+#define DISPLAY_NATIVE_RGB565 0
+#endif
 
 typedef struct {
     esp_lcd_panel_io_handle_t io;
@@ -26,3 +35,30 @@ esp_err_t display_lvgl_init(display_t *disp);
 void fill_screen(display_t *disp, uint16_t color);
 
 bool display_poll_touch(display_t *disp, uint16_t *x, uint16_t *y, uint16_t *strength);
+
+// Shared SPI bus usage per device since the last reset
+typedef struct {
+    uint64_t busy_us;     // time the device had transactions on the bus
+    uint64_t wait_us;     // time spent waiting for the bus (touch: deferred behind flushes)
+    uint32_t max_wait_us;
+    uint32_t transactions;
+} display_bus_dev_stats_t;
+
+typedef struct {
+    display_bus_dev_stats_t lcd;
+    display_bus_dev_stats_t touch;
+    uint32_t touch_deferred; // samples that waited for a gap between flush bands
+    uint32_t touch_forced;   // samples taken behind a flush when the latency bound expired
+    int64_t window_us;
+} display_bus_stats_t;
+
+void display_get_bus_stats(display_bus_stats_t *out_stats, bool reset);
+
+// LVGL refresh timing in the scheduler's terms: lateness after the previous
+// refresh start plus the refresh period, execution from refresh start to ready
+typedef struct {
+    int64_t period_us;
+    orbit_sched_stats_t stats;
+} display_refresh_stats_t;
+
+void display_get_refresh_stats(display_refresh_stats_t *out_stats, bool reset);
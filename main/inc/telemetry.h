@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+#include "board_pins.h"
+#include "orbit_catalog.h"
+#include "orbit_observer.h"
+
+// Binary position stream over a UART for a logging PC or an antenna rotator
+// (wire format in orbit_telemetry_format.h, reader in tools/tlm_decode). The
+// main loop frames messages into a ring buffer without blocking; a writer task
+// drains it to the UART.
+typedef struct {
+    int uart_num;
+    int tx_pin;
+    int baud;
+    float rate_hz;     // messages per second, capped by the main loop period
+    size_t ring_bytes; // frames queued ahead of the UART; full means dropped
+} telemetry_config_t;
+
+#define TELEMETRY_DEFAULT_CONFIG() \
+    {.uart_num = TLM_UART, .tx_pin = PIN_NUM_TLM_TX, .baud = 921600, .rate_hz = 10.0f, .ring_bytes = 4096}
+
+esp_err_t telemetry_start(const telemetry_config_t *cfg);
+
+// Satellites to stream, at most ORBIT_TLM_MAX_RECORDS. None pauses the stream.
+esp_err_t telemetry_set_subset(const uint32_t *norad_ids, size_t count);
+
+// Propagate the subset to now and queue one message when it is due. Look angles
+// are from st.
+void telemetry_tick(orbit_catalog_t *catalog, const orbit_station_t *st, double now);
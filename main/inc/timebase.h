@@ -0,0 +1,45 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+
+// Application clock read by the orbit ticks and the UI. Real time runs from a
+// reference (the fixed start time until SNTP/RTC) at 1x; simulation runs at
+// TIMEBASE_RATE_MIN..TIMEBASE_RATE_MAX, can be paused and stepped.
+#define TIMEBASE_RATE_MIN 10.0f
+#define TIMEBASE_RATE_MAX 10000.0f
+
+// Start in real time at unix_time_sec
+void timebase_init(int64_t unix_time_sec);
+
+// Re-anchor the real clock (SNTP/RTC sync). Simulation keeps its own time.
+void timebase_set_real(int64_t unix_time_sec);
+
+// 1 returns to real time (at the real clock, not where the simulation was);
+// other rates switch to simulation from the current time
+esp_err_t timebase_set_rate(float rate);
+void timebase_set_paused(bool paused);
+void timebase_step(double seconds);
+
+bool timebase_is_sim(void);
+float timebase_rate(void);
+bool timebase_paused(void);
+
+// Advance the simulation, once per main loop iteration. A wall-clock gap longer
+// than a frame (the loop was busy) is only partly played: under load the
+// simulation slows down instead of skipping ahead.
+void timebase_tick(void);
+
+double timebase_now(void);
+int64_t timebase_now_unix(void);
+
+// Simulated seconds played per wall second since the last reset
+typedef struct {
+    double sim_s;
+    int64_t wall_us;
+    int64_t dropped_us; // wall time not played because of the per-tick clamp
+} timebase_stats_t;
+
+void timebase_get_stats(timebase_stats_t *out_stats, bool reset);
@@ -1,3 +1,102 @@
 #pragma once
 
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit_proj.h"
+
 void ui_init(void);
+
+// Map projection. Anything but the equirectangular source image is reprojected
+// once into a cached half-resolution background; markers are placed from
+// orbit_proj_forward_batch() output. The footprint and coverage overlays are
+// equirectangular grids and stay hidden on other projections.
+void ui_map_set_projection(const orbit_proj_t *proj);
+
+// Map marker of one catalog satellite. Hidden until it gets a position. A name
+// (optional) is tagged next to it where it doesn't overlap another tag.
+typedef struct ui_sat_marker_t ui_sat_marker_t;
+
+ui_sat_marker_t *ui_sat_marker_create(uint32_t norad_id, const char *name);
+void ui_sat_marker_destroy(ui_sat_marker_t *marker);
+void ui_sat_marker_set_pos(ui_sat_marker_t *marker, int16_t x, int16_t y);
+// Eclipsed satellites are drawn dimmed
+void ui_sat_marker_set_sunlit(ui_sat_marker_t *marker, bool sunlit);
+
+// Satellite list screen. Only the visible rows exist as LVGL objects; their data is
+// pulled through the row callback (called with the LVGL lock held) when a row
+// scrolls into view or on ui_sat_list_refresh().
+typedef struct {
+    char name[25];
+    bool has_elevation;
+    float elevation_deg;
+    int64_t next_pass_unix; // 0 when unknown
+    bool has_illum;
+    bool sunlit;
+    bool has_magnitude; // visible, sunlit and the station in darkness
+    float magnitude;
+} ui_sat_row_t;
+
+typedef bool (*ui_sat_list_row_cb_t)(size_t index, ui_sat_row_t *row, void *ctx);
+
+void ui_sat_list_set_source(size_t count, ui_sat_list_row_cb_t row_cb, void *ctx);
+void ui_sat_list_refresh(void);
+
+// Called when a list row is tapped
+typedef void (*ui_sat_list_select_cb_t)(size_t index, void *ctx);
+void ui_sat_list_set_select_cb(ui_sat_list_select_cb_t select_cb, void *ctx);
+
+// Polar az/el sky plot. Pass arcs are projected once into per-slot point arrays;
+// the per-tick update only moves the slot's live marker.
+#define UI_SKYPLOT_SLOTS      4
+#define UI_SKYPLOT_ARC_POINTS 40
+
+typedef struct {
+    float az_deg;
+    float el_deg;
+} ui_azel_t;
+
+void ui_skyplot_set_pass(int slot, const char *name, const ui_azel_t *arc, size_t n, int64_t aos_unix,
+                         int64_t los_unix, float max_el_deg);
+void ui_skyplot_clear(int slot);
+void ui_skyplot_set_marker(int slot, float az_deg, float el_deg);
+// Current downlink Doppler shift of the slot's satellite; valid = false hides it
+void ui_skyplot_set_doppler(int slot, bool valid, int32_t shift_hz);
+
+// Radio visibility footprints drawn under the map markers. Each call replaces the
+// previous set; n = 0 clears the overlay.
+#define UI_FOOTPRINT_MAX 8
+
+typedef struct {
+    float lat_deg; // sub-satellite point
+    float lon_deg;
+    float alt_km;
+} ui_footprint_t;
+
+void ui_footprint_update(const ui_footprint_t *fps, size_t n, float min_el_deg);
+
+// Coverage heatmap over the map: covered minutes per cell of a w x h equirectangular
+// grid (row 0 at +90 deg, column 0 at -180 deg), colored relative to the best cell
+void ui_coverage_update(const uint16_t *cell_minutes, size_t w, size_t h);
+
+// Antenna tracking plan timeline: every pass of the planning window on a time
+// strip (tracked ones on their own lane) and the list of tracked passes. Passes
+// are pulled through the callback (called with the LVGL lock held) during
+// ui_timeline_set_plan(), in time order; only tracked passes need a name.
+typedef struct {
+    char name[25];
+    int64_t aos_unix;
+    int64_t los_unix;
+    float max_el_deg;
+    bool tracked;
+    bool priority; // above the default priority
+} ui_plan_pass_t;
+
+typedef bool (*ui_plan_pass_cb_t)(size_t index, ui_plan_pass_t *pass, void *ctx);
+
+void ui_timeline_set_plan(int64_t start_unix, int64_t end_unix, size_t n, ui_plan_pass_cb_t pass_cb, void *ctx);
+void ui_timeline_set_now(int64_t now_unix);
+
+// One-line alert banner along the bottom of the map; NULL hides it
+void ui_alert_set(const char *text);
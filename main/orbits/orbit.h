@@ -21,8 +21,20 @@ esp_err_t orbit_sat_create_from_tle(const char *tle_line1, const char *tle_line2
 // Destroy satellite handle
 void orbit_sat_destroy(orbit_sat_t *sat);
 
+// Re-run SGP4 initialization of an existing handle with a new TLE (no reallocation).
+// On failure the handle keeps its previous elements.
+esp_err_t orbit_sat_reinit_from_tle(orbit_sat_t *sat, const char *tle_line1, const char *tle_line2);
+
 esp_err_t orbit_sat_propagate_unix(orbit_sat_t *sat, int64_t unix_time_sec, orbit_eci_t *out_eci);
 
+// Same as orbit_sat_propagate_unix, also returning the TEME velocity [km/s] (out_vel may be NULL)
+esp_err_t orbit_sat_propagate_unix_state(orbit_sat_t *sat, int64_t unix_time_sec, orbit_eci_t *out_pos,
+                                         orbit_eci_t *out_vel);
+
+// Same at a fractional Unix time (root finding, interpolation nodes)
+esp_err_t orbit_sat_propagate_state(orbit_sat_t *sat, double unix_time_sec, orbit_eci_t *out_pos,
+                                    orbit_eci_t *out_vel);
+
 // Hardcoded LUR-1 TLE (from CelesTrak)// On next milestones this disapears
 extern const char *ORBIT_TLE_LUR1_L1;
 extern const char *ORBIT_TLE_LUR1_L2;
@@ -0,0 +1,451 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "orbit_catalog.h"
+
+static const char *TAG = "orbit_catalog";
+
+struct orbit_catalog_t {
+    orbit_catalog_entry_t *entries; // sorted by norad_id
+    size_t count;
+    size_t cap;
+    orbit_catalog_callbacks_t cbs;
+    bool lazy;
+    bool warm; // no lazy entry left to initialize
+};
+
+typedef struct {
+    orbit_tle_t tle;
+    size_t src_idx;
+    bool matched;
+} pending_t;
+
+static int cmp_pending(const void *a, const void *b) {
+    const pending_t *pa = (const pending_t *)a;
+    const pending_t *pb = (const pending_t *)b;
+    if (pa->tle.norad_id != pb->tle.norad_id) {
+        return (pa->tle.norad_id < pb->tle.norad_id) ? -1 : 1;
+    }
+    // Newest epoch first so duplicates collapse to the freshest element set
+    double ea = orbit_tle_epoch_unix(&pa->tle);
+    double eb = orbit_tle_epoch_unix(&pb->tle);
+    return (ea > eb) ? -1 : (ea < eb) ? 1 : 0;
+}
+
+static int cmp_entry(const void *a, const void *b) {
+    uint32_t ia = ((const orbit_catalog_entry_t *)a)->norad_id;
+    uint32_t ib = ((const orbit_catalog_entry_t *)b)->norad_id;
+    return (ia < ib) ? -1 : (ia > ib) ? 1 : 0;
+}
+
+static pending_t *find_pending(pending_t *p, size_t n, uint32_t norad_id) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (p[mid].tle.norad_id < norad_id) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return (lo < n && p[lo].tle.norad_id == norad_id) ? &p[lo] : NULL;
+}
+
+// Copy a TLE name line, dropping the "0 " prefix of 3LE files and trailing blanks
+static void copy_name(char *dst, const char *name, uint32_t norad_id) {
+    if (!name || !name[0]) {
+        snprintf(dst, ORBIT_TLE_NAME_LEN + 1, "%lu", (unsigned long)norad_id);
+        return;
+    }
+    if (name[0] == '0' && name[1] == ' ') {
+        name += 2;
+    }
+    size_t n = strnlen(name, ORBIT_TLE_NAME_LEN);
+    while (n > 0 && (name[n - 1] == ' ' || name[n - 1] == '\r' || name[n - 1] == '\n')) {
+        n--;
+    }
+    memcpy(dst, name, n);
+    dst[n] = '\0';
+}
+
+esp_err_t orbit_catalog_create(const orbit_catalog_callbacks_t *cbs, orbit_catalog_t **out_cat) {
+    if (!out_cat) {
+        ESP_LOGE(TAG, "orbit_catalog_create: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    orbit_catalog_t *cat = calloc(1, sizeof(*cat));
+    if (!cat) {
+        ESP_LOGE(TAG, "orbit_catalog_create: no mem");
+        return ESP_ERR_NO_MEM;
+    }
+    if (cbs) {
+        cat->cbs = *cbs;
+    }
+
+    *out_cat = cat;
+    return ESP_OK;
+}
+
+void orbit_catalog_destroy(orbit_catalog_t *cat) {
+    if (!cat) {
+        return;
+    }
+    for (size_t i = 0; i < cat->count; i++) {
+        if (cat->cbs.on_removed) {
+            cat->cbs.on_removed(&cat->entries[i], cat->cbs.ctx);
+        }
+        orbit_sat_destroy(cat->entries[i].sat);
+    }
+    free(cat->entries);
+    free(cat);
+}
+
+void orbit_catalog_set_lazy(orbit_catalog_t *cat, bool lazy) {
+    if (cat) {
+        cat->lazy = lazy;
+    }
+}
+
+orbit_sat_t *orbit_catalog_entry_sat(orbit_catalog_entry_t *entry) {
+    if (!entry) {
+        return NULL;
+    }
+    if (!entry->sat && !entry->sat_failed) {
+        char line1[ORBIT_TLE_LINE_LEN + 1], line2[ORBIT_TLE_LINE_LEN + 1];
+        if (orbit_tle_format(&entry->tle, line1, line2) != ESP_OK ||
+            orbit_sat_create_from_tle(line1, line2, &entry->sat) != ESP_OK) {
+            ESP_LOGW(TAG, "SGP4 init of %lu failed", (unsigned long)entry->norad_id);
+            entry->sat = NULL;
+            entry->sat_failed = true;
+        }
+    }
+    return entry->sat;
+}
+
+size_t orbit_catalog_warmup(orbit_catalog_t *cat, const uint8_t *priority, int64_t budget_us) {
+    if (!cat || cat->warm) {
+        return 0;
+    }
+
+    int64_t t_end = esp_timer_get_time() + budget_us;
+    size_t pending = 0;
+    // First sweep: priority entries, second: the rest
+    for (int sweep = priority ? 0 : 1; sweep < 2; sweep++) {
+        for (size_t i = 0; i < cat->count; i++) {
+            orbit_catalog_entry_t *e = &cat->entries[i];
+            if (e->sat || e->sat_failed || (priority && (priority[i] != 0) != (sweep == 0))) {
+                continue;
+            }
+            if (esp_timer_get_time() < t_end) {
+                orbit_catalog_entry_sat(e);
+            } else {
+                pending++;
+            }
+        }
+    }
+    cat->warm = pending == 0;
+    return pending;
+}
+
+// New elements for an entry: SGP4 re-init in place, or in lazy mode drop the handle
+// so the next use initializes from the new elements
+static esp_err_t entry_set_elements(orbit_catalog_t *cat, orbit_catalog_entry_t *e, const orbit_catalog_tle_src_t *s) {
+    if (cat->lazy) {
+        orbit_sat_destroy(e->sat);
+        e->sat = NULL;
+        e->sat_failed = false;
+        cat->warm = false;
+        return ESP_OK;
+    }
+    e->sat_failed = false;
+    return e->sat ? orbit_sat_reinit_from_tle(e->sat, s->line1, s->line2)
+                  : orbit_sat_create_from_tle(s->line1, s->line2, &e->sat);
+}
+
+esp_err_t orbit_catalog_update(orbit_catalog_t *cat, const orbit_catalog_tle_src_t *src, size_t count,
+                               orbit_catalog_update_stats_t *out_stats) {
+    if (!cat || (!src && count > 0)) {
+        ESP_LOGE(TAG, "orbit_catalog_update: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int64_t t_start = esp_timer_get_time();
+    orbit_catalog_update_stats_t stats = {0};
+
+    pending_t *pend = NULL;
+    if (count > 0) {
+        pend = calloc(count, sizeof(*pend));
+        if (!pend) {
+            ESP_LOGE(TAG, "orbit_catalog_update: no mem for %u element sets", (unsigned)count);
+            return ESP_ERR_NO_MEM;
+        }
+    }
+
+    // Validate the new set and sort it by NORAD ID, dropping older duplicates
+    size_t n_pend = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (orbit_tle_parse(src[i].line1, src[i].line2, &pend[n_pend].tle) != ESP_OK) {
+            stats.rejected++;
+            continue;
+        }
+        pend[n_pend].src_idx = i;
+        n_pend++;
+    }
+    qsort(pend, n_pend, sizeof(*pend), cmp_pending);
+    size_t n_uniq = 0;
+    for (size_t i = 0; i < n_pend; i++) {
+        if (n_uniq > 0 && pend[n_uniq - 1].tle.norad_id == pend[i].tle.norad_id) {
+            continue;
+        }
+        pend[n_uniq++] = pend[i];
+    }
+
+    // Diff loaded entries against the new set: keep, re-init in place or remove
+    size_t kept = 0;
+    for (size_t i = 0; i < cat->count; i++) {
+        orbit_catalog_entry_t *e = &cat->entries[i];
+        pending_t *p = find_pending(pend, n_uniq, e->norad_id);
+
+        if (!p) {
+            if (cat->cbs.on_removed) {
+                cat->cbs.on_removed(e, cat->cbs.ctx);
+            }
+            orbit_sat_destroy(e->sat);
+            stats.removed++;
+            continue;
+        }
+
+        p->matched = true;
+        const orbit_catalog_tle_src_t *s = &src[p->src_idx];
+        bool stale = orbit_tle_epoch_unix(&p->tle) < orbit_tle_epoch_unix(&e->tle);
+
+        if (orbit_tle_same_elset(&e->tle, &p->tle) || stale) {
+            stats.unchanged++;
+        } else if (entry_set_elements(cat, e, s) == ESP_OK) {
+            e->tle = p->tle;
+            copy_name(e->name, s->name, e->norad_id);
+            stats.changed++;
+            if (cat->cbs.on_changed) {
+                cat->cbs.on_changed(e, cat->cbs.ctx);
+            }
+        } else {
+            stats.rejected++;
+        }
+
+        if (kept != i) {
+            cat->entries[kept] = *e;
+        }
+        kept++;
+    }
+    cat->count = kept;
+
+    // Append new IDs, then restore ordering
+    size_t n_new = 0;
+    for (size_t i = 0; i < n_uniq; i++) {
+        n_new += pend[i].matched ? 0 : 1;
+    }
+
+    esp_err_t ret = ESP_OK;
+    if (cat->count + n_new > cat->cap) {
+        size_t cap = cat->count + n_new;
+        orbit_catalog_entry_t *grown = realloc(cat->entries, cap * sizeof(*grown));
+        if (!grown) {
+            ESP_LOGE(TAG, "orbit_catalog_update: no mem for %u entries", (unsigned)cap);
+            ret = ESP_ERR_NO_MEM;
+            n_uniq = 0;
+        } else {
+            cat->entries = grown;
+            cat->cap = cap;
+        }
+    }
+
+    size_t first_new = cat->count;
+    for (size_t i = 0; i < n_uniq; i++) {
+        if (pend[i].matched) {
+            continue;
+        }
+        const orbit_catalog_tle_src_t *s = &src[pend[i].src_idx];
+        orbit_catalog_entry_t *e = &cat->entries[cat->count];
+        memset(e, 0, sizeof(*e));
+
+        if (entry_set_elements(cat, e, s) != ESP_OK) {
+            stats.rejected++;
+            continue;
+        }
+        e->norad_id = pend[i].tle.norad_id;
+        e->tle = pend[i].tle;
+        copy_name(e->name, s->name, e->norad_id);
+        cat->count++;
+        stats.added++;
+    }
+
+    if (cat->count > first_new) {
+        qsort(cat->entries, cat->count, sizeof(*cat->entries), cmp_entry);
+        if (cat->cbs.on_added) {
+            for (size_t i = 0; i < cat->count; i++) {
+                // Entries that survived the diff were matched against the new set
+                orbit_catalog_entry_t *e = &cat->entries[i];
+                if (!find_pending(pend, n_uniq, e->norad_id)->matched) {
+                    cat->cbs.on_added(e, cat->cbs.ctx);
+                }
+            }
+        }
+    }
+
+    free(pend);
+
+    stats.elapsed_us = esp_timer_get_time() - t_start;
+    ESP_LOGI(TAG, "Catalog update%s: %u sats (+%u ~%u =%u -%u, %u rejected) in %lld ms",
+             cat->lazy ? " (lazy SGP4 init)" : "", (unsigned)cat->count, (unsigned)stats.added,
+             (unsigned)stats.changed, (unsigned)stats.unchanged, (unsigned)stats.removed, (unsigned)stats.rejected,
+             (long long)(stats.elapsed_us / 1000));
+
+    if (out_stats) {
+        *out_stats = stats;
+    }
+    return ret;
+}
+
+typedef struct {
+    char name[ORBIT_TLE_NAME_LEN + 1];
+    char line1[ORBIT_TLE_LINE_LEN + 1];
+    char line2[ORBIT_TLE_LINE_LEN + 1];
+} file_tle_t;
+
+static void trim_line(char *s) {
+    size_t n = strlen(s);
+    while (n > 0 && (s[n - 1] == '\n' || s[n - 1] == '\r')) {
+        s[--n] = '\0';
+    }
+}
+
+esp_err_t orbit_catalog_update_from_file(orbit_catalog_t *cat, const char *path,
+                                         orbit_catalog_update_stats_t *out_stats) {
+    if (!cat || !path) {
+        ESP_LOGE(TAG, "orbit_catalog_update_from_file: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        ESP_LOGE(TAG, "Cannot open %s", path);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    file_tle_t *recs = NULL;
+    size_t n = 0, cap = 0;
+    char name[ORBIT_TLE_NAME_LEN + 1] = {0};
+    char buf[2][128];
+    esp_err_t ret = ESP_OK;
+
+    while (fgets(buf[0], sizeof(buf[0]), f)) {
+        trim_line(buf[0]);
+        if (buf[0][0] != '1' || strlen(buf[0]) < ORBIT_TLE_LINE_LEN) {
+            // Name line of a 3LE set (or junk, which is then overwritten)
+            strncpy(name, buf[0], ORBIT_TLE_NAME_LEN);
+            continue;
+        }
+        if (!fgets(buf[1], sizeof(buf[1]), f)) {
+            break;
+        }
+        trim_line(buf[1]);
+
+        if (n == cap) {
+            cap = cap ? cap * 2 : 64;
+            file_tle_t *grown = realloc(recs, cap * sizeof(*grown));
+            if (!grown) {
+                ret = ESP_ERR_NO_MEM;
+                break;
+            }
+            recs = grown;
+        }
+        memcpy(recs[n].name, name, sizeof(name));
+        strncpy(recs[n].line1, buf[0], ORBIT_TLE_LINE_LEN);
+        recs[n].line1[ORBIT_TLE_LINE_LEN] = '\0';
+        strncpy(recs[n].line2, buf[1], ORBIT_TLE_LINE_LEN);
+        recs[n].line2[ORBIT_TLE_LINE_LEN] = '\0';
+        name[0] = '\0';
+        n++;
+    }
+    fclose(f);
+
+    orbit_catalog_tle_src_t *src = (ret == ESP_OK && n > 0) ? malloc(n * sizeof(*src)) : NULL;
+    if (ret == ESP_OK && n > 0 && !src) {
+        ret = ESP_ERR_NO_MEM;
+    }
+
+    if (ret == ESP_OK) {
+        for (size_t i = 0; i < n; i++) {
+            src[i].name = recs[i].name;
+            src[i].line1 = recs[i].line1;
+            src[i].line2 = recs[i].line2;
+        }
+        ESP_LOGI(TAG, "Read %u element sets from %s", (unsigned)n, path);
+        ret = orbit_catalog_update(cat, src, n, out_stats);
+    } else {
+        ESP_LOGE(TAG, "orbit_catalog_update_from_file: no mem");
+    }
+
+    free(src);
+    free(recs);
+    return ret;
+}
+
+esp_err_t orbit_catalog_propagate_soa(orbit_catalog_t *cat, int64_t unix_time_sec, const uint8_t *mask,
+                                      orbit_soa_t *soa) {
+    if (!cat || !soa) {
+        ESP_LOGE(TAG, "orbit_catalog_propagate_soa: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (soa->capacity < cat->count) {
+        orbit_soa_free(soa);
+        esp_err_t ret = orbit_soa_alloc(soa, cat->count);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+
+    for (size_t i = 0; i < cat->count; i++) {
+        if (mask && !mask[i]) {
+            soa->valid[i] = 0;
+            continue;
+        }
+        orbit_sat_t *sat = orbit_catalog_entry_sat(&cat->entries[i]);
+        orbit_eci_t pos = {0}, vel = {0};
+        soa->valid[i] = sat && orbit_sat_propagate_unix_state(sat, unix_time_sec, &pos, &vel) == ESP_OK;
+        soa->x[i] = (float)pos.x;
+        soa->y[i] = (float)pos.y;
+        soa->z[i] = (float)pos.z;
+        soa->vx[i] = (float)vel.x;
+        soa->vy[i] = (float)vel.y;
+        soa->vz[i] = (float)vel.z;
+    }
+    soa->count = cat->count;
+    soa->unix_time_sec = (double)unix_time_sec;
+    return ESP_OK;
+}
+
+size_t orbit_catalog_count(const orbit_catalog_t *cat) {
+    return cat ? cat->count : 0;
+}
+
+orbit_catalog_entry_t *orbit_catalog_at(orbit_catalog_t *cat, size_t index) {
+    if (!cat || index >= cat->count) {
+        return NULL;
+    }
+    return &cat->entries[index];
+}
+
+orbit_catalog_entry_t *orbit_catalog_find(orbit_catalog_t *cat, uint32_t norad_id) {
+    if (!cat) {
+        return NULL;
+    }
+    orbit_catalog_entry_t key = {.norad_id = norad_id};
+    return bsearch(&key, cat->entries, cat->count, sizeof(*cat->entries), cmp_entry);
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit.h"
+#include "orbit_soa.h"
+#include "orbit_tle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Set of satellites keyed by NORAD ID, kept sorted by ID.
+typedef struct orbit_catalog_t orbit_catalog_t;
+
+typedef struct {
+    uint32_t norad_id;
+    char name[ORBIT_TLE_NAME_LEN + 1];
+    orbit_tle_t tle;
+    orbit_sat_t *sat; // NULL until first use in lazy mode: go through orbit_catalog_entry_sat()
+    bool sat_failed;  // lazy SGP4 init failed, not retried until the elements change
+    void *user_data;  // owned by the caller (e.g. UI marker), kept across updates
+} orbit_catalog_entry_t;
+
+// Called from orbit_catalog_update(). Entry pointers are only valid during the call.
+typedef struct {
+    void (*on_added)(orbit_catalog_entry_t *entry, void *ctx);
+    void (*on_changed)(orbit_catalog_entry_t *entry, void *ctx);
+    void (*on_removed)(orbit_catalog_entry_t *entry, void *ctx);
+    void *ctx;
+} orbit_catalog_callbacks_t;
+
+// One element set of an update. name may be NULL.
+typedef struct {
+    const char *name;
+    const char *line1;
+    const char *line2;
+} orbit_catalog_tle_src_t;
+
+typedef struct {
+    size_t added;
+    size_t changed;
+    size_t unchanged;
+    size_t removed;
+    size_t rejected;
+    int64_t elapsed_us;
+} orbit_catalog_update_stats_t;
+
+esp_err_t orbit_catalog_create(const orbit_catalog_callbacks_t *cbs, orbit_catalog_t **out_cat);
+void orbit_catalog_destroy(orbit_catalog_t *cat);
+
+// Make the catalog match the given element sets: unchanged entries (same epoch and
+// checksums) are left alone, changed ones re-run SGP4 init in place, unknown IDs are
+// added and IDs missing from the set are removed.
+esp_err_t orbit_catalog_update(orbit_catalog_t *cat, const orbit_catalog_tle_src_t *src, size_t count,
+                               orbit_catalog_update_stats_t *out_stats);
+
+// Lazy SGP4 initialization (off by default). Updates then only validate and store
+// the mean elements; an entry's SGP4 handle is created on its first propagation
+// (orbit_catalog_entry_sat()) or by orbit_catalog_warmup(). Elements that SGP4
+// rejects are found then instead of at load time. Set before loading.
+void orbit_catalog_set_lazy(orbit_catalog_t *cat, bool lazy);
+
+// SGP4 handle of an entry, initialized here on first use in lazy mode. NULL when
+// the elements don't initialize.
+orbit_sat_t *orbit_catalog_entry_sat(orbit_catalog_entry_t *entry);
+
+// Background warm-up of a lazy catalog: initialize entries until budget_us is
+// spent, those with priority[i] != 0 (optional, one byte per entry) first.
+// Returns the number of entries still waiting.
+size_t orbit_catalog_warmup(orbit_catalog_t *cat, const uint8_t *priority, int64_t budget_us);
+
+// Same as orbit_catalog_update() with a 2-line or 3-line (named) TLE text file
+esp_err_t orbit_catalog_update_from_file(orbit_catalog_t *cat, const char *path,
+                                         orbit_catalog_update_stats_t *out_stats);
+
+// Propagate the entries to unix_time_sec into soa (index = catalog index).
+// mask (optional, one byte per entry) skips entries with 0. Skipped entries and
+// failed propagations get valid = 0. soa is grown when the catalog outgrew it.
+// Lazy entries are initialized on the way.
+esp_err_t orbit_catalog_propagate_soa(orbit_catalog_t *cat, int64_t unix_time_sec, const uint8_t *mask,
+                                      orbit_soa_t *soa);
+
+size_t orbit_catalog_count(const orbit_catalog_t *cat);
+orbit_catalog_entry_t *orbit_catalog_at(orbit_catalog_t *cat, size_t index);
+orbit_catalog_entry_t *orbit_catalog_find(orbit_catalog_t *cat, uint32_t norad_id);
+
+#ifdef __cplusplus
+}
+#endif
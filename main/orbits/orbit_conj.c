@@ -0,0 +1,377 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "orbit_conj.h"
+
+static const char *TAG = "orbit_conj";
+
+// Bounds for the cell size and the gate: the closing speed of two orbiting objects
+// (head-on LEO ~15.5 km/s) and their relative acceleration (twice surface gravity)
+#define V_REL_MAX_KM_S  16.0f
+#define A_REL_MAX_KM_S2 0.02f
+
+// Range rate root: stop at this time resolution or iteration count
+#define TCA_TOL_S   1e-3
+#define TCA_MAX_ITER 40
+
+struct orbit_conj_t {
+    orbit_conj_config_t cfg;
+    float half_step_s;
+    float margin_km; // departure from linear motion over half a step
+    float cell_km;
+
+    int64_t t_start;
+    uint32_t step_idx;
+    uint32_t n_steps;
+    bool running;
+
+    orbit_soa_t soa;
+    size_t cap;           // objects the hash arrays hold
+    size_t table_size;    // power of two
+    int16_t *cell;        // [cap][3] cell coordinates
+    uint32_t *key;        // [cap] table slot
+    uint32_t *order;      // [cap] object indices grouped by slot
+    uint32_t *slot_start; // [table_size + 1]
+
+    orbit_conj_event_t *events; // [cfg.max_events], closest first
+    size_t n_events;
+    orbit_conj_stats_t stats;
+};
+
+esp_err_t orbit_conj_create(const orbit_conj_config_t *cfg, orbit_conj_t **out_cj) {
+    if (!cfg || !out_cj || cfg->threshold_km <= 0.0f || cfg->step_s <= 0 || cfg->window_s < cfg->step_s ||
+        cfg->max_events == 0) {
+        ESP_LOGE(TAG, "orbit_conj_create: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    orbit_conj_t *cj = calloc(1, sizeof(*cj));
+    if (cj) {
+        cj->events = calloc(cfg->max_events, sizeof(orbit_conj_event_t));
+    }
+    if (!cj || !cj->events) {
+        ESP_LOGE(TAG, "orbit_conj_create: no mem");
+        free(cj);
+        return ESP_ERR_NO_MEM;
+    }
+    cj->cfg = *cfg;
+    cj->half_step_s = cfg->step_s * 0.5f;
+    cj->margin_km = 0.5f * A_REL_MAX_KM_S2 * cj->half_step_s * cj->half_step_s;
+    cj->cell_km = cfg->threshold_km + V_REL_MAX_KM_S * cj->half_step_s + cj->margin_km;
+    *out_cj = cj;
+    return ESP_OK;
+}
+
+static void free_hash(orbit_conj_t *cj) {
+    free(cj->cell);
+    free(cj->key);
+    free(cj->order);
+    free(cj->slot_start);
+    cj->cell = NULL;
+    cj->key = cj->order = cj->slot_start = NULL;
+    cj->cap = 0;
+}
+
+void orbit_conj_destroy(orbit_conj_t *cj) {
+    if (!cj) {
+        return;
+    }
+    free_hash(cj);
+    orbit_soa_free(&cj->soa);
+    free(cj->events);
+    free(cj);
+}
+
+void orbit_conj_start(orbit_conj_t *cj, int64_t t_start) {
+    if (!cj) {
+        return;
+    }
+    cj->t_start = t_start;
+    cj->step_idx = 0;
+    cj->n_steps = (uint32_t)(cj->cfg.window_s / cj->cfg.step_s) + 1;
+    cj->running = true;
+    cj->n_events = 0;
+    memset(&cj->stats, 0, sizeof(cj->stats));
+}
+
+static bool reserve_hash(orbit_conj_t *cj, size_t n) {
+    if (n <= cj->cap) {
+        return true;
+    }
+    free_hash(cj);
+    size_t table = 16;
+    while (table < 2 * n) {
+        table <<= 1;
+    }
+    cj->cell = malloc(n * 3 * sizeof(int16_t));
+    cj->key = malloc(n * sizeof(uint32_t));
+    cj->order = malloc(n * sizeof(uint32_t));
+    cj->slot_start = malloc((table + 1) * sizeof(uint32_t));
+    if (!cj->cell || !cj->key || !cj->order || !cj->slot_start) {
+        ESP_LOGE(TAG, "No mem for the hash of %u objects", (unsigned)n);
+        free_hash(cj);
+        return false;
+    }
+    cj->cap = n;
+    cj->table_size = table;
+    return true;
+}
+
+static inline uint32_t cell_slot(const orbit_conj_t *cj, int32_t cx, int32_t cy, int32_t cz) {
+    uint32_t h = (uint32_t)cx * 73856093u ^ (uint32_t)cy * 19349663u ^ (uint32_t)cz * 83492791u;
+    return h & (uint32_t)(cj->table_size - 1);
+}
+
+// Counting sort of the valid objects by hash slot
+static void build_hash(orbit_conj_t *cj) {
+    const orbit_soa_t *s = &cj->soa;
+    const float inv = 1.0f / cj->cell_km;
+    memset(cj->slot_start, 0, (cj->table_size + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < s->count; i++) {
+        if (!s->valid[i]) {
+            continue;
+        }
+        int16_t *c = &cj->cell[i * 3];
+        c[0] = (int16_t)floorf(s->x[i] * inv);
+        c[1] = (int16_t)floorf(s->y[i] * inv);
+        c[2] = (int16_t)floorf(s->z[i] * inv);
+        cj->key[i] = cell_slot(cj, c[0], c[1], c[2]);
+        cj->slot_start[cj->key[i] + 1]++;
+        cj->stats.hashed++;
+    }
+    for (size_t k = 0; k < cj->table_size; k++) {
+        cj->slot_start[k + 1] += cj->slot_start[k];
+    }
+    // Fill with slot_start[k] as the insertion point, then shift back
+    for (size_t i = 0; i < s->count; i++) {
+        if (s->valid[i]) {
+            cj->order[cj->slot_start[cj->key[i]]++] = (uint32_t)i;
+        }
+    }
+    for (size_t k = cj->table_size; k > 0; k--) {
+        cj->slot_start[k] = cj->slot_start[k - 1];
+    }
+    cj->slot_start[0] = 0;
+}
+
+// Relative position and velocity (b - a) and their dot product at t
+static bool rel_state(orbit_sat_t *a, orbit_sat_t *b, double t, double dr[3], double dv[3], double *out_dot) {
+    orbit_eci_t pa, va, pb, vb;
+    if (orbit_sat_propagate_state(a, t, &pa, &va) != ESP_OK || orbit_sat_propagate_state(b, t, &pb, &vb) != ESP_OK) {
+        return false;
+    }
+    dr[0] = pb.x - pa.x;
+    dr[1] = pb.y - pa.y;
+    dr[2] = pb.z - pa.z;
+    dv[0] = vb.x - va.x;
+    dv[1] = vb.y - va.y;
+    dv[2] = vb.z - va.z;
+    *out_dot = dr[0] * dv[0] + dr[1] * dv[1] + dr[2] * dv[2];
+    return true;
+}
+
+static void add_event(orbit_conj_t *cj, const orbit_conj_event_t *ev) {
+    cj->stats.events++;
+    // A pair already listed with a TCA within half a step is the same approach
+    for (size_t k = 0; k < cj->n_events; k++) {
+        orbit_conj_event_t *e = &cj->events[k];
+        if (e->index_a == ev->index_a && e->index_b == ev->index_b &&
+            fabs(e->tca_unix - ev->tca_unix) < cj->half_step_s) {
+            if (ev->miss_km >= e->miss_km) {
+                return;
+            }
+            memmove(e, e + 1, (cj->n_events - k - 1) * sizeof(*e));
+            cj->n_events--;
+            break;
+        }
+    }
+    size_t pos = cj->n_events;
+    while (pos > 0 && cj->events[pos - 1].miss_km > ev->miss_km) {
+        pos--;
+    }
+    if (pos >= cj->cfg.max_events) {
+        return;
+    }
+    size_t tail = (cj->n_events < cj->cfg.max_events ? cj->n_events : cj->cfg.max_events - 1) - pos;
+    memmove(&cj->events[pos + 1], &cj->events[pos], tail * sizeof(*ev));
+    cj->events[pos] = *ev;
+    cj->n_events = pos + 1 + tail;
+}
+
+// Closest approach of a gated pair inside [tk - h, tk + h]: the range rate (dr.dv)
+// goes from negative to positive there, found by false position (Illinois).
+// Minima at the window edges belong to the neighbouring steps.
+static void refine_pair(orbit_conj_t *cj, orbit_catalog_t *cat, size_t ia, size_t ib, double tk) {
+    orbit_catalog_entry_t *ea = orbit_catalog_at(cat, ia);
+    orbit_catalog_entry_t *eb = orbit_catalog_at(cat, ib);
+    orbit_sat_t *sa = orbit_catalog_entry_sat(ea);
+    orbit_sat_t *sb = orbit_catalog_entry_sat(eb);
+    double dr[3], dv[3];
+    double lo = tk - cj->half_step_s, hi = tk + cj->half_step_s;
+    double f_lo, f_hi;
+    if (!rel_state(sa, sb, lo, dr, dv, &f_lo) || !rel_state(sa, sb, hi, dr, dv, &f_hi) || f_lo >= 0.0 || f_hi <= 0.0) {
+        return;
+    }
+
+    double t = lo, f;
+    int side = 0;
+    for (int it = 0; it < TCA_MAX_ITER && hi - lo > TCA_TOL_S; it++) {
+        t = (lo * f_hi - hi * f_lo) / (f_hi - f_lo);
+        if (!rel_state(sa, sb, t, dr, dv, &f)) {
+            return;
+        }
+        if (f < 0.0) {
+            lo = t;
+            f_lo = f;
+            f_hi = (side == -1) ? f_hi * 0.5 : f_hi;
+            side = -1;
+        } else {
+            hi = t;
+            f_hi = f;
+            f_lo = (side == 1) ? f_lo * 0.5 : f_lo;
+            side = 1;
+        }
+        if (f == 0.0) {
+            break;
+        }
+    }
+    if (!rel_state(sa, sb, t, dr, dv, &f)) {
+        return;
+    }
+    double miss = sqrt(dr[0] * dr[0] + dr[1] * dr[1] + dr[2] * dr[2]);
+    if (miss >= cj->cfg.threshold_km || t < (double)cj->t_start || t > (double)(cj->t_start + cj->cfg.window_s)) {
+        return;
+    }
+    orbit_conj_event_t ev = {
+        .norad_a = ea->norad_id,
+        .norad_b = eb->norad_id,
+        .index_a = ia,
+        .index_b = ib,
+        .tca_unix = t,
+        .miss_km = (float)miss,
+        .rel_speed_km_s = (float)sqrt(dv[0] * dv[0] + dv[1] * dv[1] + dv[2] * dv[2]),
+    };
+    add_event(cj, &ev);
+}
+
+// Pairs in the 27 cells around each object, each pair once (j > i). A pair passes
+// the gate when its straight-line closest approach within half a step, plus the
+// curvature margin, gets under the threshold.
+static void screen_neighbours(orbit_conj_t *cj, orbit_catalog_t *cat, double tk) {
+    const orbit_soa_t *s = &cj->soa;
+    const float h = cj->half_step_s;
+    const float gate = cj->cfg.threshold_km + cj->margin_km;
+
+    for (size_t i = 0; i < s->count; i++) {
+        if (!s->valid[i]) {
+            continue;
+        }
+        const int16_t *ci = &cj->cell[i * 3];
+        for (int dz = -1; dz <= 1; dz++) {
+            for (int dy = -1; dy <= 1; dy++) {
+                for (int dx = -1; dx <= 1; dx++) {
+                    int32_t cx = ci[0] + dx, cy = ci[1] + dy, cz = ci[2] + dz;
+                    uint32_t slot = cell_slot(cj, cx, cy, cz);
+                    for (uint32_t k = cj->slot_start[slot]; k < cj->slot_start[slot + 1]; k++) {
+                        uint32_t j = cj->order[k];
+                        const int16_t *cjj = &cj->cell[j * 3];
+                        // Skip hash collisions with other cells
+                        if (j <= i || cjj[0] != cx || cjj[1] != cy || cjj[2] != cz) {
+                            continue;
+                        }
+                        cj->stats.neighbour_pairs++;
+
+                        float rx = s->x[j] - s->x[i], ry = s->y[j] - s->y[i], rz = s->z[j] - s->z[i];
+                        float vx = s->vx[j] - s->vx[i], vy = s->vy[j] - s->vy[i], vz = s->vz[j] - s->vz[i];
+                        float vv = vx * vx + vy * vy + vz * vz;
+                        float tc = (vv > 0.0f) ? -(rx * vx + ry * vy + rz * vz) / vv : 0.0f;
+                        tc = (tc < -h) ? -h : (tc > h) ? h : tc;
+                        float mx = rx + vx * tc, my = ry + vy * tc, mz = rz + vz * tc;
+                        if (mx * mx + my * my + mz * mz > gate * gate) {
+                            continue;
+                        }
+                        cj->stats.gated_pairs++;
+                        refine_pair(cj, cat, i, j, tk);
+                    }
+                }
+            }
+        }
+    }
+}
+
+esp_err_t orbit_conj_step(orbit_conj_t *cj, orbit_catalog_t *cat) {
+    if (!cj || !cat) {
+        ESP_LOGE(TAG, "orbit_conj_step: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (!cj->running) {
+        return ESP_OK;
+    }
+
+    size_t n = orbit_catalog_count(cat);
+    if (!reserve_hash(cj, n)) {
+        cj->running = false;
+        return ESP_ERR_NO_MEM;
+    }
+    int64_t tk = cj->t_start + (int64_t)cj->step_idx * cj->cfg.step_s;
+
+    int64_t t0 = esp_timer_get_time();
+    esp_err_t ret = orbit_catalog_propagate_soa(cat, tk, NULL, &cj->soa);
+    if (ret != ESP_OK) {
+        cj->running = false;
+        return ret;
+    }
+    int64_t t1 = esp_timer_get_time();
+    build_hash(cj);
+    int64_t t2 = esp_timer_get_time();
+    screen_neighbours(cj, cat, (double)tk);
+    int64_t t3 = esp_timer_get_time();
+
+    cj->stats.propagate_us += t1 - t0;
+    cj->stats.hash_us += t2 - t1;
+    cj->stats.refine_us += t3 - t2;
+    cj->stats.steps++;
+
+    if (++cj->step_idx < cj->n_steps) {
+        return ESP_ERR_NOT_FINISHED;
+    }
+    cj->running = false;
+    ESP_LOGI(TAG, "%u objects, %u steps: %llu neighbour pairs, %llu refined, %u approaches under %.1f km",
+             (unsigned)n, (unsigned)cj->stats.steps, (unsigned long long)cj->stats.neighbour_pairs,
+             (unsigned long long)cj->stats.gated_pairs, (unsigned)cj->stats.events, cj->cfg.threshold_km);
+    return ESP_OK;
+}
+
+esp_err_t orbit_conj_screen(orbit_conj_t *cj, orbit_catalog_t *cat, int64_t t_start) {
+    orbit_conj_start(cj, t_start);
+    esp_err_t ret;
+    while ((ret = orbit_conj_step(cj, cat)) == ESP_ERR_NOT_FINISHED) {
+    }
+    return ret;
+}
+
+bool orbit_conj_running(const orbit_conj_t *cj) {
+    return cj && cj->running;
+}
+
+int64_t orbit_conj_start_time(const orbit_conj_t *cj) {
+    return cj ? cj->t_start : 0;
+}
+
+size_t orbit_conj_events(const orbit_conj_t *cj, const orbit_conj_event_t **out_events) {
+    if (!cj || !out_events) {
+        return 0;
+    }
+    *out_events = cj->events;
+    return cj->n_events;
+}
+
+void orbit_conj_get_stats(const orbit_conj_t *cj, orbit_conj_stats_t *out_stats) {
+    if (cj && out_stats) {
+        *out_stats = cj->stats;
+    }
+}
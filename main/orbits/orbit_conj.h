@@ -0,0 +1,74 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit_catalog.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Close-approach screening of a whole catalog. The catalog is propagated at coarse
+// steps; each step the positions are bucketed in a 3D spatial hash whose cells are
+// as large as the threshold plus the distance a pair can close in half a step, so
+// only objects in neighbouring cells can meet before the next step. Those pairs go
+// through a linear-motion gate, and the survivors get their time of closest
+// approach by root finding of the range rate on SGP4 states.
+typedef struct {
+    float threshold_km; // report approaches closer than this
+    int64_t step_s;     // coarse propagation step
+    int64_t window_s;   // screened span from the start time
+    size_t max_events;  // closest events kept
+} orbit_conj_config_t;
+
+#define ORBIT_CONJ_DEFAULT_CONFIG() {.threshold_km = 5.0f, .step_s = 60, .window_s = 6 * 3600, .max_events = 16}
+
+typedef struct {
+    uint32_t norad_a;
+    uint32_t norad_b;
+    size_t index_a; // catalog indices at screening time
+    size_t index_b;
+    double tca_unix;
+    float miss_km;
+    float rel_speed_km_s;
+} orbit_conj_event_t;
+
+typedef struct {
+    uint32_t steps;
+    uint64_t hashed;          // positions put in the hash
+    uint64_t neighbour_pairs; // pairs found in neighbouring cells
+    uint64_t gated_pairs;     // pairs passing the linear-motion gate (refined)
+    uint32_t events;          // approaches under the threshold before the max_events cut
+    int64_t propagate_us;
+    int64_t hash_us;
+    int64_t refine_us;
+} orbit_conj_stats_t;
+
+typedef struct orbit_conj_t orbit_conj_t;
+
+esp_err_t orbit_conj_create(const orbit_conj_config_t *cfg, orbit_conj_t **out_cj);
+void orbit_conj_destroy(orbit_conj_t *cj);
+
+// Start a screening from t_start; drops the previous results
+void orbit_conj_start(orbit_conj_t *cj, int64_t t_start);
+
+// Screen the next coarse step. ESP_ERR_NOT_FINISHED while steps remain, ESP_OK
+// once the window is done. The catalog must not change during a screening.
+esp_err_t orbit_conj_step(orbit_conj_t *cj, orbit_catalog_t *cat);
+
+// Whole window in one call
+esp_err_t orbit_conj_screen(orbit_conj_t *cj, orbit_catalog_t *cat, int64_t t_start);
+
+bool orbit_conj_running(const orbit_conj_t *cj);
+int64_t orbit_conj_start_time(const orbit_conj_t *cj);
+
+// Events found so far, closest first
+size_t orbit_conj_events(const orbit_conj_t *cj, const orbit_conj_event_t **out_events);
+void orbit_conj_get_stats(const orbit_conj_t *cj, orbit_conj_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,161 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "orbit_coverage.h"
+#include "orbit_footprint.h"
+
+static const char *TAG = "orbit_coverage";
+
+#define EARTH_RADIUS_KM 6371.0f
+#define N_CELLS         (ORBIT_COVERAGE_W * ORBIT_COVERAGE_H)
+
+struct orbit_coverage_t {
+    int64_t bucket_len_s;
+    int64_t bucket_id;      // time / bucket_len_s of the bucket being filled, -1 before the first sample
+    int64_t last_sample;    // unix time of the last sample, INT64_MIN before the first one
+    float min_elevation_deg;
+    uint8_t counts[ORBIT_COVERAGE_BUCKETS][N_CELLS]; // minutes per cell and bucket
+    uint16_t minutes[N_CELLS];                       // sum of the buckets
+    uint8_t covered[N_CELLS];                        // scratch: cells covered by this sample
+};
+
+esp_err_t orbit_coverage_create(int64_t window_s, float min_elevation_deg, orbit_coverage_t **out_cov) {
+    int64_t bucket_len_s = window_s / ORBIT_COVERAGE_BUCKETS;
+    if (!out_cov || bucket_len_s < ORBIT_COVERAGE_SAMPLE_S || bucket_len_s / ORBIT_COVERAGE_SAMPLE_S > UINT8_MAX) {
+        ESP_LOGE(TAG, "orbit_coverage_create: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    orbit_coverage_t *cov = calloc(1, sizeof(*cov));
+    if (!cov) {
+        ESP_LOGE(TAG, "No mem for the coverage grid");
+        return ESP_ERR_NO_MEM;
+    }
+    cov->bucket_len_s = bucket_len_s;
+    cov->bucket_id = -1;
+    cov->last_sample = INT64_MIN;
+    cov->min_elevation_deg = min_elevation_deg;
+    *out_cov = cov;
+    return ESP_OK;
+}
+
+void orbit_coverage_destroy(orbit_coverage_t *cov) {
+    free(cov);
+}
+
+bool orbit_coverage_due(const orbit_coverage_t *cov, int64_t unix_time_sec) {
+    return cov && (cov->last_sample == INT64_MIN || unix_time_sec - cov->last_sample >= ORBIT_COVERAGE_SAMPLE_S);
+}
+
+// Drop the buckets that left the window on the way to bucket_id. Time going
+// backwards keeps filling the current bucket.
+static void advance_to(orbit_coverage_t *cov, int64_t bucket_id) {
+    if (cov->bucket_id < 0) {
+        cov->bucket_id = bucket_id;
+        return;
+    }
+    int64_t steps = bucket_id - cov->bucket_id;
+    if (steps <= 0) {
+        return;
+    }
+    if (steps >= ORBIT_COVERAGE_BUCKETS) {
+        memset(cov->counts, 0, sizeof(cov->counts));
+        memset(cov->minutes, 0, sizeof(cov->minutes));
+    } else {
+        for (int64_t k = cov->bucket_id + 1; k <= bucket_id; k++) {
+            uint8_t *old = cov->counts[k % ORBIT_COVERAGE_BUCKETS];
+            for (size_t c = 0; c < N_CELLS; c++) {
+                cov->minutes[c] -= old[c];
+            }
+            memset(old, 0, N_CELLS);
+        }
+    }
+    cov->bucket_id = bucket_id;
+}
+
+static void mark_span(uint8_t *line, int x0, int x1) {
+    memset(&line[x0], 1, (size_t)(x1 - x0 + 1));
+}
+
+static void mark_footprint(uint8_t *covered, float lat_deg, float lon_deg, float alt_km, float min_el_deg) {
+    int16_t hw[ORBIT_COVERAGE_H];
+    orbit_footprint_spans(lat_deg, orbit_footprint_half_angle_rad(alt_km, min_el_deg), ORBIT_COVERAGE_W,
+                          ORBIT_COVERAGE_H, hw);
+
+    int cx = (int)lroundf((lon_deg + 180.0f) * ORBIT_COVERAGE_W / 360.0f);
+    cx = ((cx % ORBIT_COVERAGE_W) + ORBIT_COVERAGE_W) % ORBIT_COVERAGE_W;
+    for (int row = 0; row < ORBIT_COVERAGE_H; row++) {
+        if (hw[row] == ORBIT_FOOTPRINT_NO_ROW) {
+            continue;
+        }
+        uint8_t *line = &covered[row * ORBIT_COVERAGE_W];
+        if (hw[row] == ORBIT_FOOTPRINT_FULL_ROW) {
+            mark_span(line, 0, ORBIT_COVERAGE_W - 1);
+            continue;
+        }
+        int x0 = cx - hw[row], x1 = cx + hw[row];
+        if (x0 < 0) {
+            mark_span(line, x0 + ORBIT_COVERAGE_W, ORBIT_COVERAGE_W - 1);
+            x0 = 0;
+        }
+        if (x1 >= ORBIT_COVERAGE_W) {
+            mark_span(line, 0, x1 - ORBIT_COVERAGE_W);
+            x1 = ORBIT_COVERAGE_W - 1;
+        }
+        mark_span(line, x0, x1);
+    }
+}
+
+esp_err_t orbit_coverage_add(orbit_coverage_t *cov, const orbit_soa_t *soa, const float *lat_deg,
+                             const float *lon_deg) {
+    if (!cov || !soa || !lat_deg || !lon_deg) {
+        ESP_LOGE(TAG, "orbit_coverage_add: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // The sample stands for the minutes since the previous one, so samples further
+    // apart (fast simulation) don't undercount; the remainder carries over. At most
+    // a bucket's worth, which also keeps the 8 bit counters from wrapping.
+    int64_t t = (int64_t)soa->unix_time_sec;
+    int64_t max_minutes = cov->bucket_len_s / ORBIT_COVERAGE_SAMPLE_S;
+    int64_t minutes = 1;
+    int64_t sample_time = t;
+    if (cov->last_sample != INT64_MIN && t - cov->last_sample >= ORBIT_COVERAGE_SAMPLE_S) {
+        minutes = (t - cov->last_sample) / ORBIT_COVERAGE_SAMPLE_S;
+        if (minutes > max_minutes) {
+            minutes = max_minutes;
+        } else {
+            sample_time = cov->last_sample + minutes * ORBIT_COVERAGE_SAMPLE_S;
+        }
+    }
+    advance_to(cov, t / cov->bucket_len_s);
+    cov->last_sample = sample_time;
+
+    memset(cov->covered, 0, sizeof(cov->covered));
+    for (size_t i = 0; i < soa->count; i++) {
+        if (!soa->valid[i]) {
+            continue;
+        }
+        float r = sqrtf(soa->x[i] * soa->x[i] + soa->y[i] * soa->y[i] + soa->z[i] * soa->z[i]);
+        mark_footprint(cov->covered, lat_deg[i], lon_deg[i], r - EARTH_RADIUS_KM, cov->min_elevation_deg);
+    }
+
+    uint8_t *bucket = cov->counts[cov->bucket_id % ORBIT_COVERAGE_BUCKETS];
+    for (size_t c = 0; c < N_CELLS; c++) {
+        if (!cov->covered[c]) {
+            continue;
+        }
+        // Only saturates when samples come faster than ORBIT_COVERAGE_SAMPLE_S
+        uint8_t add = (uint8_t)((bucket[c] + minutes > UINT8_MAX) ? UINT8_MAX - bucket[c] : minutes);
+        bucket[c] += add;
+        cov->minutes[c] += add;
+    }
+    return ESP_OK;
+}
+
+const uint16_t *orbit_coverage_minutes(const orbit_coverage_t *cov) {
+    return cov ? cov->minutes : NULL;
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit_soa.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Coverage accumulator: minutes each cell of a coarse equirectangular grid (row 0
+// at +90 deg, column 0 at -180 deg) had at least one satellite above the mask,
+// over a sliding window. The window is split in ORBIT_COVERAGE_BUCKETS time buckets
+// of per-cell counters; the oldest bucket is dropped as time moves on, so memory
+// is fixed whatever the window length and the window slides in bucket steps.
+#define ORBIT_COVERAGE_W        48
+#define ORBIT_COVERAGE_H        32
+#define ORBIT_COVERAGE_BUCKETS  8
+#define ORBIT_COVERAGE_SAMPLE_S 60
+
+typedef struct orbit_coverage_t orbit_coverage_t;
+
+// window_s / ORBIT_COVERAGE_BUCKETS must be at most 255 samples (counters are 8 bit)
+esp_err_t orbit_coverage_create(int64_t window_s, float min_elevation_deg, orbit_coverage_t **out_cov);
+void orbit_coverage_destroy(orbit_coverage_t *cov);
+
+// True when a sample is due at unix_time_sec (one per ORBIT_COVERAGE_SAMPLE_S)
+bool orbit_coverage_due(const orbit_coverage_t *cov, int64_t unix_time_sec);
+
+// Add one sample: the union of the footprints of the valid states of soa, with
+// their sub-satellite points from orbit_subpoint_batch(). Counts the minutes since
+// the previous sample (at least one, at most a bucket) per covered cell.
+esp_err_t orbit_coverage_add(orbit_coverage_t *cov, const orbit_soa_t *soa, const float *lat_deg,
+                             const float *lon_deg);
+
+// Covered minutes per cell over the window, [ORBIT_COVERAGE_H][ORBIT_COVERAGE_W]
+const uint16_t *orbit_coverage_minutes(const orbit_coverage_t *cov);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,69 @@
+#include <math.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "orbit_doppler.h"
+
+static const char *TAG = "orbit_doppler";
+
+#define C_KM_S 299792.458
+// Bound on the range rate of anything in Earth orbit (escape speed plus station
+// rotation), sets the int16 scale
+#define RANGE_RATE_MAX_KM_S 12.0
+
+esp_err_t orbit_doppler_build(orbit_sat_t *sat, const orbit_station_t *st, const orbit_pass_t *pass, uint32_t freq_hz,
+                              uint16_t step_s, orbit_doppler_t *out_dp) {
+    if (!sat || !st || !pass || !out_dp || freq_hz == 0 || step_s == 0 || pass->los_unix <= pass->aos_unix) {
+        ESP_LOGE(TAG, "orbit_doppler_build: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int64_t span = pass->los_unix - pass->aos_unix;
+    int64_t step = step_s;
+    if (span > step * (ORBIT_DOPPLER_MAX_SAMPLES - 1)) {
+        step = (span + ORBIT_DOPPLER_MAX_SAMPLES - 2) / (ORBIT_DOPPLER_MAX_SAMPLES - 1);
+    }
+    size_t count = (size_t)((span + step - 1) / step) + 1;
+
+    double hz_per_km_s = freq_hz / C_KM_S;
+    uint32_t scale = (uint32_t)ceil(hz_per_km_s * RANGE_RATE_MAX_KM_S / INT16_MAX);
+    scale = (scale > 0) ? scale : 1;
+    if (scale > UINT16_MAX) {
+        ESP_LOGE(TAG, "Downlink %lu Hz out of range", (unsigned long)freq_hz);
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    memset(out_dp, 0, sizeof(*out_dp));
+    for (size_t k = 0; k < count; k++) {
+        orbit_look_t look;
+        esp_err_t ret = orbit_station_look_sat(st, sat, pass->aos_unix + (int64_t)k * step, &look);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        // Receding (positive range rate) lowers the received frequency
+        double shift = -look.range_rate_km_s * hz_per_km_s / scale;
+        out_dp->shift[k] = (int16_t)lround(shift);
+    }
+    out_dp->t0_unix = pass->aos_unix;
+    out_dp->freq_hz = freq_hz;
+    out_dp->step_s = (uint16_t)step;
+    out_dp->scale_hz = (uint16_t)scale;
+    out_dp->count = (uint16_t)count;
+    return ESP_OK;
+}
+
+bool orbit_doppler_lookup(const orbit_doppler_t *dp, double unix_time_sec, int32_t *out_shift_hz) {
+    if (!dp || !out_shift_hz || dp->count < 2) {
+        return false;
+    }
+    double x = (unix_time_sec - (double)dp->t0_unix) / dp->step_s;
+    if (x < 0.0 || x > dp->count - 1) {
+        return false;
+    }
+    size_t k = (size_t)x;
+    k = (k < dp->count - 1u) ? k : dp->count - 2u;
+    double f = x - (double)k;
+    double s = dp->shift[k] + (dp->shift[k + 1] - dp->shift[k]) * f;
+    *out_shift_hz = (int32_t)lround(s * dp->scale_hz);
+    return true;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit.h"
+#include "orbit_observer.h"
+#include "orbit_pass.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// 5 s keeps linear lookups within ~10 Hz of SGP4 at 70 cm on overhead LEO passes
+#define ORBIT_DOPPLER_STEP_S      5
+#define ORBIT_DOPPLER_MAX_SAMPLES 256
+
+// Doppler curve of one pass for one downlink frequency, sampled once before the
+// pass so lookups during it are O(1) and run no SGP4. shift[k] is the received
+// minus transmitted frequency at t0_unix + k * step_s in units of scale_hz (1 Hz
+// up to ~800 MHz; scaled so no Earth orbit overflows int16). Passes longer than
+// ORBIT_DOPPLER_MAX_SAMPLES steps get a longer step.
+typedef struct {
+    int64_t t0_unix;
+    uint32_t freq_hz;
+    uint16_t step_s;
+    uint16_t scale_hz;
+    uint16_t count;
+    int16_t shift[ORBIT_DOPPLER_MAX_SAMPLES];
+} orbit_doppler_t;
+
+// Sample the station range rate across pass (AOS to at least LOS) every step_s
+esp_err_t orbit_doppler_build(orbit_sat_t *sat, const orbit_station_t *st, const orbit_pass_t *pass, uint32_t freq_hz,
+                              uint16_t step_s, orbit_doppler_t *out_dp);
+
+// Shift [Hz] at unix_time_sec, linear between samples. false outside the table.
+bool orbit_doppler_lookup(const orbit_doppler_t *dp, double unix_time_sec, int32_t *out_shift_hz);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,273 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "orbit_ephem.h"
+
+static const char *TAG = "orbit_ephem";
+
+_Static_assert(sizeof(orbit_ephem_file_hdr_t) == 48, "ephemeris header layout");
+_Static_assert(sizeof(orbit_ephem_sat_rec_t) == 32, "ephemeris satellite record layout");
+
+#define MAX_COEF (ORBIT_EPHEM_MAX_DEGREE + 1)
+
+struct orbit_ephem_t {
+    FILE *f;
+    orbit_ephem_file_hdr_t hdr;
+    orbit_ephem_sat_rec_t *sats;
+    size_t n_coef;      // per axis
+    size_t rec_floats;  // 3 * n_coef, one satellite in one segment
+    int64_t block_seg;  // segment held in block, -1 when none
+    float *block;       // [sat_count][3][n_coef] of block_seg
+    orbit_ephem_stats_t stats;
+};
+
+esp_err_t orbit_ephem_open(const char *path, orbit_ephem_t **out_eph) {
+    if (!path || !out_eph) {
+        ESP_LOGE(TAG, "orbit_ephem_open: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    FILE *f = fopen(path, "rb");
+    if (!f) {
+        ESP_LOGD(TAG, "Can't open %s", path);
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    orbit_ephem_file_hdr_t hdr;
+    if (fread(&hdr, sizeof(hdr), 1, f) != 1 || hdr.magic != ORBIT_EPHEM_MAGIC) {
+        ESP_LOGE(TAG, "%s is not an ephemeris file", path);
+        fclose(f);
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    if (hdr.version != ORBIT_EPHEM_VERSION || hdr.degree < 1 || hdr.degree > ORBIT_EPHEM_MAX_DEGREE ||
+        hdr.sat_count == 0 || hdr.seg_count == 0 || hdr.seg_len_s == 0) {
+        ESP_LOGE(TAG, "%s: unsupported version %u / degree %u", path, hdr.version, hdr.degree);
+        fclose(f);
+        return ESP_ERR_INVALID_VERSION;
+    }
+
+    orbit_ephem_t *eph = calloc(1, sizeof(*eph));
+    size_t n_coef = (size_t)hdr.degree + 1;
+    if (eph) {
+        eph->sats = malloc(hdr.sat_count * sizeof(orbit_ephem_sat_rec_t));
+        eph->block = malloc(hdr.sat_count * 3 * n_coef * sizeof(float));
+    }
+    if (!eph || !eph->sats || !eph->block) {
+        ESP_LOGE(TAG, "No mem for %u satellites", (unsigned)hdr.sat_count);
+        if (eph) {
+            free(eph->sats);
+            free(eph->block);
+        }
+        free(eph);
+        fclose(f);
+        return ESP_ERR_NO_MEM;
+    }
+
+    if (fseek(f, (long)hdr.sats_offset, SEEK_SET) != 0 ||
+        fread(eph->sats, sizeof(orbit_ephem_sat_rec_t), hdr.sat_count, f) != hdr.sat_count) {
+        ESP_LOGE(TAG, "%s: truncated satellite table", path);
+        free(eph->sats);
+        free(eph->block);
+        free(eph);
+        fclose(f);
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    eph->f = f;
+    eph->hdr = hdr;
+    eph->n_coef = n_coef;
+    eph->rec_floats = 3 * n_coef;
+    eph->block_seg = -1;
+    *out_eph = eph;
+
+    ESP_LOGI(TAG, "%s: %u satellites, %u x %u s segments, degree %u, fit error max %.3f km", path,
+             (unsigned)hdr.sat_count, (unsigned)hdr.seg_count, (unsigned)hdr.seg_len_s, hdr.degree,
+             hdr.max_err_km);
+    return ESP_OK;
+}
+
+void orbit_ephem_close(orbit_ephem_t *eph) {
+    if (!eph) {
+        return;
+    }
+    fclose(eph->f);
+    free(eph->sats);
+    free(eph->block);
+    free(eph);
+}
+
+size_t orbit_ephem_count(const orbit_ephem_t *eph) {
+    return eph ? eph->hdr.sat_count : 0;
+}
+
+const orbit_ephem_sat_rec_t *orbit_ephem_sat(const orbit_ephem_t *eph, size_t index) {
+    if (!eph || index >= eph->hdr.sat_count) {
+        return NULL;
+    }
+    return &eph->sats[index];
+}
+
+const orbit_ephem_file_hdr_t *orbit_ephem_header(const orbit_ephem_t *eph) {
+    return eph ? &eph->hdr : NULL;
+}
+
+void orbit_ephem_get_stats(const orbit_ephem_t *eph, orbit_ephem_stats_t *out_stats) {
+    if (eph && out_stats) {
+        *out_stats = eph->stats;
+    }
+}
+
+// Segment of a time and the normalized time inside it; -1 outside the file
+static int64_t segment_of(const orbit_ephem_t *eph, double unix_time_sec, float *out_tau) {
+    double dt = unix_time_sec - (double)eph->hdr.t_start_unix;
+    if (dt < 0.0) {
+        return -1;
+    }
+    int64_t seg = (int64_t)(dt / eph->hdr.seg_len_s);
+    if (seg >= (int64_t)eph->hdr.seg_count) {
+        return -1;
+    }
+    double frac = dt - (double)seg * eph->hdr.seg_len_s;
+    *out_tau = (float)(2.0 * frac / eph->hdr.seg_len_s - 1.0);
+    return seg;
+}
+
+static bool read_at(orbit_ephem_t *eph, int64_t seg, size_t first_sat, float *dst, size_t n_sats) {
+    long off = (long)(eph->hdr.data_offset +
+                      ((uint64_t)seg * eph->hdr.sat_count + first_sat) * eph->rec_floats * sizeof(float));
+    size_t n = n_sats * eph->rec_floats;
+    if (fseek(eph->f, off, SEEK_SET) != 0 || fread(dst, sizeof(float), n, eph->f) != n) {
+        ESP_LOGE(TAG, "Read of segment %lld failed", (long long)seg);
+        return false;
+    }
+    eph->stats.bytes_read += n * sizeof(float);
+    return true;
+}
+
+static bool load_block(orbit_ephem_t *eph, int64_t seg) {
+    if (eph->block_seg == seg) {
+        return true;
+    }
+    eph->block_seg = -1;
+    if (!read_at(eph, seg, 0, eph->block, eph->hdr.sat_count)) {
+        return false;
+    }
+    eph->block_seg = seg;
+    eph->stats.block_loads++;
+    return true;
+}
+
+// Chebyshev series of the 3 axes at tau; velocity from the derivative series,
+// dT_k/dtau = 2 T_(k-1) + 2 tau dT_(k-1)/dtau - dT_(k-2)/dtau
+static void cheb_eval(const float *c, size_t n, float tau, float dtau_dt, float pos[3], float vel[3]) {
+    float t[MAX_COEF], d[MAX_COEF];
+    t[0] = 1.0f;
+    t[1] = tau;
+    d[0] = 0.0f;
+    d[1] = 1.0f;
+    for (size_t k = 2; k < n; k++) {
+        t[k] = 2.0f * tau * t[k - 1] - t[k - 2];
+        d[k] = 2.0f * t[k - 1] + 2.0f * tau * d[k - 1] - d[k - 2];
+    }
+
+    for (int axis = 0; axis < 3; axis++) {
+        const float *ca = &c[axis * n];
+        float p = 0.0f, v = 0.0f;
+        for (size_t k = 0; k < n; k++) {
+            p += ca[k] * t[k];
+            v += ca[k] * d[k];
+        }
+        pos[axis] = p;
+        if (vel) {
+            vel[axis] = v * dtau_dt;
+        }
+    }
+}
+
+esp_err_t orbit_ephem_eval(orbit_ephem_t *eph, size_t index, double unix_time_sec, orbit_eci_t *out_pos,
+                           orbit_eci_t *out_vel) {
+    if (!eph || index >= eph->hdr.sat_count || !out_pos) {
+        ESP_LOGE(TAG, "orbit_ephem_eval: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    float tau;
+    int64_t seg = segment_of(eph, unix_time_sec, &tau);
+    if (seg < 0) {
+        return ESP_ERR_NOT_FOUND;
+    }
+
+    // The cached segment serves the live view; anything else (pass search ahead in
+    // time) reads one record and leaves the cache alone
+    float rec[3 * MAX_COEF];
+    const float *c = &eph->block[index * eph->rec_floats];
+    if (seg != eph->block_seg) {
+        if (!read_at(eph, seg, index, rec, 1)) {
+            return ESP_FAIL;
+        }
+        eph->stats.record_reads++;
+        c = rec;
+    }
+    if (isnan(c[0])) {
+        return ESP_FAIL;
+    }
+
+    float p[3], v[3];
+    cheb_eval(c, eph->n_coef, tau, 2.0f / (float)eph->hdr.seg_len_s, p, out_vel ? v : NULL);
+    out_pos->x = p[0];
+    out_pos->y = p[1];
+    out_pos->z = p[2];
+    if (out_vel) {
+        out_vel->x = v[0];
+        out_vel->y = v[1];
+        out_vel->z = v[2];
+    }
+    return ESP_OK;
+}
+
+esp_err_t orbit_ephem_propagate_soa(orbit_ephem_t *eph, double unix_time_sec, orbit_soa_t *soa) {
+    if (!eph || !soa) {
+        ESP_LOGE(TAG, "orbit_ephem_propagate_soa: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t count = eph->hdr.sat_count;
+    if (soa->capacity < count) {
+        orbit_soa_free(soa);
+        esp_err_t ret = orbit_soa_alloc(soa, count);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    soa->count = count;
+    soa->unix_time_sec = unix_time_sec;
+
+    float tau;
+    int64_t seg = segment_of(eph, unix_time_sec, &tau);
+    if (seg < 0 || !load_block(eph, seg)) {
+        memset(soa->valid, 0, count);
+        return (seg < 0) ? ESP_ERR_NOT_FOUND : ESP_FAIL;
+    }
+
+    const float dtau_dt = 2.0f / (float)eph->hdr.seg_len_s;
+    for (size_t i = 0; i < count; i++) {
+        const float *c = &eph->block[i * eph->rec_floats];
+        float p[3], v[3];
+        soa->valid[i] = !isnan(c[0]);
+        if (!soa->valid[i]) {
+            continue;
+        }
+        cheb_eval(c, eph->n_coef, tau, dtau_dt, p, v);
+        soa->x[i] = p[0];
+        soa->y[i] = p[1];
+        soa->z[i] = p[2];
+        soa->vx[i] = v[0];
+        soa->vy[i] = v[1];
+        soa->vz[i] = v[2];
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit.h"
+#include "orbit_ephem_format.h"
+#include "orbit_soa.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Precomputed Chebyshev ephemeris (see orbit_ephem_format.h) streamed from a file:
+// positions without SGP4 on the device. The current segment of every satellite is
+// kept in RAM; other segments are read on demand.
+typedef struct orbit_ephem_t orbit_ephem_t;
+
+typedef struct {
+    uint32_t block_loads; // whole-segment reads (all satellites)
+    uint32_t record_reads; // single satellite reads outside the cached segment
+    uint32_t bytes_read;
+} orbit_ephem_stats_t;
+
+// Validates the header and loads the satellite table. The file stays open.
+esp_err_t orbit_ephem_open(const char *path, orbit_ephem_t **out_eph);
+void orbit_ephem_close(orbit_ephem_t *eph);
+
+size_t orbit_ephem_count(const orbit_ephem_t *eph);
+const orbit_ephem_sat_rec_t *orbit_ephem_sat(const orbit_ephem_t *eph, size_t index);
+const orbit_ephem_file_hdr_t *orbit_ephem_header(const orbit_ephem_t *eph);
+void orbit_ephem_get_stats(const orbit_ephem_t *eph, orbit_ephem_stats_t *out_stats);
+
+// TEME position [km] and velocity [km/s] (out_vel may be NULL).
+// ESP_ERR_NOT_FOUND outside the file span, ESP_FAIL where the generator had no fit.
+esp_err_t orbit_ephem_eval(orbit_ephem_t *eph, size_t index, double unix_time_sec, orbit_eci_t *out_pos,
+                           orbit_eci_t *out_vel);
+
+// All satellites at unix_time_sec into soa (index = file index); loads the segment
+// once when the time crossed into a new one. soa is grown when too small.
+esp_err_t orbit_ephem_propagate_soa(orbit_ephem_t *eph, double unix_time_sec, orbit_soa_t *soa);
+
+#ifdef __cplusplus
+}
+#endif
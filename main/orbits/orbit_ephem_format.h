@@ -0,0 +1,49 @@
+#pragma once
+
+#include <stdint.h>
+
+// Chebyshev ephemeris file, written by tools/ephem_gen and read by orbit_ephem.
+// Little-endian, fixed-size records so any (segment, satellite) is one seek away:
+//
+//   orbit_ephem_file_hdr_t
+//   orbit_ephem_sat_rec_t  [sat_count]                  at sats_offset
+//   float coef[seg_count][sat_count][3][degree + 1]     at data_offset
+//
+// Segment s covers [t_start + s * seg_len_s, t_start + (s + 1) * seg_len_s). Each
+// axis (TEME x, y, z [km]) is sum(coef[k] * T_k(tau)), tau in [-1, 1] over the
+// segment. A NaN first coefficient marks a segment SGP4 could not propagate.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ORBIT_EPHEM_MAGIC      0x4850454Fu // "OEPH"
+#define ORBIT_EPHEM_VERSION    1
+#define ORBIT_EPHEM_MAX_DEGREE 15
+#define ORBIT_EPHEM_NAME_LEN   24
+
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint8_t degree;
+    uint8_t reserved0;
+    uint32_t sat_count;
+    uint32_t seg_count;
+    uint32_t seg_len_s;
+    uint32_t reserved1;
+    int64_t t_start_unix;
+    uint32_t sats_offset;
+    uint32_t data_offset;
+    float max_err_km; // worst fit error vs SGP4 over the file, as measured by the generator
+    float rms_err_km;
+} orbit_ephem_file_hdr_t;
+
+typedef struct {
+    uint32_t norad_id;
+    char name[ORBIT_EPHEM_NAME_LEN]; // NUL padded, not always terminated
+    float max_err_km;
+} orbit_ephem_sat_rec_t;
+
+#ifdef __cplusplus
+}
+#endif
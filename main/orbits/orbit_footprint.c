@@ -0,0 +1,39 @@
+#include <math.h>
+
+#include "orbit_footprint.h"
+
+#define DEG2RAD (M_PI / 180.0)
+
+#define EARTH_RADIUS_KM 6371.0
+
+double orbit_footprint_half_angle_rad(double alt_km, double min_elevation_deg) {
+    double eps = min_elevation_deg * DEG2RAD;
+    return acos(EARTH_RADIUS_KM * cos(eps) / (EARTH_RADIUS_KM + alt_km)) - eps;
+}
+
+void orbit_footprint_spans(double lat_deg, double half_angle_rad, int grid_w, int grid_h, int16_t *out_half_width) {
+    const double lat0 = lat_deg * DEG2RAD;
+    const double s0 = sin(lat0), c0 = cos(lat0);
+    const double cos_lam = cos(half_angle_rad);
+    const double cells_per_rad = grid_w / (2.0 * M_PI);
+
+    for (int row = 0; row < grid_h; row++) {
+        double lat = (90.0 - (row + 0.5) * 180.0 / grid_h) * DEG2RAD;
+        if (fabs(lat - lat0) > half_angle_rad) {
+            out_half_width[row] = ORBIT_FOOTPRINT_NO_ROW;
+            continue;
+        }
+
+        // Points at the footprint edge: cos(lam) = sin(lat) sin(lat0) + cos(lat) cos(lat0) cos(dlon)
+        double denom = cos(lat) * c0;
+        double c = (denom > 1e-12) ? (cos_lam - sin(lat) * s0) / denom : -2.0;
+        if (c <= -1.0) {
+            out_half_width[row] = ORBIT_FOOTPRINT_FULL_ROW;
+        } else if (c > 1.0) {
+            out_half_width[row] = ORBIT_FOOTPRINT_NO_ROW;
+        } else {
+            double hw = acos(c) * cells_per_rad;
+            out_half_width[row] = (hw * 2.0 >= grid_w) ? ORBIT_FOOTPRINT_FULL_ROW : (int16_t)lround(hw);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Row is fully inside the footprint (the footprint contains a pole)
+#define ORBIT_FOOTPRINT_FULL_ROW INT16_MAX
+// Row doesn't intersect the footprint
+#define ORBIT_FOOTPRINT_NO_ROW   (-1)
+
+// Earth central angle [rad] from the sub-satellite point to the edge of the area
+// that sees the satellite above min_elevation_deg
+double orbit_footprint_half_angle_rad(double alt_km, double min_elevation_deg);
+
+// Rasterize a footprint on an equirectangular grid (grid_w cells over 360 deg of
+// longitude, grid_h cells from +90 to -90 deg of latitude, sampled at cell centers).
+// The footprint is symmetric in longitude, so each row is a half width in cells
+// around the sub-satellite column: out_half_width[row] is the half width,
+// ORBIT_FOOTPRINT_FULL_ROW or ORBIT_FOOTPRINT_NO_ROW. Rows depend only on the
+// sub-satellite latitude, so a result can be reused at any longitude.
+void orbit_footprint_spans(double lat_deg, double half_angle_rad, int grid_w, int grid_h, int16_t *out_half_width);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,245 @@
+#include <math.h>
+
+#include "esp_log.h"
+#include "orbit_observer.h"
+
+static const char *TAG = "orbit_observer";
+
+#define DEG2RAD (M_PI / 180.0)
+#define RAD2DEG (180.0 / M_PI)
+
+// WGS84
+#define WGS84_A_KM 6378.137
+#define WGS84_F    (1.0 / 298.257223563)
+#define WGS84_E2   (WGS84_F * (2.0 - WGS84_F))
+
+#define EARTH_ROT_RAD_S 7.292115146706979e-5
+
+void orbit_station_init(orbit_station_t *st, double lat_deg, double lon_deg, double alt_km, float min_elevation_deg) {
+    if (!st) {
+        return;
+    }
+
+    double lat = lat_deg * DEG2RAD;
+    double lon = lon_deg * DEG2RAD;
+    double slat = sin(lat), clat = cos(lat);
+    double slon = sin(lon), clon = cos(lon);
+    double n = WGS84_A_KM / sqrt(1.0 - WGS84_E2 * slat * slat);
+
+    st->geo.lat_deg = lat_deg;
+    st->geo.lon_deg = lon_deg;
+    st->geo.alt_km = alt_km;
+    st->min_elevation_deg = min_elevation_deg;
+
+    st->ecef[0] = (n + alt_km) * clat * clon;
+    st->ecef[1] = (n + alt_km) * clat * slon;
+    st->ecef[2] = (n * (1.0 - WGS84_E2) + alt_km) * slat;
+
+    st->enu[0][0] = -slon;
+    st->enu[0][1] = clon;
+    st->enu[0][2] = 0.0;
+    st->enu[1][0] = -slat * clon;
+    st->enu[1][1] = -slat * slon;
+    st->enu[1][2] = clat;
+    st->enu[2][0] = clat * clon;
+    st->enu[2][1] = clat * slon;
+    st->enu[2][2] = slat;
+}
+
+double orbit_gmst_rad(double unix_time_sec) {
+    double jd_ut1 = unix_time_sec / 86400.0 + 2440587.5;
+    double tut1 = (jd_ut1 - 2451545.0) / 36525.0;
+    double gmst_sec = 67310.54841 + (876600.0 * 3600.0 + 8640184.812866) * tut1 + 0.093104 * tut1 * tut1 -
+                      6.2e-6 * tut1 * tut1 * tut1;
+    double gmst = fmod(gmst_sec * (2.0 * M_PI / 86400.0), 2.0 * M_PI);
+    return (gmst < 0.0) ? gmst + 2.0 * M_PI : gmst;
+}
+
+void orbit_teme_to_ecef(const orbit_eci_t *teme, double gmst_rad, orbit_eci_t *out_ecef) {
+    double c = cos(gmst_rad), s = sin(gmst_rad);
+    double x = c * teme->x + s * teme->y;
+    double y = -s * teme->x + c * teme->y;
+    out_ecef->x = x;
+    out_ecef->y = y;
+    out_ecef->z = teme->z;
+}
+
+void orbit_ecef_to_geodetic(const orbit_eci_t *ecef, orbit_geodetic_t *out_geo) {
+    double p = sqrt(ecef->x * ecef->x + ecef->y * ecef->y);
+    double lat = atan2(ecef->z, p * (1.0 - WGS84_E2));
+    double n = WGS84_A_KM;
+
+    // Converges to < 1 mm in a few iterations for LEO..GEO
+    for (int i = 0; i < 4; i++) {
+        double slat = sin(lat);
+        n = WGS84_A_KM / sqrt(1.0 - WGS84_E2 * slat * slat);
+        lat = atan2(ecef->z + n * WGS84_E2 * slat, p);
+    }
+
+    double clat = cos(lat);
+    out_geo->lat_deg = lat * RAD2DEG;
+    out_geo->lon_deg = atan2(ecef->y, ecef->x) * RAD2DEG;
+    out_geo->alt_km = (fabs(clat) > 1e-6) ? p / clat - n : fabs(ecef->z) - n * (1.0 - WGS84_E2);
+}
+
+void orbit_station_look(const orbit_station_t *st, const orbit_eci_t *teme, const orbit_eci_t *teme_vel,
+                        double unix_time_sec, orbit_look_t *out_look) {
+    double gmst = orbit_gmst_rad(unix_time_sec);
+    orbit_eci_t ecef;
+    orbit_teme_to_ecef(teme, gmst, &ecef);
+
+    double rho[3] = {ecef.x - st->ecef[0], ecef.y - st->ecef[1], ecef.z - st->ecef[2]};
+    double e = st->enu[0][0] * rho[0] + st->enu[0][1] * rho[1];
+    double n = st->enu[1][0] * rho[0] + st->enu[1][1] * rho[1] + st->enu[1][2] * rho[2];
+    double u = st->enu[2][0] * rho[0] + st->enu[2][1] * rho[1] + st->enu[2][2] * rho[2];
+    double range = sqrt(e * e + n * n + u * u);
+    double az = atan2(e, n) * RAD2DEG;
+
+    out_look->az_deg = (float)((az < 0.0) ? az + 360.0 : az);
+    out_look->el_deg = (float)(asin(u / range) * RAD2DEG);
+    out_look->range_km = (float)range;
+    out_look->range_rate_km_s = 0.0f;
+
+    if (teme_vel) {
+        // ECEF velocity: rotate, then remove the Earth rotation term (w x r)
+        orbit_eci_t v;
+        orbit_teme_to_ecef(teme_vel, gmst, &v);
+        v.x += EARTH_ROT_RAD_S * ecef.y;
+        v.y -= EARTH_ROT_RAD_S * ecef.x;
+        out_look->range_rate_km_s = (float)((rho[0] * v.x + rho[1] * v.y + rho[2] * v.z) / range);
+    }
+}
+
+esp_err_t orbit_station_look_sat(const orbit_station_t *st, orbit_sat_t *sat, int64_t unix_time_sec,
+                                 orbit_look_t *out_look) {
+    if (!st || !sat || !out_look) {
+        ESP_LOGE(TAG, "orbit_station_look_sat: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    orbit_eci_t pos, vel;
+    esp_err_t ret = orbit_sat_propagate_unix_state(sat, unix_time_sec, &pos, &vel);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    orbit_station_look(st, &pos, &vel, (double)unix_time_sec, out_look);
+    return ESP_OK;
+}
+
+// Station data in float, laid out for the inner loop
+typedef struct {
+    float p[3];
+    float e[3];
+    float n[3];
+    float u[3];
+    float sin2_mask; // sin^2(min elevation), sign kept in mask_neg
+    bool mask_neg;
+} station_f_t;
+
+esp_err_t orbit_look_batch(const orbit_station_t *stations, size_t n_stations, const orbit_soa_t *soa,
+                           bool reject_below, orbit_look_t *out, uint8_t *out_visible, size_t *out_n_visible) {
+    if (!stations || !soa || !out || n_stations == 0 || n_stations > ORBIT_LOOK_MAX_STATIONS) {
+        ESP_LOGE(TAG, "orbit_look_batch: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    station_f_t stf[ORBIT_LOOK_MAX_STATIONS];
+    for (size_t k = 0; k < n_stations; k++) {
+        const orbit_station_t *st = &stations[k];
+        for (int j = 0; j < 3; j++) {
+            stf[k].p[j] = (float)st->ecef[j];
+            stf[k].e[j] = (float)st->enu[0][j];
+            stf[k].n[j] = (float)st->enu[1][j];
+            stf[k].u[j] = (float)st->enu[2][j];
+        }
+        float sm = sinf(st->min_elevation_deg * (float)DEG2RAD);
+        stf[k].sin2_mask = sm * sm;
+        stf[k].mask_neg = sm < 0.0f;
+    }
+
+    double gmst = orbit_gmst_rad(soa->unix_time_sec);
+    const float c = (float)cos(gmst);
+    const float s = (float)sin(gmst);
+    const float w = (float)EARTH_ROT_RAD_S;
+    size_t n_visible = 0;
+
+    for (size_t i = 0; i < soa->count; i++) {
+        orbit_look_t *row = &out[i * n_stations];
+        uint8_t *vis = out_visible ? &out_visible[i * n_stations] : NULL;
+
+        if (!soa->valid[i]) {
+            for (size_t k = 0; k < n_stations; k++) {
+                row[k] = (orbit_look_t){.el_deg = -90.0f};
+                if (vis) {
+                    vis[k] = 0;
+                }
+            }
+            continue;
+        }
+
+        // TEME -> ECEF once per satellite, shared by all stations
+        const float rx = c * soa->x[i] + s * soa->y[i];
+        const float ry = -s * soa->x[i] + c * soa->y[i];
+        const float rz = soa->z[i];
+        const float vx = c * soa->vx[i] + s * soa->vy[i] + w * ry;
+        const float vy = -s * soa->vx[i] + c * soa->vy[i] - w * rx;
+        const float vz = soa->vz[i];
+
+        for (size_t k = 0; k < n_stations; k++) {
+            const station_f_t *sf = &stf[k];
+            const float dx = rx - sf->p[0];
+            const float dy = ry - sf->p[1];
+            const float dz = rz - sf->p[2];
+            const float u = sf->u[0] * dx + sf->u[1] * dy + sf->u[2] * dz;
+            const float r2 = dx * dx + dy * dy + dz * dz;
+
+            // Above the mask iff u / range > sin(mask): compare squares, no sqrt/asin
+            bool above = sf->mask_neg ? (u >= 0.0f || u * u < sf->sin2_mask * r2)
+                                      : (u > 0.0f && u * u > sf->sin2_mask * r2);
+            if (vis) {
+                vis[k] = above;
+            }
+            n_visible += above;
+
+            if (!above && reject_below) {
+                row[k] = (orbit_look_t){.el_deg = -90.0f};
+                continue;
+            }
+
+            const float e = sf->e[0] * dx + sf->e[1] * dy;
+            const float n = sf->n[0] * dx + sf->n[1] * dy + sf->n[2] * dz;
+            const float range = sqrtf(r2);
+            float az = atan2f(e, n) * (float)RAD2DEG;
+
+            row[k].az_deg = (az < 0.0f) ? az + 360.0f : az;
+            row[k].el_deg = asinf(u / range) * (float)RAD2DEG;
+            row[k].range_km = range;
+            row[k].range_rate_km_s = (dx * vx + dy * vy + dz * vz) / range;
+        }
+    }
+
+    if (out_n_visible) {
+        *out_n_visible = n_visible;
+    }
+    return ESP_OK;
+}
+
+esp_err_t orbit_subpoint_batch(const orbit_soa_t *soa, float *out_lat_deg, float *out_lon_deg) {
+    if (!soa || !out_lat_deg || !out_lon_deg) {
+        ESP_LOGE(TAG, "orbit_subpoint_batch: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    double gmst = orbit_gmst_rad(soa->unix_time_sec);
+    const float c = (float)cos(gmst);
+    const float s = (float)sin(gmst);
+    const float k = (float)(1.0 / (1.0 - WGS84_E2));
+
+    for (size_t i = 0; i < soa->count; i++) {
+        const float x = c * soa->x[i] + s * soa->y[i];
+        const float y = -s * soa->x[i] + c * soa->y[i];
+        out_lat_deg[i] = atan2f(k * soa->z[i], sqrtf(x * x + y * y)) * (float)RAD2DEG;
+        out_lon_deg[i] = atan2f(y, x) * (float)RAD2DEG;
+    }
+    return ESP_OK;
+}
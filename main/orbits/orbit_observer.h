@@ -0,0 +1,72 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit.h"
+#include "orbit_soa.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct {
+    double lat_deg;
+    double lon_deg;
+    double alt_km;
+} orbit_geodetic_t;
+
+// Ground station with its ECEF position and ECEF->ENU rotation computed once
+typedef struct {
+    orbit_geodetic_t geo;
+    double ecef[3];
+    double enu[3][3]; // rows: east, north, up
+    float min_elevation_deg;
+} orbit_station_t;
+
+typedef struct {
+    float az_deg;
+    float el_deg;
+    float range_km;
+    float range_rate_km_s;
+} orbit_look_t;
+
+void orbit_station_init(orbit_station_t *st, double lat_deg, double lon_deg, double alt_km, float min_elevation_deg);
+
+// Greenwich mean sidereal time (IAU-82) [rad]
+double orbit_gmst_rad(double unix_time_sec);
+
+// TEME -> ECEF (polar motion ignored)
+void orbit_teme_to_ecef(const orbit_eci_t *teme, double gmst_rad, orbit_eci_t *out_ecef);
+
+// ECEF [km] -> WGS84 geodetic
+void orbit_ecef_to_geodetic(const orbit_eci_t *ecef, orbit_geodetic_t *out_geo);
+
+// Look angles of a TEME state from a station (teme_vel may be NULL: range rate = 0)
+void orbit_station_look(const orbit_station_t *st, const orbit_eci_t *teme, const orbit_eci_t *teme_vel,
+                        double unix_time_sec, orbit_look_t *out_look);
+
+// Propagate and compute look angles in one call
+esp_err_t orbit_station_look_sat(const orbit_station_t *st, orbit_sat_t *sat, int64_t unix_time_sec,
+                                 orbit_look_t *out_look);
+
+#define ORBIT_LOOK_MAX_STATIONS 8
+
+// Look angles of every satellite of soa from every station, in one pass over the
+// states. out is row-major [sat][station] (soa->count * n_stations entries).
+// With reject_below, pairs below the station mask are detected from the up
+// component and squared range only and get el_deg = -90 (no az/range/rate).
+// out_visible (optional, same layout) is 1 for pairs above the mask.
+// Returns the number of visible pairs in out_n_visible (optional).
+esp_err_t orbit_look_batch(const orbit_station_t *stations, size_t n_stations, const orbit_soa_t *soa,
+                           bool reject_below, orbit_look_t *out, uint8_t *out_visible, size_t *out_n_visible);
+
+// Sub-satellite points of soa [deg], geodetic latitude from the surface relation
+// (good to ~0.2 deg at LEO, plenty for map plotting)
+esp_err_t orbit_subpoint_batch(const orbit_soa_t *soa, float *out_lat_deg, float *out_lon_deg);
+
+#ifdef __cplusplus
+}
+#endif
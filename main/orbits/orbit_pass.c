@@ -0,0 +1,137 @@
+#include <stdbool.h>
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "orbit_pass.h"
+
+static const char *TAG = "orbit_pass";
+
+// Elevation relative to the station mask (positive = visible)
+static esp_err_t el_above_mask(orbit_sat_t *sat, const orbit_station_t *st, int64_t t, float *out_el) {
+    orbit_look_t look;
+    esp_err_t ret = orbit_station_look_sat(st, sat, t, &look);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+    *out_el = look.el_deg - st->min_elevation_deg;
+    return ESP_OK;
+}
+
+// Refine a horizon crossing between t_lo (below if rising) and t_hi to 1 s
+static esp_err_t bisect_crossing(orbit_sat_t *sat, const orbit_station_t *st, int64_t t_lo, int64_t t_hi, bool rising,
+                                 int64_t *out_t) {
+    while (t_hi - t_lo > 1) {
+        int64_t mid = t_lo + (t_hi - t_lo) / 2;
+        float el;
+        esp_err_t ret = el_above_mask(sat, st, mid, &el);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+        if ((el > 0.0f) == rising) {
+            t_hi = mid;
+        } else {
+            t_lo = mid;
+        }
+    }
+    *out_t = t_hi;
+    return ESP_OK;
+}
+
+esp_err_t orbit_pass_find(orbit_sat_t *sat, const orbit_station_t *st, int64_t t_start, int64_t window_s,
+                          orbit_pass_t *out_pass) {
+    if (!sat || !st || !out_pass || window_s <= 0) {
+        ESP_LOGE(TAG, "orbit_pass_find: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    const int64_t step = ORBIT_PASS_COARSE_STEP_S;
+    float el = 0.0f;
+    esp_err_t ret = el_above_mask(sat, st, t_start, &el);
+    if (ret != ESP_OK) {
+        return ret;
+    }
+
+    // AOS: walk back when a pass is in progress, otherwise forward to the first rise
+    int64_t aos = t_start;
+    if (el > 0.0f) {
+        int64_t t = t_start;
+        float el_prev = el;
+        while (el_prev > 0.0f && t_start - t < 2 * 3600) {
+            t -= step;
+            ESP_RETURN_ON_ERROR(el_above_mask(sat, st, t, &el_prev), TAG, "propagation failed");
+        }
+        ESP_RETURN_ON_ERROR(bisect_crossing(sat, st, t, t + step, true, &aos), TAG, "propagation failed");
+    } else {
+        int64_t t = t_start;
+        while (el <= 0.0f) {
+            if (t - t_start >= window_s) {
+                return ESP_ERR_NOT_FOUND;
+            }
+            t += step;
+            ESP_RETURN_ON_ERROR(el_above_mask(sat, st, t, &el), TAG, "propagation failed");
+        }
+        ESP_RETURN_ON_ERROR(bisect_crossing(sat, st, t - step, t, true, &aos), TAG, "propagation failed");
+    }
+
+    // LOS and the coarse culmination
+    int64_t t = aos;
+    int64_t t_max = aos;
+    float el_max = -90.0f;
+    do {
+        t += step;
+        ESP_RETURN_ON_ERROR(el_above_mask(sat, st, t, &el), TAG, "propagation failed");
+        if (el > el_max) {
+            el_max = el;
+            t_max = t;
+        }
+    } while (el > 0.0f && t - aos < 24 * 3600);
+    int64_t los = t;
+    ESP_RETURN_ON_ERROR(bisect_crossing(sat, st, t - step, t, false, &los), TAG, "propagation failed");
+
+    // Ternary search of the culmination around the best coarse sample
+    int64_t lo = (t_max - step > aos) ? t_max - step : aos;
+    int64_t hi = (t_max + step < los) ? t_max + step : los;
+    while (hi - lo > 2) {
+        int64_t m1 = lo + (hi - lo) / 3;
+        int64_t m2 = hi - (hi - lo) / 3;
+        float e1, e2;
+        ESP_RETURN_ON_ERROR(el_above_mask(sat, st, m1, &e1), TAG, "propagation failed");
+        ESP_RETURN_ON_ERROR(el_above_mask(sat, st, m2, &e2), TAG, "propagation failed");
+        if (e1 < e2) {
+            lo = m1;
+        } else {
+            hi = m2;
+        }
+    }
+
+    orbit_look_t look;
+    out_pass->aos_unix = aos;
+    out_pass->los_unix = los;
+    out_pass->tca_unix = lo + (hi - lo) / 2;
+    ESP_RETURN_ON_ERROR(orbit_station_look_sat(st, sat, out_pass->tca_unix, &look), TAG, "propagation failed");
+    out_pass->max_el_deg = look.el_deg;
+    ESP_RETURN_ON_ERROR(orbit_station_look_sat(st, sat, aos, &look), TAG, "propagation failed");
+    out_pass->aos_az_deg = look.az_deg;
+    ESP_RETURN_ON_ERROR(orbit_station_look_sat(st, sat, los, &look), TAG, "propagation failed");
+    out_pass->los_az_deg = look.az_deg;
+
+    return ESP_OK;
+}
+
+esp_err_t orbit_pass_sample(orbit_sat_t *sat, const orbit_station_t *st, const orbit_pass_t *pass, orbit_look_t *out,
+                            size_t n) {
+    if (!sat || !st || !pass || !out || n < 2) {
+        ESP_LOGE(TAG, "orbit_pass_sample: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int64_t span = pass->los_unix - pass->aos_unix;
+    for (size_t i = 0; i < n; i++) {
+        int64_t t = pass->aos_unix + (span * (int64_t)i) / (int64_t)(n - 1);
+        esp_err_t ret = orbit_station_look_sat(st, sat, t, &out[i]);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    return ESP_OK;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit.h"
+#include "orbit_observer.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ORBIT_PASS_COARSE_STEP_S 60
+
+typedef struct {
+    int64_t aos_unix;
+    int64_t tca_unix;
+    int64_t los_unix;
+    float max_el_deg;
+    float aos_az_deg;
+    float los_az_deg;
+} orbit_pass_t;
+
+// First pass above the station elevation mask that is in progress at t_start or
+// starts within window_s seconds. ESP_ERR_NOT_FOUND when there is none.
+esp_err_t orbit_pass_find(orbit_sat_t *sat, const orbit_station_t *st, int64_t t_start, int64_t window_s,
+                          orbit_pass_t *out_pass);
+
+// n look samples evenly spaced from AOS to LOS (n >= 2)
+esp_err_t orbit_pass_sample(orbit_sat_t *sat, const orbit_station_t *st, const orbit_pass_t *pass, orbit_look_t *out,
+                            size_t n);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,6 +1,7 @@
 #include "esp_log.h"
 #include "orbit.h"
 
+#include <cmath>
 #include <ctime>
 #include <string>
 
@@ -48,7 +49,7 @@ esp_err_t orbit_sat_create_from_tle(const char *tle_line1, const char *tle_line2
     *out_sat = handle;
 
     auto epoch_dt = sat.epoch().to_datetime();
-    ESP_LOGI(TAG, "Satellite created from TLE. Epoch %04d-%02d-%02d %02d:%02d:%06.3f", 
+    ESP_LOGD(TAG, "Satellite created from TLE. Epoch %04d-%02d-%02d %02d:%02d:%06.3f", 
         epoch_dt.year, epoch_dt.month, epoch_dt.day, epoch_dt.hour, epoch_dt.min, epoch_dt.sec);
 
     return ESP_OK;
@@ -58,13 +59,30 @@ void orbit_sat_destroy(orbit_sat_t *sat) {
     if (!sat) {
         return;
     }
-    ESP_LOGI(TAG, "Destroy satellite handle");
+    ESP_LOGD(TAG, "Destroy satellite handle");
     delete sat;
 }
 
-// Unix UTC seconds -> JulianDate
-static JulianDate unix_to_julian(int64_t unix_time_sec) {
-    time_t t = (time_t)unix_time_sec;
+esp_err_t orbit_sat_reinit_from_tle(orbit_sat_t *sat, const char *tle_line1, const char *tle_line2) {
+    if (!sat || !tle_line1 || !tle_line2) {
+        ESP_LOGE(TAG, "orbit_sat_reinit_from_tle: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    Satellite fresh = Satellite::from_tle(std::string(tle_line1), std::string(tle_line2));
+    if (fresh.last_error() != Sgp4Error::NONE) {
+        ESP_LOGE(TAG, "Satellite::from_tle failed (err=%d)", (int)fresh.last_error());
+        return ESP_FAIL;
+    }
+
+    sat->sat = fresh;
+    return ESP_OK;
+}
+
+// Unix UTC seconds (fractional) -> JulianDate
+static JulianDate unix_to_julian(double unix_time_sec) {
+    double whole = floor(unix_time_sec);
+    time_t t = (time_t)whole;
     struct tm tm_utc;
     gmtime_r(&t, &tm_utc);
 
@@ -74,21 +92,22 @@ static JulianDate unix_to_julian(int64_t unix_time_sec) {
     dt.day = tm_utc.tm_mday;
     dt.hour = tm_utc.tm_hour;
     dt.min = tm_utc.tm_min;
-    dt.sec = (double)tm_utc.tm_sec;
+    dt.sec = (double)tm_utc.tm_sec + (unix_time_sec - whole);
 
     return JulianDate(dt);
 }
 
-esp_err_t orbit_sat_propagate_unix(orbit_sat_t *sat, int64_t unix_time_sec, orbit_eci_t *out_eci) {
-    if (!sat || !out_eci) {
-        ESP_LOGE(TAG, "orbit_sat_propagate_unix: invalid args");
+esp_err_t orbit_sat_propagate_state(orbit_sat_t *sat, double unix_time_sec, orbit_eci_t *out_pos,
+                                    orbit_eci_t *out_vel) {
+    if (!sat || !out_pos) {
+        ESP_LOGE(TAG, "orbit_sat_propagate_state: invalid args");
         return ESP_ERR_INVALID_ARG;
     }
 
     JulianDate t = unix_to_julian(unix_time_sec);
     double delta_days = t - sat->sat.epoch();
 
-    ESP_LOGI(TAG, "Propagate unix=%lld, delta_days=%.6f", (long long)unix_time_sec, delta_days);
+    ESP_LOGD(TAG, "Propagate unix=%.3f, delta_days=%.6f", unix_time_sec, delta_days);
 
     StateVector sv;
     Sgp4Error err = sat->sat.propagate(t, sv);
@@ -97,12 +116,26 @@ esp_err_t orbit_sat_propagate_unix(orbit_sat_t *sat, int64_t unix_time_sec, orbi
         return ESP_FAIL;
     }
 
-    out_eci->x = sv.position[0];
-    out_eci->y = sv.position[1];
-    out_eci->z = sv.position[2];
+    out_pos->x = sv.position[0];
+    out_pos->y = sv.position[1];
+    out_pos->z = sv.position[2];
+    if (out_vel) {
+        out_vel->x = sv.velocity[0];
+        out_vel->y = sv.velocity[1];
+        out_vel->z = sv.velocity[2];
+    }
 
-    ESP_LOGI(TAG, "ECI [km] x=%.3f y=%.3f z=%.3f", out_eci->x, out_eci->y, out_eci->z);
+    ESP_LOGD(TAG, "ECI [km] x=%.3f y=%.3f z=%.3f", out_pos->x, out_pos->y, out_pos->z);
 
     return ESP_OK;
 }
-} 
\ No newline at end of file
+
+esp_err_t orbit_sat_propagate_unix_state(orbit_sat_t *sat, int64_t unix_time_sec, orbit_eci_t *out_pos,
+                                         orbit_eci_t *out_vel) {
+    return orbit_sat_propagate_state(sat, (double)unix_time_sec, out_pos, out_vel);
+}
+
+esp_err_t orbit_sat_propagate_unix(orbit_sat_t *sat, int64_t unix_time_sec, orbit_eci_t *out_eci) {
+    return orbit_sat_propagate_unix_state(sat, unix_time_sec, out_eci, NULL);
+}
+}
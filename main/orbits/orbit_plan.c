@@ -0,0 +1,152 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "orbit_plan.h"
+
+static const char *TAG = "orbit_plan";
+
+static inline float az_norm(float az_deg) {
+    az_deg = fmodf(az_deg, 360.0f);
+    return (az_deg < 0.0f) ? az_deg + 360.0f : az_deg;
+}
+
+void orbit_plan_pass_init(orbit_plan_pass_t *p, uint32_t norad_id, int64_t origin_unix, int64_t aos_unix,
+                          int64_t los_unix, float aos_az_deg, float los_az_deg, float max_el_deg) {
+    *p = (orbit_plan_pass_t){
+        .norad_id = norad_id,
+        .aos_s = (int32_t)(aos_unix - origin_unix),
+        .los_s = (int32_t)(los_unix - origin_unix),
+        .aos_az_ddeg = (uint16_t)lroundf(az_norm(aos_az_deg) * 10.0f) % 3600,
+        .los_az_ddeg = (uint16_t)lroundf(az_norm(los_az_deg) * 10.0f) % 3600,
+        .max_el_deg = (max_el_deg <= 0.0f) ? 0 : (max_el_deg >= 90.0f) ? 90 : (uint8_t)lroundf(max_el_deg),
+    };
+}
+
+float orbit_plan_slew_s(const orbit_plan_rotator_t *rot, float from_az_deg, float to_az_deg) {
+    // With an end stop the rotator sweeps 0..360 and can't cross north
+    float d = fabsf(az_norm(to_az_deg) - az_norm(from_az_deg));
+    if (rot->az_continuous && d > 180.0f) {
+        d = 360.0f - d;
+    }
+    return rot->settle_s + d / rot->az_rate_deg_s;
+}
+
+static int cmp_los(const void *a, const void *b) {
+    const orbit_plan_pass_t *pa = a, *pb = b;
+    if (pa->los_s != pb->los_s) {
+        return (pa->los_s < pb->los_s) ? -1 : 1;
+    }
+    return (pa->aos_s < pb->aos_s) ? -1 : (pa->aos_s > pb->aos_s);
+}
+
+// Number of passes among the first n (sorted by LOS) with los <= t
+static size_t count_los_le(const orbit_plan_pass_t *passes, size_t n, int64_t t) {
+    size_t lo = 0, hi = n;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (passes[mid].los_s <= t) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+esp_err_t orbit_plan_solve(orbit_plan_pass_t *passes, size_t n, const orbit_plan_rotator_t *rot,
+                           uint32_t *out_selected, size_t *out_n_selected, orbit_plan_stats_t *out_stats) {
+    if ((!passes && n > 0) || !rot || rot->az_rate_deg_s <= 0.0f || rot->settle_s < 0.0f || !out_n_selected ||
+        (!out_selected && n > 0) || n > INT32_MAX) {
+        ESP_LOGE(TAG, "orbit_plan_solve: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    int64_t t0 = esp_timer_get_time();
+    *out_n_selected = 0;
+    orbit_plan_stats_t st = {.n_passes = n};
+
+    // best[i]: weight of the best plan ending with pass i (< 0: pass never selected),
+    // pred[i]: the pass before it, arg[i]: the best plan ending at or before pass i
+    float *best = NULL;
+    int32_t *pred = NULL, *arg = NULL;
+    if (n > 0) {
+        best = malloc(n * sizeof(float));
+        pred = malloc(n * sizeof(int32_t));
+        arg = malloc(n * sizeof(int32_t));
+        if (!best || !pred || !arg) {
+            free(best);
+            free(pred);
+            free(arg);
+            ESP_LOGE(TAG, "orbit_plan_solve: no mem for %u passes", (unsigned)n);
+            return ESP_ERR_NO_MEM;
+        }
+        qsort(passes, n, sizeof(*passes), cmp_los);
+    }
+
+    // Passes ending sure_gap before an AOS are compatible whatever their azimuths;
+    // no slew is shorter than the settle time
+    float max_slew = rot->settle_s + (rot->az_continuous ? 180.0f : 360.0f) / rot->az_rate_deg_s;
+    int64_t sure_gap = (int64_t)ceilf(max_slew);
+    int64_t min_gap = (int64_t)rot->settle_s;
+
+    for (size_t i = 0; i < n; i++) {
+        const orbit_plan_pass_t *p = &passes[i];
+        float val = 0.0f;
+        int32_t from = -1;
+        if (p->los_s <= p->aos_s || !(p->weight >= 0.0f)) {
+            best[i] = -1.0f;
+            pred[i] = -1;
+        } else {
+            st.value_all += p->weight;
+            // Earlier passes only: they end before this AOS, so before this LOS
+            size_t lo = count_los_le(passes, i, (int64_t)p->aos_s - sure_gap);
+            size_t hi = count_los_le(passes, i, (int64_t)p->aos_s - min_gap);
+            if (lo > 0 && best[arg[lo - 1]] > val) {
+                val = best[arg[lo - 1]];
+                from = arg[lo - 1];
+            }
+            for (size_t j = lo; j < hi; j++) {
+                if (best[j] <= val) {
+                    continue;
+                }
+                st.slew_checks++;
+                float gap = (float)((int64_t)p->aos_s - passes[j].los_s);
+                if (gap >= orbit_plan_slew_s(rot, passes[j].los_az_ddeg * 0.1f, p->aos_az_ddeg * 0.1f)) {
+                    val = best[j];
+                    from = (int32_t)j;
+                }
+            }
+            best[i] = p->weight + val;
+            pred[i] = from;
+        }
+        arg[i] = (i > 0 && best[arg[i - 1]] >= best[i]) ? arg[i - 1] : (int32_t)i;
+    }
+
+    // Walk the best plan back from its last pass, then put it in time order
+    size_t k = 0;
+    if (n > 0 && best[arg[n - 1]] > 0.0f) {
+        st.value = best[arg[n - 1]];
+        for (int32_t i = arg[n - 1]; i >= 0; i = pred[i]) {
+            out_selected[k++] = (uint32_t)i;
+            st.tracked_s += (int64_t)passes[i].los_s - passes[i].aos_s;
+        }
+        for (size_t a = 0, b = k - 1; a < b; a++, b--) {
+            uint32_t tmp = out_selected[a];
+            out_selected[a] = out_selected[b];
+            out_selected[b] = tmp;
+        }
+    }
+    free(best);
+    free(pred);
+    free(arg);
+
+    *out_n_selected = k;
+    st.n_selected = k;
+    st.elapsed_us = esp_timer_get_time() - t0;
+    if (out_stats) {
+        *out_stats = st;
+    }
+    return ESP_OK;
+}
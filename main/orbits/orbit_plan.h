@@ -0,0 +1,66 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Tracking plan for a single antenna: out of the predicted passes of a window,
+// the set of non-overlapping passes with the highest total weight, where the
+// rotator must also get from the LOS azimuth of one pass to the AOS azimuth of
+// the next in between. Weighted interval scheduling: passes sorted by LOS, the
+// best plan ending with each pass is its weight plus the best compatible earlier
+// plan. Every pass ending a full worst-case slew before the AOS is compatible
+// and comes from a running prefix maximum (binary search); only the few ending
+// closer are checked one by one. Exact, O(n log n).
+
+typedef struct {
+    float az_rate_deg_s; // azimuth slew rate
+    float settle_s;      // fixed cost of every repositioning
+    bool az_continuous;  // no end stop: the shorter way round, else a 0..360 deg sweep
+} orbit_plan_rotator_t;
+
+// Yaesu G-5500 class: 360 deg in about 60 s, end stop at north
+#define ORBIT_PLAN_ROTATOR_DEFAULT() {.az_rate_deg_s = 6.0f, .settle_s = 5.0f, .az_continuous = false}
+
+// 24 bytes, so a day of passes of hundreds of satellites fits in RAM: times in
+// seconds from an origin of the caller's (the window start), azimuths in 0.1 deg.
+typedef struct {
+    uint32_t norad_id;
+    int32_t aos_s;
+    int32_t los_s;
+    float weight;         // value of tracking the whole pass (e.g. priority x duration), >= 0
+    uint16_t aos_az_ddeg; // 0..3599
+    uint16_t los_az_ddeg;
+    uint8_t max_el_deg;
+} orbit_plan_pass_t;
+
+typedef struct {
+    size_t n_passes;
+    size_t n_selected;
+    float value;          // total weight of the plan
+    float value_all;      // of every pass, an upper bound
+    int64_t tracked_s;    // AOS to LOS of the selected passes
+    uint32_t slew_checks; // pairs closer than a worst-case slew, checked one by one
+    int64_t elapsed_us;
+} orbit_plan_stats_t;
+
+// Pass relative to origin_unix (within +-68 years of it), weight 0
+void orbit_plan_pass_init(orbit_plan_pass_t *p, uint32_t norad_id, int64_t origin_unix, int64_t aos_unix,
+                          int64_t los_unix, float aos_az_deg, float los_az_deg, float max_el_deg);
+
+// Rotator time from one azimuth to another (elevation is at the horizon at both ends) [s]
+float orbit_plan_slew_s(const orbit_plan_rotator_t *rot, float from_az_deg, float to_az_deg);
+
+// Sorts passes by LOS in place, then writes the indices of the selected ones, in
+// time order, to out_selected (room for n). Passes with los <= aos are never selected.
+esp_err_t orbit_plan_solve(orbit_plan_pass_t *passes, size_t n, const orbit_plan_rotator_t *rot,
+                           uint32_t *out_selected, size_t *out_n_selected, orbit_plan_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,138 @@
+#include <math.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "orbit_prefilter.h"
+
+static const char *TAG = "orbit_prefilter";
+
+#define DEG2RAD (M_PI / 180.0)
+#define RAD2DEG (180.0 / M_PI)
+
+#define EARTH_R_KM       6378.137
+#define EARTH_MU         398600.4418 // km^3/s^2
+#define SIDEREAL_REV_DAY 1.00273790935
+
+// Below this perigee the object has re-entered (SGP4 would fail anyway)
+#define DECAYED_PERIGEE_KM 80.0f
+// Spherical Earth / geodetic latitude slack
+#define LAT_MARGIN_DEG 0.5f
+
+void orbit_vis_bounds_from_tle(const orbit_tle_t *tle, orbit_vis_bounds_t *out_bounds) {
+    double n_rev_day = (double)tle->mean_motion_e8 * 1e-8;
+    double n_rad_s = n_rev_day * 2.0 * M_PI / 86400.0;
+    double a = cbrt(EARTH_MU / (n_rad_s * n_rad_s));
+    double e = (double)tle->ecc_e7 * 1e-7;
+    double incl = (double)tle->incl_e4 * 1e-4;
+
+    out_bounds->perigee_km = (float)(a * (1.0 - e) - EARTH_R_KM);
+    out_bounds->apogee_km = (float)(a * (1.0 + e) - EARTH_R_KM);
+    out_bounds->max_lat_deg = (float)((incl > 90.0) ? 180.0 - incl : incl);
+    out_bounds->epoch_unix = orbit_tle_epoch_unix(tle);
+
+    // Near-geosynchronous: the sub-satellite longitude only drifts slowly, so it is
+    // bounded by its mean value (RAAN + argp + M - GMST) plus the drift over the window.
+    out_bounds->synchronous = fabs(n_rev_day - SIDEREAL_REV_DAY) < 0.05 && e < 0.1 && incl < 20.0;
+    out_bounds->lon_epoch_deg = 0.0f;
+    out_bounds->lon_drift_deg_day = 0.0f;
+    out_bounds->lon_margin_deg = 0.0f;
+    if (out_bounds->synchronous) {
+        double ra = ((double)tle->raan_e4 + (double)tle->argp_e4 + (double)tle->ma_e4) * 1e-4;
+        double lon = fmod(ra - orbit_gmst_rad(out_bounds->epoch_unix) * RAD2DEG, 360.0);
+        lon = (lon < -180.0) ? lon + 360.0 : (lon > 180.0) ? lon - 360.0 : lon;
+        double i_rad = incl * DEG2RAD;
+        out_bounds->lon_epoch_deg = (float)lon;
+        out_bounds->lon_drift_deg_day = (float)((n_rev_day - SIDEREAL_REV_DAY) * 360.0);
+        // Equation of center (2e) + inclination figure-eight (i^2/4) + slack
+        out_bounds->lon_margin_deg = (float)((2.0 * e + i_rad * i_rad / 4.0) * RAD2DEG + 1.0);
+    }
+}
+
+// Earth central angle of the footprint at altitude h for elevation mask el
+static float coverage_angle_deg(float alt_km, float min_el_deg) {
+    double el = (double)min_el_deg * DEG2RAD;
+    double c = EARTH_R_KM * cos(el) / (EARTH_R_KM + alt_km);
+    return (float)((acos(c) - el) * RAD2DEG);
+}
+
+static float wrap180(float deg) {
+    deg = fmodf(deg, 360.0f);
+    if (deg > 180.0f) {
+        deg -= 360.0f;
+    } else if (deg < -180.0f) {
+        deg += 360.0f;
+    }
+    return deg;
+}
+
+bool orbit_vis_possible(const orbit_vis_bounds_t *bounds, const orbit_station_t *st, int64_t t_start,
+                        int64_t window_s) {
+    if (bounds->perigee_km < DECAYED_PERIGEE_KM) {
+        return false;
+    }
+
+    float lambda = coverage_angle_deg(bounds->apogee_km, st->min_elevation_deg);
+    if (fabsf((float)st->geo.lat_deg) > bounds->max_lat_deg + lambda + LAT_MARGIN_DEG) {
+        return false;
+    }
+
+    if (bounds->synchronous) {
+        float days0 = (float)(((double)t_start - bounds->epoch_unix) / 86400.0);
+        float days1 = days0 + (float)window_s / 86400.0f;
+        float swept = fabsf(bounds->lon_drift_deg_day) * (days1 - days0);
+        if (swept >= 360.0f) {
+            return true;
+        }
+        // Distance from the station longitude to the swept longitude interval
+        float lo = bounds->lon_epoch_deg + bounds->lon_drift_deg_day * ((bounds->lon_drift_deg_day < 0) ? days1 : days0);
+        float off = wrap180((float)st->geo.lon_deg - lo);
+        if (off < 0.0f) {
+            off += 360.0f;
+        }
+        float dist = (off <= swept) ? 0.0f : fminf(off - swept, 360.0f - off);
+        if (dist > lambda + bounds->lon_margin_deg) {
+            return false;
+        }
+    }
+    return true;
+}
+
+esp_err_t orbit_prefilter_catalog(orbit_catalog_t *cat, const orbit_station_t *stations, size_t n_stations,
+                                  int64_t t_start, int64_t window_s, uint8_t *out_candidate,
+                                  orbit_prefilter_stats_t *out_stats) {
+    if (!cat || !stations || n_stations == 0 || !out_candidate) {
+        ESP_LOGE(TAG, "orbit_prefilter_catalog: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    orbit_prefilter_stats_t stats = {0};
+    stats.total = orbit_catalog_count(cat);
+
+    for (size_t i = 0; i < stats.total; i++) {
+        orbit_vis_bounds_t b;
+        orbit_vis_bounds_from_tle(&orbit_catalog_at(cat, i)->tle, &b);
+
+        bool possible = false;
+        for (size_t k = 0; k < n_stations && !possible; k++) {
+            possible = orbit_vis_possible(&b, &stations[k], t_start, window_s);
+        }
+        out_candidate[i] = possible;
+
+        if (possible) {
+            stats.kept++;
+        } else if (b.perigee_km < DECAYED_PERIGEE_KM) {
+            stats.pruned_decayed++;
+        } else if (b.synchronous) {
+            stats.pruned_longitude++;
+        } else {
+            stats.pruned_latitude++;
+        }
+    }
+
+    stats.elapsed_us = esp_timer_get_time() - t0;
+    if (out_stats) {
+        *out_stats = stats;
+    }
+    return ESP_OK;
+}
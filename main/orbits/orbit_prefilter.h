@@ -0,0 +1,51 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit_catalog.h"
+#include "orbit_observer.h"
+#include "orbit_tle.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Conservative visibility bounds derived from the mean elements alone (no SGP4)
+typedef struct {
+    float perigee_km;
+    float apogee_km;
+    float max_lat_deg;        // highest sub-satellite latitude (inclination, folded for retrograde)
+    bool synchronous;         // near-geosynchronous: longitude is bounded too
+    float lon_epoch_deg;      // mean sub-satellite longitude at epoch (synchronous only)
+    float lon_drift_deg_day;  // longitude drift (synchronous only)
+    float lon_margin_deg;     // libration margin for inclination/eccentricity
+    double epoch_unix;
+} orbit_vis_bounds_t;
+
+typedef struct {
+    size_t total;
+    size_t kept;
+    size_t pruned_latitude;
+    size_t pruned_longitude;
+    size_t pruned_decayed;
+    int64_t elapsed_us;
+} orbit_prefilter_stats_t;
+
+void orbit_vis_bounds_from_tle(const orbit_tle_t *tle, orbit_vis_bounds_t *out_bounds);
+
+// False only when the satellite cannot rise above the station mask in [t_start, t_start + window_s]
+bool orbit_vis_possible(const orbit_vis_bounds_t *bounds, const orbit_station_t *st, int64_t t_start,
+                        int64_t window_s);
+
+// Mark the catalog entries that may be visible from any station in the window
+// (out_candidate[i] = 1, index = catalog index). Runs before any propagation.
+esp_err_t orbit_prefilter_catalog(orbit_catalog_t *cat, const orbit_station_t *stations, size_t n_stations,
+                                  int64_t t_start, int64_t window_s, uint8_t *out_candidate,
+                                  orbit_prefilter_stats_t *out_stats);
+
+#ifdef __cplusplus
+}
+#endif
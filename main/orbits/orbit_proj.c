@@ -0,0 +1,232 @@
+#include <math.h>
+#include <stdlib.h>
+
+#include "esp_log.h"
+#include "orbit_proj.h"
+
+static const char *TAG = "orbit_proj";
+
+#define DEG2RAD (M_PI / 180.0)
+#define RAD2DEG (180.0 / M_PI)
+
+// Lookup grid: 0.5 deg in latitude and longitude
+#define LUT_PER_DEG 2
+#define N_LAT       (180 * LUT_PER_DEG + 1)
+#define N_LON       (360 * LUT_PER_DEG)
+// Distance scale c / sin(c) tabulated over cos(c); past DIST_MIN_COS (c > ~154 deg,
+// near the antipode) it steepens too fast for the table and is computed exactly
+#define N_DIST       512
+#define DIST_MIN_COS (-0.9f)
+
+struct orbit_proj_t {
+    orbit_proj_kind_t kind;
+    int w;
+    int h;
+    float cx; // AZEQ disc center and radius [px]
+    float cy;
+    float r_px;
+    double lat0_rad;
+    double lon0_rad;
+
+    // AZEQ rows by latitude index: cos c = sin_sin + cos_cos * cos(dlon),
+    // x ~ cos_lat * sin(dlon), y ~ cos0_sin - sin0_cos * cos(dlon)
+    float *sin_sin;
+    float *cos_cos;
+    float *cos_lat;
+    float *cos0_sin;
+    float *sin0_cos;
+    // By longitude index, relative to the center longitude
+    float *dlon_sin;
+    float *dlon_cos;
+    // r_px / pi * c / sin(c) over cos c in [DIST_MIN_COS, 1]
+    float *dist;
+    float tables[];
+};
+
+static void azeq_tables_init(orbit_proj_t *p) {
+    float *t = p->tables;
+    p->sin_sin = t;
+    p->cos_cos = t += N_LAT;
+    p->cos_lat = t += N_LAT;
+    p->cos0_sin = t += N_LAT;
+    p->sin0_cos = t += N_LAT;
+    p->dlon_sin = t += N_LAT;
+    p->dlon_cos = t += N_LON;
+    p->dist = t += N_LON;
+
+    double s0 = sin(p->lat0_rad), c0 = cos(p->lat0_rad);
+    for (int i = 0; i < N_LAT; i++) {
+        double lat = (-90.0 + (double)i / LUT_PER_DEG) * DEG2RAD;
+        double s = sin(lat), c = cos(lat);
+        p->sin_sin[i] = (float)(s0 * s);
+        p->cos_cos[i] = (float)(c0 * c);
+        p->cos_lat[i] = (float)c;
+        p->cos0_sin[i] = (float)(c0 * s);
+        p->sin0_cos[i] = (float)(s0 * c);
+    }
+    for (int j = 0; j < N_LON; j++) {
+        double dlon = (-180.0 + (double)j / LUT_PER_DEG) * DEG2RAD - p->lon0_rad;
+        p->dlon_sin[j] = (float)sin(dlon);
+        p->dlon_cos[j] = (float)cos(dlon);
+    }
+    for (int m = 0; m < N_DIST; m++) {
+        double cos_c = DIST_MIN_COS + (1.0 - DIST_MIN_COS) * m / (N_DIST - 1);
+        double c = acos(cos_c > 1.0 ? 1.0 : cos_c);
+        p->dist[m] = (float)(p->r_px / M_PI * ((c > 1e-9) ? c / sin(c) : 1.0));
+    }
+}
+
+esp_err_t orbit_proj_create(orbit_proj_kind_t kind, int w, int h, double center_lat_deg, double center_lon_deg,
+                            orbit_proj_t **out_proj) {
+    if (!out_proj || w <= 0 || h <= 0 || (kind != ORBIT_PROJ_EQUIRECT && kind != ORBIT_PROJ_AZEQ) ||
+        fabs(center_lat_deg) > 90.0) {
+        ESP_LOGE(TAG, "orbit_proj_create: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    size_t n_tables = (kind == ORBIT_PROJ_AZEQ) ? 5 * N_LAT + 2 * N_LON + N_DIST : 0;
+    orbit_proj_t *p = calloc(1, sizeof(*p) + n_tables * sizeof(float));
+    if (!p) {
+        ESP_LOGE(TAG, "orbit_proj_create: no mem");
+        return ESP_ERR_NO_MEM;
+    }
+    p->kind = kind;
+    p->w = w;
+    p->h = h;
+    p->cx = w * 0.5f;
+    p->cy = h * 0.5f;
+    p->r_px = ((w < h) ? w : h) * 0.5f;
+    p->lat0_rad = center_lat_deg * DEG2RAD;
+    p->lon0_rad = center_lon_deg * DEG2RAD;
+    if (kind == ORBIT_PROJ_AZEQ) {
+        azeq_tables_init(p);
+    }
+    *out_proj = p;
+    return ESP_OK;
+}
+
+void orbit_proj_destroy(orbit_proj_t *proj) {
+    free(proj);
+}
+
+orbit_proj_kind_t orbit_proj_kind(const orbit_proj_t *proj) {
+    return proj->kind;
+}
+
+static inline float lerp(float a, float b, float t) {
+    return a + (b - a) * t;
+}
+
+static void azeq_forward(const orbit_proj_t *p, float lat_deg, float lon_deg, int16_t *out_x, int16_t *out_y) {
+    // Linear between table rows: far from the center the map stretches sideways by
+    // c / sin(c), so nearest-row lookups would show there
+    float fi = (lat_deg + 90.0f) * LUT_PER_DEG;
+    fi = (fi < 0.0f) ? 0.0f : (fi > N_LAT - 1) ? (float)(N_LAT - 1) : fi;
+    int i = (int)fi;
+    i = (i > N_LAT - 2) ? N_LAT - 2 : i;
+    float ti = fi - (float)i;
+    float fj = (lon_deg + 180.0f) * LUT_PER_DEG;
+    fj -= floorf(fj / N_LON) * N_LON;
+    int j = (int)fj;
+    float tj = fj - (float)j;
+    j = (j >= N_LON) ? 0 : j;
+    int j1 = (j + 1 < N_LON) ? j + 1 : 0;
+
+    float sin_sin = lerp(p->sin_sin[i], p->sin_sin[i + 1], ti);
+    float cos_cos = lerp(p->cos_cos[i], p->cos_cos[i + 1], ti);
+    float cos_lat = lerp(p->cos_lat[i], p->cos_lat[i + 1], ti);
+    float cos0_sin = lerp(p->cos0_sin[i], p->cos0_sin[i + 1], ti);
+    float sin0_cos = lerp(p->sin0_cos[i], p->sin0_cos[i + 1], ti);
+    float dlon_sin = lerp(p->dlon_sin[j], p->dlon_sin[j1], tj);
+    float dlon_cos = lerp(p->dlon_cos[j], p->dlon_cos[j1], tj);
+
+    float cos_c = sin_sin + cos_cos * dlon_cos;
+    float k;
+    if (cos_c >= DIST_MIN_COS) {
+        float f = (cos_c - DIST_MIN_COS) * ((N_DIST - 1) / (1.0f - DIST_MIN_COS));
+        int m = (int)f;
+        m = (m > N_DIST - 2) ? N_DIST - 2 : m;
+        k = lerp(p->dist[m], p->dist[m + 1], f - (float)m);
+    } else {
+        float c = acosf(cos_c < -1.0f ? -1.0f : cos_c);
+        float s = sinf(c);
+        if (s < 1e-6f) {
+            // The antipode: the whole rim, drawn at its bottom
+            *out_x = (int16_t)p->cx;
+            *out_y = (int16_t)(p->cy + p->r_px);
+            return;
+        }
+        k = p->r_px / (float)M_PI * c / s;
+    }
+    float x = k * cos_lat * dlon_sin;
+    float y = k * (cos0_sin - sin0_cos * dlon_cos);
+    *out_x = (int16_t)lroundf(p->cx + x);
+    *out_y = (int16_t)lroundf(p->cy - y);
+}
+
+void orbit_proj_forward(const orbit_proj_t *proj, float lat_deg, float lon_deg, int16_t *out_x, int16_t *out_y) {
+    if (proj->kind == ORBIT_PROJ_AZEQ) {
+        azeq_forward(proj, lat_deg, lon_deg, out_x, out_y);
+        return;
+    }
+    *out_x = (int16_t)((lon_deg + 180.0f) * (proj->w / 360.0f));
+    *out_y = (int16_t)((90.0f - lat_deg) * (proj->h / 180.0f));
+}
+
+esp_err_t orbit_proj_forward_batch(const orbit_proj_t *proj, const float *lat_deg, const float *lon_deg,
+                                   const uint8_t *valid, size_t n, int16_t *out_x, int16_t *out_y) {
+    if (!proj || ((!lat_deg || !lon_deg || !out_x || !out_y) && n > 0)) {
+        ESP_LOGE(TAG, "orbit_proj_forward_batch: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (proj->kind == ORBIT_PROJ_AZEQ) {
+        for (size_t i = 0; i < n; i++) {
+            if (!valid || valid[i]) {
+                azeq_forward(proj, lat_deg[i], lon_deg[i], &out_x[i], &out_y[i]);
+            }
+        }
+        return ESP_OK;
+    }
+    const float sx = proj->w / 360.0f, sy = proj->h / 180.0f;
+    for (size_t i = 0; i < n; i++) {
+        if (!valid || valid[i]) {
+            out_x[i] = (int16_t)((lon_deg[i] + 180.0f) * sx);
+            out_y[i] = (int16_t)((90.0f - lat_deg[i]) * sy);
+        }
+    }
+    return ESP_OK;
+}
+
+bool orbit_proj_inverse(const orbit_proj_t *proj, float x, float y, double *out_lat_deg, double *out_lon_deg) {
+    if (!proj || !out_lat_deg || !out_lon_deg) {
+        return false;
+    }
+    if (proj->kind == ORBIT_PROJ_EQUIRECT) {
+        if (x < 0.0f || y < 0.0f || x >= proj->w || y >= proj->h) {
+            return false;
+        }
+        *out_lon_deg = x * 360.0 / proj->w - 180.0;
+        *out_lat_deg = 90.0 - y * 180.0 / proj->h;
+        return true;
+    }
+
+    double dx = x - proj->cx, dy = proj->cy - y;
+    double rho = sqrt(dx * dx + dy * dy);
+    double c = rho / proj->r_px * M_PI;
+    if (c > M_PI) {
+        return false;
+    }
+    if (rho < 1e-9) {
+        *out_lat_deg = proj->lat0_rad * RAD2DEG;
+        *out_lon_deg = proj->lon0_rad * RAD2DEG;
+        return true;
+    }
+    double s0 = sin(proj->lat0_rad), c0 = cos(proj->lat0_rad);
+    double sc = sin(c), cc = cos(c);
+    double s_lat = cc * s0 + dy * sc * c0 / rho;
+    s_lat = (s_lat > 1.0) ? 1.0 : (s_lat < -1.0) ? -1.0 : s_lat;
+    double lon = proj->lon0_rad + atan2(dx * sc, rho * c0 * cc - dy * s0 * sc);
+    *out_lat_deg = asin(s_lat) * RAD2DEG;
+    *out_lon_deg = remainder(lon * RAD2DEG, 360.0);
+    return true;
+}
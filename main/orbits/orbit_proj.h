@@ -0,0 +1,44 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Map projections from geodetic lat/lon to pixels of a w x h map
+typedef enum {
+    ORBIT_PROJ_EQUIRECT, // plate carree, +90 deg at row 0, -180 deg at column 0
+    ORBIT_PROJ_AZEQ,     // azimuthal equidistant around a center (the station), north up;
+                         // the whole globe in a disc of radius min(w, h) / 2
+} orbit_proj_kind_t;
+
+typedef struct orbit_proj_t orbit_proj_t;
+
+// Builds the projection's lookup tables once: per-latitude and per-longitude
+// offset sine/cosine rows and the azimuthal distance scale (~15 KB for AZEQ,
+// none for EQUIRECT). center_* only matters for AZEQ.
+esp_err_t orbit_proj_create(orbit_proj_kind_t kind, int w, int h, double center_lat_deg, double center_lon_deg,
+                            orbit_proj_t **out_proj);
+void orbit_proj_destroy(orbit_proj_t *proj);
+
+orbit_proj_kind_t orbit_proj_kind(const orbit_proj_t *proj);
+
+// One point, interpolated in the tables
+void orbit_proj_forward(const orbit_proj_t *proj, float lat_deg, float lon_deg, int16_t *out_x, int16_t *out_y);
+
+// Every point in one pass (e.g. the sub-satellite points of the whole catalog).
+// Points with valid[i] == 0 (valid optional) keep their previous outputs.
+esp_err_t orbit_proj_forward_batch(const orbit_proj_t *proj, const float *lat_deg, const float *lon_deg,
+                                   const uint8_t *valid, size_t n, int16_t *out_x, int16_t *out_y);
+
+// Exact inverse at a (sub)pixel position, for rendering backgrounds once. false
+// outside the mapped area (the corners around the AZEQ disc).
+bool orbit_proj_inverse(const orbit_proj_t *proj, float x, float y, double *out_lat_deg, double *out_lon_deg);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,239 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "orbit_sched.h"
+
+static const char *TAG = "orbit_sched";
+
+typedef struct {
+    orbit_sched_task_cfg_t cfg;
+    int64_t deadline_us; // resolved, never 0
+    int64_t release_us;  // current (or next) release
+    orbit_sched_stats_t stats;
+} sched_task_t;
+
+struct orbit_sched_t {
+    orbit_sched_clock_t clock;
+    void *clock_ctx;
+    sched_task_t tasks[ORBIT_SCHED_MAX_TASKS];
+    size_t n_tasks;
+};
+
+static int64_t default_clock(void *ctx) {
+    (void)ctx;
+    return esp_timer_get_time();
+}
+
+static inline int64_t sched_now(const orbit_sched_t *s) {
+    return s->clock(s->clock_ctx);
+}
+
+esp_err_t orbit_sched_create(orbit_sched_clock_t clock, void *clock_ctx, orbit_sched_t **out_sched) {
+    if (!out_sched) {
+        ESP_LOGE(TAG, "orbit_sched_create: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    orbit_sched_t *s = calloc(1, sizeof(*s));
+    if (!s) {
+        ESP_LOGE(TAG, "orbit_sched_create: no mem");
+        return ESP_ERR_NO_MEM;
+    }
+    s->clock = clock ? clock : default_clock;
+    s->clock_ctx = clock_ctx;
+    *out_sched = s;
+    return ESP_OK;
+}
+
+void orbit_sched_destroy(orbit_sched_t *sched) {
+    free(sched);
+}
+
+esp_err_t orbit_sched_add(orbit_sched_t *sched, const orbit_sched_task_cfg_t *cfg, int *out_id) {
+    if (!sched || !cfg || !cfg->fn || cfg->period_us <= 0 || cfg->deadline_us < 0) {
+        ESP_LOGE(TAG, "orbit_sched_add: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (sched->n_tasks >= ORBIT_SCHED_MAX_TASKS) {
+        ESP_LOGE(TAG, "orbit_sched_add: more than %d tasks", ORBIT_SCHED_MAX_TASKS);
+        return ESP_ERR_NO_MEM;
+    }
+    sched_task_t *t = &sched->tasks[sched->n_tasks];
+    memset(t, 0, sizeof(*t));
+    t->cfg = *cfg;
+    t->deadline_us = cfg->deadline_us ? cfg->deadline_us : cfg->period_us;
+    t->release_us = sched_now(sched);
+    if (out_id) {
+        *out_id = (int)sched->n_tasks;
+    }
+    sched->n_tasks++;
+    return ESP_OK;
+}
+
+size_t orbit_sched_count(const orbit_sched_t *sched) {
+    return sched ? sched->n_tasks : 0;
+}
+
+static sched_task_t *task_get(orbit_sched_t *sched, int id) {
+    return (sched && id >= 0 && (size_t)id < sched->n_tasks) ? &sched->tasks[id] : NULL;
+}
+
+esp_err_t orbit_sched_set_period(orbit_sched_t *sched, int id, int64_t period_us, int64_t deadline_us) {
+    sched_task_t *t = task_get(sched, id);
+    if (!t || period_us <= 0 || deadline_us < 0) {
+        ESP_LOGE(TAG, "orbit_sched_set_period: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (t->cfg.period_us == period_us && t->cfg.deadline_us == deadline_us) {
+        return ESP_OK;
+    }
+    // release_us is already the next release: move it onto the new period
+    t->release_us += period_us - t->cfg.period_us;
+    t->cfg.period_us = period_us;
+    t->cfg.deadline_us = deadline_us;
+    t->deadline_us = deadline_us ? deadline_us : period_us;
+    return ESP_OK;
+}
+
+esp_err_t orbit_sched_trigger(orbit_sched_t *sched, int id) {
+    sched_task_t *t = task_get(sched, id);
+    if (!t) {
+        ESP_LOGE(TAG, "orbit_sched_trigger: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    int64_t now = sched_now(sched);
+    t->release_us = (now < t->release_us) ? now : t->release_us;
+    return ESP_OK;
+}
+
+static int hist_bin(int64_t v) {
+    int bin = 0;
+    while (v > 0 && bin < ORBIT_SCHED_HIST_BINS - 1) {
+        v >>= 1;
+        bin++;
+    }
+    return bin;
+}
+
+void orbit_sched_stats_add(orbit_sched_stats_t *st, int64_t late_us, int64_t exec_us, int64_t deadline_us) {
+    late_us = (late_us < 0) ? 0 : late_us;
+    exec_us = (exec_us < 0) ? 0 : exec_us;
+    st->runs++;
+    st->missed += (late_us + exec_us > deadline_us);
+    st->exec_sum_us += exec_us;
+    st->exec_max_us = (exec_us > st->exec_max_us) ? exec_us : st->exec_max_us;
+    st->late_max_us = (late_us > st->late_max_us) ? late_us : st->late_max_us;
+    st->exec_hist[hist_bin(exec_us)]++;
+    st->late_hist[hist_bin(late_us)]++;
+}
+
+int64_t orbit_sched_run(orbit_sched_t *sched) {
+    if (!sched || sched->n_tasks == 0) {
+        return INT64_MAX;
+    }
+    bool ran[ORBIT_SCHED_MAX_TASKS] = {false};
+    while (true) {
+        // Earliest absolute deadline among the released tasks not run in this call
+        int64_t now = sched_now(sched);
+        sched_task_t *pick = NULL;
+        for (size_t i = 0; i < sched->n_tasks; i++) {
+            sched_task_t *t = &sched->tasks[i];
+            if (!ran[i] && t->release_us <= now &&
+                (!pick || t->release_us + t->deadline_us < pick->release_us + pick->deadline_us)) {
+                pick = t;
+            }
+        }
+        if (!pick) {
+            break;
+        }
+        ran[pick - sched->tasks] = true;
+
+        int64_t start = sched_now(sched);
+        pick->cfg.fn(pick->cfg.ctx);
+        int64_t end = sched_now(sched);
+        orbit_sched_stats_add(&pick->stats, start - pick->release_us, end - start, pick->deadline_us);
+
+        // Next release on the period grid; whole periods already past are skipped
+        pick->release_us += pick->cfg.period_us;
+        if (pick->release_us + pick->cfg.period_us <= end) {
+            int64_t k = (end - pick->release_us) / pick->cfg.period_us;
+            pick->release_us += k * pick->cfg.period_us;
+            pick->stats.skipped += (uint32_t)k;
+        }
+    }
+
+    int64_t next = INT64_MAX;
+    for (size_t i = 0; i < sched->n_tasks; i++) {
+        next = (sched->tasks[i].release_us < next) ? sched->tasks[i].release_us : next;
+    }
+    return next;
+}
+
+esp_err_t orbit_sched_get_stats(orbit_sched_t *sched, int id, orbit_sched_stats_t *out_stats, bool reset) {
+    sched_task_t *t = task_get(sched, id);
+    if (!t || !out_stats) {
+        ESP_LOGE(TAG, "orbit_sched_get_stats: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    *out_stats = t->stats;
+    if (reset) {
+        memset(&t->stats, 0, sizeof(t->stats));
+    }
+    return ESP_OK;
+}
+
+int64_t orbit_sched_hist_quantile(const uint32_t *hist, float p) {
+    uint64_t total = 0;
+    for (int i = 0; i < ORBIT_SCHED_HIST_BINS; i++) {
+        total += hist[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+    uint64_t rank = (uint64_t)(p * (float)total);
+    rank = (rank >= total) ? total - 1 : rank;
+    uint64_t seen = 0;
+    for (int i = 0; i < ORBIT_SCHED_HIST_BINS; i++) {
+        seen += hist[i];
+        if (seen > rank) {
+            return (int64_t)1 << i;
+        }
+    }
+    return (int64_t)1 << (ORBIT_SCHED_HIST_BINS - 1);
+}
+
+int orbit_sched_format(const char *name, int64_t period_us, const orbit_sched_stats_t *st, char *buf,
+                       size_t len) {
+    // Quantiles are bin edges: "<" the value shown
+    return snprintf(buf, len,
+                    "%-9s %5lld ms: %5u runs, exec avg %lld max %lld p50 <%lld p99 <%lld us, "
+                    "late max %lld p50 <%lld p99 <%lld us, %u missed, %u skipped",
+                    name, (long long)(period_us / 1000), (unsigned)st->runs,
+                    (long long)(st->runs ? st->exec_sum_us / st->runs : 0), (long long)st->exec_max_us,
+                    (long long)orbit_sched_hist_quantile(st->exec_hist, 0.5f),
+                    (long long)orbit_sched_hist_quantile(st->exec_hist, 0.99f), (long long)st->late_max_us,
+                    (long long)orbit_sched_hist_quantile(st->late_hist, 0.5f),
+                    (long long)orbit_sched_hist_quantile(st->late_hist, 0.99f), (unsigned)st->missed,
+                    (unsigned)st->skipped);
+}
+
+int orbit_sched_format_all(orbit_sched_t *sched, char *buf, size_t len, bool reset) {
+    if (!sched || (!buf && len > 0)) {
+        return 0;
+    }
+    int total = 0;
+    for (size_t i = 0; i < sched->n_tasks; i++) {
+        sched_task_t *t = &sched->tasks[i];
+        size_t off = ((size_t)total < len) ? (size_t)total : len;
+        total += orbit_sched_format(t->cfg.name, t->cfg.period_us, &t->stats, buf + off, len - off);
+        off = ((size_t)total < len) ? (size_t)total : len;
+        total += snprintf(buf + off, len - off, "\n");
+        if (reset) {
+            memset(&t->stats, 0, sizeof(t->stats));
+        }
+    }
+    return total;
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Periodic tasks with declared deadlines, run cooperatively from one loop. Every
+// task is released once per period; orbit_sched_run() runs the released ones
+// earliest deadline first and returns the next release time so the caller can
+// sleep until exactly then. Per task it keeps log2 histograms of the execution
+// time and of the lateness (start - release), and counts missed deadlines and
+// releases skipped behind an overrun. Not thread-safe.
+#define ORBIT_SCHED_MAX_TASKS 16 // the device loop has 8
+#define ORBIT_SCHED_HIST_BINS 22 // 0 us, [1, 2) us, [2, 4) us ... [2^20 us, inf)
+
+// Monotonic microseconds. NULL in orbit_sched_create() means esp_timer_get_time();
+// host tests pass a simulated clock.
+typedef int64_t (*orbit_sched_clock_t)(void *ctx);
+typedef void (*orbit_sched_fn_t)(void *ctx);
+
+typedef struct {
+    const char *name;
+    int64_t period_us;
+    int64_t deadline_us; // after the release, 0 = the period
+    orbit_sched_fn_t fn;
+    void *ctx;
+} orbit_sched_task_cfg_t;
+
+typedef struct {
+    uint32_t runs;
+    uint32_t missed;  // finished past the deadline
+    uint32_t skipped; // releases dropped because the task was still late a period on
+    int64_t exec_sum_us;
+    int64_t exec_max_us;
+    int64_t late_max_us;
+    uint32_t exec_hist[ORBIT_SCHED_HIST_BINS];
+    uint32_t late_hist[ORBIT_SCHED_HIST_BINS];
+} orbit_sched_stats_t;
+
+typedef struct orbit_sched_t orbit_sched_t;
+
+esp_err_t orbit_sched_create(orbit_sched_clock_t clock, void *clock_ctx, orbit_sched_t **out_sched);
+void orbit_sched_destroy(orbit_sched_t *sched);
+
+// First release at the time of the call
+esp_err_t orbit_sched_add(orbit_sched_t *sched, const orbit_sched_task_cfg_t *cfg, int *out_id);
+size_t orbit_sched_count(const orbit_sched_t *sched);
+
+// New period (and deadline, 0 = the period) from the last release on
+esp_err_t orbit_sched_set_period(orbit_sched_t *sched, int id, int64_t period_us, int64_t deadline_us);
+// Release now instead of at the next period
+esp_err_t orbit_sched_trigger(orbit_sched_t *sched, int id);
+
+// Runs every released task at most once, earliest absolute deadline first.
+// Returns the earliest next release [us on the scheduler's clock].
+int64_t orbit_sched_run(orbit_sched_t *sched);
+
+esp_err_t orbit_sched_get_stats(orbit_sched_t *sched, int id, orbit_sched_stats_t *out_stats, bool reset);
+
+// For work timed outside the scheduler (e.g. the display refresh): one run into st
+void orbit_sched_stats_add(orbit_sched_stats_t *st, int64_t late_us, int64_t exec_us, int64_t deadline_us);
+
+// Upper edge of the bin holding the p (0..1) quantile [us], 0 with no samples
+int64_t orbit_sched_hist_quantile(const uint32_t *hist, float p);
+
+// One summary line: runs, exec avg / p50 / p99 / max, lateness p50 / p99 / max,
+// missed and skipped. Returns the length snprintf() would have written.
+int orbit_sched_format(const char *name, int64_t period_us, const orbit_sched_stats_t *st, char *buf,
+                       size_t len);
+
+// Summary of every task, one line each
+int orbit_sched_format_all(orbit_sched_t *sched, char *buf, size_t len, bool reset);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "orbit_soa.h"
+
+static const char *TAG = "orbit_soa";
+
+esp_err_t orbit_soa_alloc(orbit_soa_t *soa, size_t capacity) {
+    if (!soa) {
+        ESP_LOGE(TAG, "orbit_soa_alloc: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    memset(soa, 0, sizeof(*soa));
+    if (capacity == 0) {
+        return ESP_OK;
+    }
+
+    // One block: six float columns followed by the valid flags
+    float *block = malloc(capacity * (6 * sizeof(float) + sizeof(uint8_t)));
+    if (!block) {
+        ESP_LOGE(TAG, "orbit_soa_alloc: no mem for %u states", (unsigned)capacity);
+        return ESP_ERR_NO_MEM;
+    }
+    soa->x = block;
+    soa->y = block + capacity;
+    soa->z = block + 2 * capacity;
+    soa->vx = block + 3 * capacity;
+    soa->vy = block + 4 * capacity;
+    soa->vz = block + 5 * capacity;
+    soa->valid = (uint8_t *)(block + 6 * capacity);
+    soa->capacity = capacity;
+    return ESP_OK;
+}
+
+void orbit_soa_free(orbit_soa_t *soa) {
+    if (!soa) {
+        return;
+    }
+    free(soa->x);
+    memset(soa, 0, sizeof(*soa));
+}
+
+esp_err_t orbit_soa_interp(const orbit_soa_t *a, const orbit_soa_t *b, double unix_time_sec, orbit_soa_t *out) {
+    if (!a || !b || !out || a->count != b->count || b->unix_time_sec <= a->unix_time_sec) {
+        ESP_LOGE(TAG, "orbit_soa_interp: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    size_t count = a->count;
+    if (out->capacity < count) {
+        orbit_soa_free(out);
+        esp_err_t ret = orbit_soa_alloc(out, count);
+        if (ret != ESP_OK) {
+            return ret;
+        }
+    }
+    out->count = count;
+    out->unix_time_sec = unix_time_sec;
+
+    // Hermite basis at s in [0, 1] and its derivative (per s); velocities are scaled by h
+    const float h = (float)(b->unix_time_sec - a->unix_time_sec);
+    float s = (float)((unix_time_sec - a->unix_time_sec) / h);
+    s = (s < 0.0f) ? 0.0f : (s > 1.0f) ? 1.0f : s;
+    const float s2 = s * s, s3 = s2 * s;
+    const float h00 = 2.0f * s3 - 3.0f * s2 + 1.0f, h10 = (s3 - 2.0f * s2 + s) * h;
+    const float h01 = -2.0f * s3 + 3.0f * s2, h11 = (s3 - s2) * h;
+    const float d00 = (6.0f * s2 - 6.0f * s) / h, d10 = 3.0f * s2 - 4.0f * s + 1.0f;
+    const float d01 = (-6.0f * s2 + 6.0f * s) / h, d11 = 3.0f * s2 - 2.0f * s;
+
+    for (size_t i = 0; i < count; i++) {
+        out->valid[i] = a->valid[i] && b->valid[i];
+        if (!out->valid[i]) {
+            continue;
+        }
+        out->x[i] = h00 * a->x[i] + h10 * a->vx[i] + h01 * b->x[i] + h11 * b->vx[i];
+        out->y[i] = h00 * a->y[i] + h10 * a->vy[i] + h01 * b->y[i] + h11 * b->vy[i];
+        out->z[i] = h00 * a->z[i] + h10 * a->vz[i] + h01 * b->z[i] + h11 * b->vz[i];
+        out->vx[i] = d00 * a->x[i] + d10 * a->vx[i] + d01 * b->x[i] + d11 * b->vx[i];
+        out->vy[i] = d00 * a->y[i] + d10 * a->vy[i] + d01 * b->y[i] + d11 * b->vy[i];
+        out->vz[i] = d00 * a->z[i] + d10 * a->vz[i] + d01 * b->z[i] + d11 * b->vz[i];
+    }
+    return ESP_OK;
+}
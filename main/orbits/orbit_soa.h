@@ -0,0 +1,37 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Structure-of-arrays TEME states for batch stages (look angles, eclipse, ...).
+// float keeps the ESP32 on its single precision FPU; ~1 m resolution at GEO.
+typedef struct {
+    size_t count;
+    size_t capacity;
+    double unix_time_sec; // time of the states
+    float *x;
+    float *y;
+    float *z;
+    float *vx;
+    float *vy;
+    float *vz;
+    uint8_t *valid; // 0 when propagation failed
+} orbit_soa_t;
+
+esp_err_t orbit_soa_alloc(orbit_soa_t *soa, size_t capacity);
+void orbit_soa_free(orbit_soa_t *soa);
+
+// Cubic Hermite interpolation (positions and velocities) of the same satellites
+// between two states a and b at unix_time_sec, inside [a, b]. A satellite invalid in
+// either is invalid in out, which is grown when too small. The error grows with
+// the 4th power of the spacing: ~4 km at LEO for 10 min, well below a map pixel.
+esp_err_t orbit_soa_interp(const orbit_soa_t *a, const orbit_soa_t *b, double unix_time_sec, orbit_soa_t *out);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,125 @@
+#include <math.h>
+
+#include "esp_log.h"
+#include "orbit_sun.h"
+
+static const char *TAG = "orbit_sun";
+
+#define DEG2RAD (M_PI / 180.0)
+#define RAD2DEG (180.0 / M_PI)
+
+#define AU_KM           149597870.7
+#define SUN_RADIUS_KM   696000.0
+#define EARTH_RADIUS_KM 6378.137
+#define UNIX_EPOCH_JD   2440587.5
+#define J2000_JD        2451545.0
+
+void orbit_sun_at(double unix_time_sec, orbit_sun_t *out_sun) {
+    if (!out_sun) {
+        return;
+    }
+
+    // Astronomical Almanac low precision formulae, Julian centuries from J2000
+    double t = (unix_time_sec / 86400.0 + UNIX_EPOCH_JD - J2000_JD) / 36525.0;
+    double mean_lon = 280.460 + 36000.771 * t;
+    double m = (357.5291092 + 35999.05034 * t) * DEG2RAD;
+    double lon = (mean_lon + 1.914666471 * sin(m) + 0.019994643 * sin(2.0 * m)) * DEG2RAD;
+    double eps = (23.439291 - 0.0130042 * t) * DEG2RAD;
+    double r_au = 1.000140612 - 0.016708617 * cos(m) - 0.000139589 * cos(2.0 * m);
+
+    out_sun->unix_time_sec = unix_time_sec;
+    out_sun->gmst_rad = orbit_gmst_rad(unix_time_sec);
+    out_sun->dir[0] = (float)cos(lon);
+    out_sun->dir[1] = (float)(cos(eps) * sin(lon));
+    out_sun->dir[2] = (float)(sin(eps) * sin(lon));
+    out_sun->dist_km = (float)(r_au * AU_KM);
+}
+
+float orbit_sun_elevation_deg(const orbit_sun_t *sun, const orbit_station_t *st) {
+    if (!sun || !st) {
+        return -90.0f;
+    }
+    // Sun direction to ECEF; the station's parallax is negligible
+    double c = cos(sun->gmst_rad), s = sin(sun->gmst_rad);
+    double ex = c * sun->dir[0] + s * sun->dir[1];
+    double ey = -s * sun->dir[0] + c * sun->dir[1];
+    double ez = sun->dir[2];
+    double up = st->enu[2][0] * ex + st->enu[2][1] * ey + st->enu[2][2] * ez;
+    return (float)(asin(up) * RAD2DEG);
+}
+
+esp_err_t orbit_illum_batch(const orbit_sun_t *sun, const orbit_soa_t *soa, uint8_t *out_illum, uint8_t *out_eclipsed,
+                            size_t *out_n_eclipsed) {
+    if (!sun || !soa || !out_illum) {
+        ESP_LOGE(TAG, "orbit_illum_batch: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    // Shadow radii at a distance l behind the Earth's centre along the Sun axis:
+    // umbra re - l * tan_u, penumbra re + l * tan_p
+    const float re = (float)EARTH_RADIUS_KM;
+    const float tan_u = (float)((SUN_RADIUS_KM - EARTH_RADIUS_KM) / sun->dist_km);
+    const float tan_p = (float)((SUN_RADIUS_KM + EARTH_RADIUS_KM) / sun->dist_km);
+    const float ux = sun->dir[0], uy = sun->dir[1], uz = sun->dir[2];
+    size_t n_eclipsed = 0;
+
+    for (size_t i = 0; i < soa->count; i++) {
+        if (!soa->valid[i]) {
+            continue;
+        }
+        const float x = soa->x[i], y = soa->y[i], z = soa->z[i];
+        const float along = x * ux + y * uy + z * uz;
+        uint8_t illum = ORBIT_ILLUM_FULL;
+
+        // Day side satellites and those clear of the penumbra cone skip the sqrt
+        if (along < 0.0f) {
+            const float l = -along;
+            const float perp2 = x * x + y * y + z * z - along * along;
+            const float r_pen = re + l * tan_p;
+            if (perp2 < r_pen * r_pen) {
+                const float r_umb = re - l * tan_u;
+                const float perp = sqrtf(perp2);
+                illum = (perp <= r_umb) ? 0
+                                        : (uint8_t)(ORBIT_ILLUM_FULL * (perp - r_umb) / (r_pen - r_umb) + 0.5f);
+            }
+        }
+
+        out_illum[i] = illum;
+        bool eclipsed = illum < (ORBIT_ILLUM_FULL + 1) / 2;
+        if (out_eclipsed) {
+            out_eclipsed[i] = eclipsed;
+        }
+        n_eclipsed += eclipsed;
+    }
+
+    if (out_n_eclipsed) {
+        *out_n_eclipsed = n_eclipsed;
+    }
+    return ESP_OK;
+}
+
+float orbit_visual_magnitude(const orbit_sun_t *sun, const orbit_station_t *st, const orbit_soa_t *soa, size_t i,
+                             uint8_t illum, float std_mag) {
+    if (!sun || !st || !soa || i >= soa->count || !soa->valid[i] || illum == 0) {
+        return ORBIT_MAG_NONE;
+    }
+
+    // Station ECEF -> TEME, then satellite -> station
+    double c = cos(sun->gmst_rad), s = sin(sun->gmst_rad);
+    double dx = c * st->ecef[0] - s * st->ecef[1] - soa->x[i];
+    double dy = s * st->ecef[0] + c * st->ecef[1] - soa->y[i];
+    double dz = st->ecef[2] - soa->z[i];
+    double range = sqrt(dx * dx + dy * dy + dz * dz);
+
+    // Phase angle at the satellite between the Sun and the station. Diffuse sphere:
+    // F = (sin ph + (pi - ph) cos ph) / pi, 1 / pi at 90 deg where std_mag applies.
+    double cos_ph = (dx * sun->dir[0] + dy * sun->dir[1] + dz * sun->dir[2]) / range;
+    cos_ph = (cos_ph > 1.0) ? 1.0 : (cos_ph < -1.0) ? -1.0 : cos_ph;
+    double ph = acos(cos_ph);
+    double phase = (sin(ph) + (M_PI - ph) * cos_ph) / M_PI;
+    if (phase <= 1e-6) {
+        return ORBIT_MAG_NONE;
+    }
+    double flux = phase * M_PI * illum / ORBIT_ILLUM_FULL;
+    return (float)(std_mag + 5.0 * log10(range / 1000.0) - 2.5 * log10(flux));
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit_observer.h"
+#include "orbit_soa.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Sun direction for one timestamp, shared by the batch stages at that time.
+// Low precision solar theory (~0.01 deg), mean equator of date, which is TEME to
+// well under the Sun's radius.
+typedef struct {
+    double unix_time_sec;
+    double gmst_rad;
+    float dir[3]; // unit vector Earth -> Sun
+    float dist_km;
+} orbit_sun_t;
+
+void orbit_sun_at(double unix_time_sec, orbit_sun_t *out_sun);
+
+// Sun elevation seen from a station [deg] (optical passes need the station below
+// about -6 deg and the satellite sunlit)
+float orbit_sun_elevation_deg(const orbit_sun_t *sun, const orbit_station_t *st);
+
+// Fraction of the Sun's disc seen by a satellite, 0 (umbra) .. ORBIT_ILLUM_FULL
+#define ORBIT_ILLUM_FULL 255
+
+// Illumination of every satellite of soa (taken at sun->unix_time_sec) in one pass:
+// conical Earth shadow with a linear penumbra. out_illum is one byte per satellite;
+// out_eclipsed (optional) is 1 when the Sun's centre is hidden (illum below half).
+// Invalid satellites are skipped and keep their previous outputs.
+// Returns the number of eclipsed valid satellites in out_n_eclipsed (optional).
+esp_err_t orbit_illum_batch(const orbit_sun_t *sun, const orbit_soa_t *soa, uint8_t *out_illum, uint8_t *out_eclipsed,
+                            size_t *out_n_eclipsed);
+
+// Standard magnitude (1000 km, half illuminated) used when a satellite has none:
+// roughly a few-metre object
+#define ORBIT_STD_MAG_DEFAULT 5.0f
+// Returned for satellites that can't be seen (eclipsed)
+#define ORBIT_MAG_NONE 99.0f
+
+// Apparent visual magnitude of the i-th satellite of soa from a station, diffuse
+// sphere phase law scaled by the illumination from orbit_illum_batch()
+float orbit_visual_magnitude(const orbit_sun_t *sun, const orbit_station_t *st, const orbit_soa_t *soa, size_t i,
+                             uint8_t illum, float std_mag);
+
+#ifdef __cplusplus
+}
+#endif
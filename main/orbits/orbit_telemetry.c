@@ -0,0 +1,125 @@
+#include <string.h>
+
+#include "esp_log.h"
+#include "orbit_telemetry.h"
+
+static const char *TAG = "orbit_telemetry";
+
+_Static_assert(sizeof(orbit_tlm_hdr_t) == 16, "orbit_tlm_hdr_t wire layout");
+_Static_assert(sizeof(orbit_tlm_pos_t) == 44, "orbit_tlm_pos_t wire layout");
+
+uint16_t orbit_tlm_crc16(const uint8_t *data, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (int b = 0; b < 8; b++) {
+            crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+        }
+    }
+    return crc;
+}
+
+size_t orbit_tlm_cobs_encode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t code_at = 0, o = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++) {
+        if (in[i] != 0) {
+            out[o++] = in[i];
+            code++;
+        }
+        // A zero, or a full block of 254 non-zero bytes, closes the current block
+        if (in[i] == 0 || code == 0xFF) {
+            out[code_at] = code;
+            code_at = o++;
+            code = 1;
+        }
+    }
+    out[code_at] = code;
+    return o;
+}
+
+size_t orbit_tlm_cobs_decode(const uint8_t *in, size_t len, uint8_t *out) {
+    size_t i = 0, o = 0;
+    while (i < len) {
+        uint8_t code = in[i++];
+        if (code == 0 || i + code - 1 > len) {
+            return 0;
+        }
+        for (uint8_t k = 1; k < code; k++) {
+            if (in[i] == 0) {
+                return 0;
+            }
+            out[o++] = in[i++];
+        }
+        // The implicit zero after a short block, except at the end of the frame
+        if (code != 0xFF && i < len) {
+            out[o++] = 0;
+        }
+    }
+    return o;
+}
+
+esp_err_t orbit_tlm_encode(uint32_t seq, int64_t t_unix_ms, const orbit_tlm_pos_t *recs, size_t count,
+                           uint8_t *out_frame, size_t *out_len) {
+    if ((!recs && count > 0) || count > ORBIT_TLM_MAX_RECORDS || !out_frame || !out_len) {
+        ESP_LOGE(TAG, "orbit_tlm_encode: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    uint8_t payload[ORBIT_TLM_PAYLOAD_MAX];
+    orbit_tlm_hdr_t hdr = {
+        .type = ORBIT_TLM_TYPE_POSITION,
+        .version = ORBIT_TLM_VERSION,
+        .count = (uint16_t)count,
+        .seq = seq,
+        .t_unix_ms = t_unix_ms,
+    };
+    size_t n = 0;
+    memcpy(payload, &hdr, sizeof(hdr));
+    n += sizeof(hdr);
+    if (count > 0) {
+        memcpy(payload + n, recs, count * sizeof(*recs));
+        n += count * sizeof(*recs);
+    }
+    uint16_t crc = orbit_tlm_crc16(payload, n);
+    memcpy(payload + n, &crc, sizeof(crc));
+    n += sizeof(crc);
+
+    size_t m = orbit_tlm_cobs_encode(payload, n, out_frame);
+    out_frame[m++] = 0;
+    *out_len = m;
+    return ESP_OK;
+}
+
+esp_err_t orbit_tlm_decode(const uint8_t *frame, size_t len, orbit_tlm_hdr_t *out_hdr, orbit_tlm_pos_t *out_recs) {
+    if (!frame || !out_hdr || !out_recs) {
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (len > ORBIT_TLM_FRAME_MAX) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    uint8_t payload[ORBIT_TLM_FRAME_MAX];
+    size_t n = orbit_tlm_cobs_decode(frame, len, payload);
+    if (n < sizeof(orbit_tlm_hdr_t) + sizeof(uint16_t)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    uint16_t crc;
+    memcpy(&crc, payload + n - sizeof(crc), sizeof(crc));
+    n -= sizeof(crc);
+    if (crc != orbit_tlm_crc16(payload, n)) {
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    orbit_tlm_hdr_t hdr;
+    memcpy(&hdr, payload, sizeof(hdr));
+    if (hdr.type != ORBIT_TLM_TYPE_POSITION || hdr.version != ORBIT_TLM_VERSION) {
+        return ESP_ERR_INVALID_VERSION;
+    }
+    if (hdr.count > ORBIT_TLM_MAX_RECORDS || n != sizeof(hdr) + hdr.count * sizeof(orbit_tlm_pos_t)) {
+        return ESP_ERR_INVALID_SIZE;
+    }
+    *out_hdr = hdr;
+    memcpy(out_recs, payload + sizeof(hdr), hdr.count * sizeof(orbit_tlm_pos_t));
+    return ESP_OK;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#include "orbit_telemetry_format.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Largest message before and after framing (COBS adds a byte per 254 plus one, then
+// the 0x00 delimiter)
+#define ORBIT_TLM_PAYLOAD_MAX \
+    (sizeof(orbit_tlm_hdr_t) + ORBIT_TLM_MAX_RECORDS * sizeof(orbit_tlm_pos_t) + sizeof(uint16_t))
+#define ORBIT_TLM_FRAME_MAX (ORBIT_TLM_PAYLOAD_MAX + ORBIT_TLM_PAYLOAD_MAX / 254 + 2)
+
+uint16_t orbit_tlm_crc16(const uint8_t *data, size_t len);
+
+// COBS, without the delimiter. Encode writes at most len + len / 254 + 1 bytes.
+// Decode returns 0 for malformed input (a zero byte or a code past the end).
+size_t orbit_tlm_cobs_encode(const uint8_t *in, size_t len, uint8_t *out);
+size_t orbit_tlm_cobs_decode(const uint8_t *in, size_t len, uint8_t *out);
+
+// One position message into out_frame (ORBIT_TLM_FRAME_MAX bytes), delimiter
+// included. count is at most ORBIT_TLM_MAX_RECORDS.
+esp_err_t orbit_tlm_encode(uint32_t seq, int64_t t_unix_ms, const orbit_tlm_pos_t *recs, size_t count,
+                           uint8_t *out_frame, size_t *out_len);
+
+// One frame as cut at the delimiter (not included). out_recs holds
+// ORBIT_TLM_MAX_RECORDS. ESP_ERR_INVALID_CRC / _SIZE / _VERSION for damaged or
+// foreign frames.
+esp_err_t orbit_tlm_decode(const uint8_t *frame, size_t len, orbit_tlm_hdr_t *out_hdr, orbit_tlm_pos_t *out_recs);
+
+#ifdef __cplusplus
+}
+#endif
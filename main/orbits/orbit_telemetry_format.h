@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+
+// Binary position stream sent over UART by the device and read by tools/tlm_decode.
+// Each frame is one message, COBS encoded and terminated by a 0x00 byte, so a
+// reader can join the stream anywhere and resynchronize at the next zero:
+//
+//   orbit_tlm_hdr_t
+//   orbit_tlm_pos_t  [count]
+//   uint16_t crc                 CRC-16/CCITT-FALSE of the header and records
+//
+// Little-endian, fields naturally aligned so the structs need no packing.
+// seq counts messages sent; a gap at the reader means frames were dropped
+// (device ring full or line errors).
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ORBIT_TLM_VERSION       1
+#define ORBIT_TLM_TYPE_POSITION 1
+#define ORBIT_TLM_MAX_RECORDS   16
+
+typedef struct {
+    uint8_t type;
+    uint8_t version;
+    uint16_t count; // records following
+    uint32_t seq;
+    int64_t t_unix_ms; // time of the states
+} orbit_tlm_hdr_t;
+
+// TEME state and look angles from the first ground station
+typedef struct {
+    uint32_t norad_id;
+    float pos_km[3];
+    float vel_km_s[3];
+    float az_deg;
+    float el_deg;
+    float range_km;
+    float range_rate_km_s;
+} orbit_tlm_pos_t;
+
+#ifdef __cplusplus
+}
+#endif
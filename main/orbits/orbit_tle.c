@@ -0,0 +1,262 @@
+#include <ctype.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "orbit_tle.h"
+
+static const char *TAG = "orbit_tle";
+
+// Parse an unsigned integer from a fixed-width, space padded field
+static bool parse_uint(const char *s, int len, uint32_t *out) {
+    uint32_t v = 0;
+    bool any = false;
+    for (int i = 0; i < len; i++) {
+        if (s[i] == ' ' && !any) {
+            continue;
+        }
+        if (!isdigit((unsigned char)s[i])) {
+            return false;
+        }
+        v = v * 10 + (uint32_t)(s[i] - '0');
+        any = true;
+    }
+    *out = v;
+    return true;
+}
+
+// Parse a decimal field ("  97.3940", " .00010984", "-.00001") into value * 10^frac_digits
+static bool parse_fixed(const char *s, int len, int frac_digits, int64_t *out) {
+    int64_t v = 0;
+    int sign = 1;
+    int frac = -1;
+    bool any = false;
+
+    for (int i = 0; i < len; i++) {
+        char c = s[i];
+        if (c == ' ' && !any && frac < 0) {
+            continue;
+        }
+        if ((c == '-' || c == '+') && !any && frac < 0) {
+            sign = (c == '-') ? -1 : 1;
+            continue;
+        }
+        if (c == '.' && frac < 0) {
+            frac = 0;
+            continue;
+        }
+        if (!isdigit((unsigned char)c)) {
+            return false;
+        }
+        if (frac >= 0) {
+            if (frac >= frac_digits) {
+                return false;
+            }
+            frac++;
+        }
+        v = v * 10 + (c - '0');
+        any = true;
+    }
+    if (!any) {
+        return false;
+    }
+    for (int f = (frac < 0) ? 0 : frac; f < frac_digits; f++) {
+        v *= 10;
+    }
+    *out = sign * v;
+    return true;
+}
+
+// Parse the "assumed decimal point" exponent fields (" 41796-3", "-11606-4")
+static bool parse_exp_field(const char *s, int32_t *mant, int8_t *exp) {
+    uint32_t m = 0;
+    uint32_t e = 0;
+    if (!parse_uint(s + 1, 5, &m) || !isdigit((unsigned char)s[7])) {
+        return false;
+    }
+    if (s[6] != '-' && s[6] != '+' && s[6] != ' ') {
+        return false;
+    }
+    e = (uint32_t)(s[7] - '0');
+    *mant = (s[0] == '-') ? -(int32_t)m : (int32_t)m;
+    *exp = (s[6] == '-') ? -(int8_t)e : (int8_t)e;
+    return true;
+}
+
+// Catalog number, including the Alpha-5 scheme (A0000 = 100000, I and O unused)
+static bool parse_catnum(const char *s, uint32_t *out) {
+    char c = s[0];
+    if (c >= 'A' && c <= 'Z' && c != 'I' && c != 'O') {
+        uint32_t rest = 0;
+        if (!parse_uint(s + 1, 4, &rest)) {
+            return false;
+        }
+        uint32_t hi = (uint32_t)(c - 'A') + 10;
+        if (c > 'I') {
+            hi--;
+        }
+        if (c > 'O') {
+            hi--;
+        }
+        *out = hi * 10000 + rest;
+        return true;
+    }
+    return parse_uint(s, 5, out);
+}
+
+// Inverse of parse_catnum()
+static void format_catnum(uint32_t id, char out[6]) {
+    static const char k_alpha5[] = "ABCDEFGHJKLMNPQRSTUVWXYZ";
+    uint32_t hi = id / 10000;
+    out[0] = (hi < 10) ? (char)('0' + hi) : (hi - 10 < sizeof(k_alpha5) - 1) ? k_alpha5[hi - 10] : '?';
+    for (int i = 4, rest = (int)(id % 10000); i >= 1; i--, rest /= 10) {
+        out[i] = (char)('0' + rest % 10);
+    }
+    out[5] = '\0';
+}
+
+// Inverse of parse_exp_field(): " 41796-3"
+static void format_exp_field(int32_t mant, int8_t exp, char out[9]) {
+    unsigned m = (unsigned)(mant < 0 ? -mant : mant) % 100000u;
+    unsigned e = (unsigned)(exp < 0 ? -exp : exp) % 10u;
+    snprintf(out, 9, "%c%05u%c%u", mant < 0 ? '-' : ' ', m, exp < 0 ? '-' : '+', e);
+}
+
+// Fields are reduced to their column widths, so an out of range value shows up as a
+// checksum-valid but different element set; orbit_tle_parse() never produces one
+esp_err_t orbit_tle_format(const orbit_tle_t *tle, char *out_line1, char *out_line2) {
+    if (!tle || !out_line1 || !out_line2) {
+        ESP_LOGE(TAG, "orbit_tle_format: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    char catnum[6], nddot[9], bstar[9];
+    format_catnum(tle->norad_id, catnum);
+    format_exp_field(tle->nddot_mant, tle->nddot_exp, nddot);
+    format_exp_field(tle->bstar_mant, tle->bstar_exp, bstar);
+    unsigned ndot = (unsigned)(tle->ndot_e8 < 0 ? -tle->ndot_e8 : tle->ndot_e8) % 100000000u;
+
+    snprintf(out_line1, ORBIT_TLE_LINE_LEN + 1, "1 %s%c %-8.8s %02u%03u.%08u %c.%08u %s %s %c %4u", catnum,
+             tle->classification, tle->intl_desig, tle->epoch_year % 100u, tle->epoch_doy % 1000u,
+             (unsigned)(tle->epoch_frac_e8 % 100000000u), tle->ndot_e8 < 0 ? '-' : ' ', ndot, nddot, bstar,
+             tle->ephem_type, tle->elset_num % 10000u);
+    snprintf(out_line2, ORBIT_TLE_LINE_LEN + 1, "2 %s %3u.%04u %3u.%04u %07u %3u.%04u %3u.%04u %2u.%08u%5u", catnum,
+             (unsigned)(tle->incl_e4 / 10000 % 1000), (unsigned)(tle->incl_e4 % 10000),
+             (unsigned)(tle->raan_e4 / 10000 % 1000), (unsigned)(tle->raan_e4 % 10000),
+             (unsigned)(tle->ecc_e7 % 10000000), (unsigned)(tle->argp_e4 / 10000 % 1000),
+             (unsigned)(tle->argp_e4 % 10000), (unsigned)(tle->ma_e4 / 10000 % 1000), (unsigned)(tle->ma_e4 % 10000),
+             (unsigned)(tle->mean_motion_e8 / 100000000 % 100), (unsigned)(tle->mean_motion_e8 % 100000000),
+             (unsigned)(tle->rev_num % 100000));
+    out_line1[ORBIT_TLE_LINE_LEN - 1] = (char)('0' + orbit_tle_checksum(out_line1));
+    out_line2[ORBIT_TLE_LINE_LEN - 1] = (char)('0' + orbit_tle_checksum(out_line2));
+    out_line1[ORBIT_TLE_LINE_LEN] = '\0';
+    out_line2[ORBIT_TLE_LINE_LEN] = '\0';
+    return ESP_OK;
+}
+
+uint8_t orbit_tle_checksum(const char *line) {
+    uint32_t sum = 0;
+    for (int i = 0; i < ORBIT_TLE_LINE_LEN - 1 && line[i]; i++) {
+        if (isdigit((unsigned char)line[i])) {
+            sum += (uint32_t)(line[i] - '0');
+        } else if (line[i] == '-') {
+            sum += 1;
+        }
+    }
+    return (uint8_t)(sum % 10);
+}
+
+static size_t line_len(const char *line) {
+    size_t n = strlen(line);
+    while (n > 0 && (line[n - 1] == '\n' || line[n - 1] == '\r' || line[n - 1] == ' ')) {
+        n--;
+    }
+    return n;
+}
+
+esp_err_t orbit_tle_parse(const char *line1, const char *line2, orbit_tle_t *out_tle) {
+    if (!line1 || !line2 || !out_tle) {
+        ESP_LOGE(TAG, "orbit_tle_parse: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    if (line_len(line1) < ORBIT_TLE_LINE_LEN || line_len(line2) < ORBIT_TLE_LINE_LEN || line1[0] != '1' ||
+        line2[0] != '2') {
+        ESP_LOGD(TAG, "Malformed TLE lines");
+        return ESP_ERR_INVALID_SIZE;
+    }
+
+    orbit_tle_t t;
+    memset(&t, 0, sizeof(t));
+
+    if (!isdigit((unsigned char)line1[68]) || !isdigit((unsigned char)line2[68])) {
+        return ESP_ERR_INVALID_RESPONSE;
+    }
+    t.checksum1 = (uint8_t)(line1[68] - '0');
+    t.checksum2 = (uint8_t)(line2[68] - '0');
+    if (orbit_tle_checksum(line1) != t.checksum1 || orbit_tle_checksum(line2) != t.checksum2) {
+        ESP_LOGD(TAG, "TLE checksum mismatch");
+        return ESP_ERR_INVALID_CRC;
+    }
+
+    uint32_t catnum2 = 0;
+    uint32_t u = 0;
+    int64_t f = 0;
+    bool ok = parse_catnum(line1 + 2, &t.norad_id) && parse_catnum(line2 + 2, &catnum2) && catnum2 == t.norad_id;
+
+    t.classification = line1[7];
+    memcpy(t.intl_desig, line1 + 9, 8);
+    t.intl_desig[8] = '\0';
+
+    ok = ok && parse_uint(line1 + 18, 2, &u);
+    t.epoch_year = (uint8_t)u;
+    ok = ok && parse_uint(line1 + 20, 3, &u) && u >= 1 && u <= 366;
+    t.epoch_doy = (uint16_t)u;
+    ok = ok && line1[23] == '.' && parse_uint(line1 + 24, 8, &t.epoch_frac_e8);
+
+    ok = ok && parse_fixed(line1 + 33, 10, 8, &f);
+    t.ndot_e8 = (int32_t)f;
+    ok = ok && parse_exp_field(line1 + 44, &t.nddot_mant, &t.nddot_exp);
+    ok = ok && parse_exp_field(line1 + 53, &t.bstar_mant, &t.bstar_exp);
+    t.ephem_type = line1[62];
+    ok = ok && parse_uint(line1 + 64, 4, &u);
+    t.elset_num = (uint16_t)u;
+
+    ok = ok && parse_fixed(line2 + 8, 8, 4, &f) && f >= 0 && f <= 1800000;
+    t.incl_e4 = (uint32_t)f;
+    ok = ok && parse_fixed(line2 + 17, 8, 4, &f) && f >= 0 && f < 3600000;
+    t.raan_e4 = (uint32_t)f;
+    ok = ok && parse_uint(line2 + 26, 7, &t.ecc_e7);
+    ok = ok && parse_fixed(line2 + 34, 8, 4, &f) && f >= 0 && f < 3600000;
+    t.argp_e4 = (uint32_t)f;
+    ok = ok && parse_fixed(line2 + 43, 8, 4, &f) && f >= 0 && f < 3600000;
+    t.ma_e4 = (uint32_t)f;
+    ok = ok && parse_fixed(line2 + 52, 11, 8, &f) && f > 0;
+    t.mean_motion_e8 = (uint64_t)f;
+    ok = ok && parse_uint(line2 + 63, 5, &t.rev_num);
+
+    if (!ok) {
+        ESP_LOGD(TAG, "TLE field parse failed");
+        return ESP_ERR_INVALID_ARG;
+    }
+
+    *out_tle = t;
+    return ESP_OK;
+}
+
+// Days from 1970-01-01 to Jan 1st of a Gregorian year
+static int64_t days_to_year(int year) {
+    int64_t y = year - 1;
+    return 365 * (int64_t)(year - 1970) + (y / 4 - y / 100 + y / 400) - (1969 / 4 - 1969 / 100 + 1969 / 400);
+}
+
+double orbit_tle_epoch_unix(const orbit_tle_t *tle) {
+    int year = (tle->epoch_year < 57) ? 2000 + tle->epoch_year : 1900 + tle->epoch_year;
+    double days = (double)days_to_year(year) + (double)(tle->epoch_doy - 1) + (double)tle->epoch_frac_e8 * 1e-8;
+    return days * 86400.0;
+}
+
+bool orbit_tle_same_elset(const orbit_tle_t *a, const orbit_tle_t *b) {
+    return a->norad_id == b->norad_id && a->epoch_year == b->epoch_year && a->epoch_doy == b->epoch_doy &&
+           a->epoch_frac_e8 == b->epoch_frac_e8 && a->checksum1 == b->checksum1 && a->checksum2 == b->checksum2;
+}
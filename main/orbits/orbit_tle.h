@@ -0,0 +1,63 @@
+#pragma once
+
+#include "esp_err.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ORBIT_TLE_LINE_LEN 69
+#define ORBIT_TLE_NAME_LEN 24
+
+// Mean elements of one TLE, kept as the fixed-point values printed in the text so
+// two element sets can be compared exactly and the lines can be rebuilt later.
+typedef struct {
+    uint32_t norad_id;
+    char classification;
+    char intl_desig[9];
+
+    uint8_t epoch_year;      // two digit year, 57..99 -> 19xx, 00..56 -> 20xx
+    uint16_t epoch_doy;      // day of year (1..366)
+    uint32_t epoch_frac_e8;  // fraction of day * 1e8
+
+    int32_t ndot_e8;         // first derivative of mean motion / 2 [rev/day^2] * 1e8
+    int32_t nddot_mant;      // second derivative / 6, mantissa of 0.xxxxx (signed)
+    int8_t nddot_exp;
+    int32_t bstar_mant;      // B* drag term, mantissa of 0.xxxxx (signed)
+    int8_t bstar_exp;
+    char ephem_type;
+    uint16_t elset_num;
+
+    uint32_t incl_e4;        // inclination [deg] * 1e4
+    uint32_t raan_e4;        // right ascension of ascending node [deg] * 1e4
+    uint32_t ecc_e7;         // eccentricity * 1e7
+    uint32_t argp_e4;        // argument of perigee [deg] * 1e4
+    uint32_t ma_e4;          // mean anomaly [deg] * 1e4
+    uint64_t mean_motion_e8; // [rev/day] * 1e8
+    uint32_t rev_num;
+
+    uint8_t checksum1;
+    uint8_t checksum2;
+} orbit_tle_t;
+
+// Parse and validate (layout + checksums) a TLE line pair
+esp_err_t orbit_tle_parse(const char *line1, const char *line2, orbit_tle_t *out_tle);
+
+// Rebuild the line pair of a parsed TLE (same values, canonical spacing and signs,
+// fresh checksums). Buffers hold ORBIT_TLE_LINE_LEN + 1 chars.
+esp_err_t orbit_tle_format(const orbit_tle_t *tle, char *out_line1, char *out_line2);
+
+// Checksum digit of a TLE line (first 68 columns)
+uint8_t orbit_tle_checksum(const char *line);
+
+// Epoch as Unix UTC seconds
+double orbit_tle_epoch_unix(const orbit_tle_t *tle);
+
+// True when both element sets describe the same epoch and text (by checksum)
+bool orbit_tle_same_elset(const orbit_tle_t *a, const orbit_tle_t *b);
+
+#ifdef __cplusplus
+}
+#endif
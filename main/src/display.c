@@ -1,11 +1,17 @@
+#include <string.h>
+
 #include "freertos/FreeRTOS.h"
+#include "freertos/semphr.h"
 #include "freertos/task.h"
 
 #include "driver/gpio.h"
 #include "driver/spi_master.h"
 
 #include "esp_check.h"
+#include "esp_heap_caps.h"
 #include "esp_log.h"
+#include "esp_task_wdt.h"
+#include "esp_timer.h"
 
 #include "esp_lcd_panel_io.h"
 #include "esp_lcd_panel_ops.h"
@@ -19,16 +25,33 @@
 
 #include "board_pins.h"
 #include "display.h"
+#include "display_priv.h"
 
 static const char *TAG = "display";
 
+#define DISPLAY_PCLK_HZ           (20 * 1000 * 1000)
+#define DISPLAY_TRANS_QUEUE_DEPTH 10
+// Lines per LVGL draw buffer (two of them, DMA capable); the bus takes up to the max
+#define DISPLAY_BAND_LINES     40
+#define DISPLAY_MAX_BAND_LINES 60
+
 // Panel-specific color constants (calibrated to what you actually see/ used for debug)
 #define PANEL_COLOR_RED 0xF800
 #define PANEL_COLOR_GREEN 0x001F
 #define PANEL_COLOR_BLUE 0x07E0
 
 static lv_disp_t *s_lv_disp = NULL;
-static lv_indev_t *s_lv_touch = NULL;
+
+// LVGL refresh timing: a refresh is due LV_DEF_REFR_PERIOD after the previous one
+// started. The refresh timer pauses while nothing is invalid, so a longer gap
+// starts over instead of counting as lateness.
+#define REFR_PERIOD_US   (LV_DEF_REFR_PERIOD * 1000LL)
+#define REFR_IDLE_GAP_US (4 * REFR_PERIOD_US)
+
+static portMUX_TYPE s_refr_lock = portMUX_INITIALIZER_UNLOCKED;
+static orbit_sched_stats_t s_refr_stats;
+static int64_t s_refr_start_us = 0;
+static int64_t s_refr_prev_start_us = 0;
 
 static void enable_backlight(void) {
     gpio_config_t bklt_config = {
@@ -98,41 +121,23 @@ static void horizontal_wipe(display_t *disp, uint16_t color, uint32_t duration_m
 }
 #endif
 
-esp_err_t display_init(display_t *disp) {
-
-    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "display_t pointer is NULL");
-
-    disp->io = NULL;
-    disp->panel = NULL;
-    disp->touch = NULL;
-    disp->touch_io = NULL;
-
-    disp->rotation_swap_xy = true;
-    disp->rotation_mirror_x = false;
-    disp->rotation_mirror_y = false;
-
-    ESP_LOGI(TAG, "Initializing SPI bus");
-    spi_bus_config_t buscfg = {
-        .sclk_io_num = PIN_NUM_CLK,
-        .mosi_io_num = PIN_NUM_MOSI,
-        .miso_io_num = PIN_NUM_MISO,
-        .quadwp_io_num = -1,
-        .quadhd_io_num = -1,
-        .max_transfer_sz = LCD_H_RES * 60 * sizeof(uint16_t),
-    };
-    ESP_RETURN_ON_ERROR(spi_bus_initialize(LCD_HOST, &buscfg, 0), TAG, "spi_bus_initialize failed");
-
+// Panel IO + ST7796 at the given SPI clock and queue depth, initialized and on
+static esp_err_t panel_create(const display_t *disp, uint32_t pclk_hz, size_t queue_depth,
+                              esp_lcd_panel_io_color_trans_done_cb_t on_done, void *user_ctx,
+                              esp_lcd_panel_io_handle_t *out_io, esp_lcd_panel_handle_t *out_panel) {
     esp_lcd_panel_io_handle_t io_handle = NULL;
     esp_lcd_panel_handle_t panel_handle = NULL;
 
     esp_lcd_panel_io_spi_config_t io_config = {
         .dc_gpio_num = PIN_NUM_DC,
         .cs_gpio_num = PIN_NUM_CS,
-        .pclk_hz = 20 * 1000 * 1000,
+        .pclk_hz = pclk_hz,
         .lcd_cmd_bits = 8,
         .lcd_param_bits = 8,
         .spi_mode = 0,
-        .trans_queue_depth = 10,
+        .trans_queue_depth = queue_depth,
+        .on_color_trans_done = on_done,
+        .user_ctx = user_ctx,
         .flags =
             {
                 .dc_low_on_data = false,
@@ -146,17 +151,231 @@ esp_err_t display_init(display_t *disp) {
         .bits_per_pixel = 16,
     };
 
-    ESP_RETURN_ON_ERROR(esp_lcd_new_panel_st7796(io_handle, &panel_config, &panel_handle), TAG, "esp_lcd_new_panel_st7796 failed");
+    esp_err_t ret = esp_lcd_new_panel_st7796(io_handle, &panel_config, &panel_handle);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "esp_lcd_new_panel_st7796 failed");
+        esp_lcd_panel_io_del(io_handle);
+        return ret;
+    }
 
     ESP_LOGI(TAG, "Reset and init panel");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_reset(panel_handle), TAG, "panel reset failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_init(panel_handle), TAG, "panel init failed");
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_reset(panel_handle), err, TAG, "panel reset failed");
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_init(panel_handle), err, TAG, "panel init failed");
+
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_swap_xy(panel_handle, disp->rotation_swap_xy), err, TAG, "panel swap_xy failed");
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_mirror(panel_handle, disp->rotation_mirror_x, disp->rotation_mirror_y), err, TAG, "panel mirror failed");
+
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_invert_color(panel_handle, false), err, TAG, "invert color failed");
+    ESP_GOTO_ON_ERROR(esp_lcd_panel_disp_on_off(panel_handle, true), err, TAG, "disp_on_off failed");
+
+    *out_io = io_handle;
+    *out_panel = panel_handle;
+    return ESP_OK;
+
+err:
+    esp_lcd_panel_del(panel_handle);
+    esp_lcd_panel_io_del(io_handle);
+    return ret;
+}
+
+#if BENCH_DISPLAY
+// Flush pipeline benchmark: every pclk x band height x queue depth combination
+// runs the workloads below through raw esp_lcd double-buffered band flushes (what
+// esp_lvgl_port does), reporting FPS, bytes/s and the CPU left idle meanwhile.
+static const uint32_t k_bench_pclk_hz[] = {20 * 1000 * 1000, 40 * 1000 * 1000, 80 * 1000 * 1000};
+static const uint16_t k_bench_band_lines[] = {20, 40, 60}; // <= DISPLAY_MAX_BAND_LINES
+static const uint8_t k_bench_queue_depth[] = {2, 10};
+
+#define BENCH_WORKLOAD_MS 500
+
+typedef struct {
+    const char *name;
+    uint16_t n_areas; // areas flushed per frame, at pseudo-random positions when smaller than the screen
+    uint16_t w;
+    uint16_t h;
+} bench_workload_t;
+
+static const bench_workload_t k_bench_workloads[] = {
+    {"full", 1, LCD_H_RES, LCD_V_RES},
+    {"list", 1, LCD_H_RES, 28 * 10},
+    {"markers", 16, 16, 16},
+};
+
+static SemaphoreHandle_t s_bench_free_bufs;
+static volatile uint32_t s_spin_count;
+static volatile bool s_spin_run;
+
+static bool bench_on_color_done(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *ctx) {
+    BaseType_t woken = pdFALSE;
+    xSemaphoreGiveFromISR(s_bench_free_bufs, &woken);
+    return woken == pdTRUE;
+}
+
+// Lowest priority busy loop on the benchmark core: its progress is the idle CPU
+static void bench_spin_task(void *arg) {
+    while (s_spin_run) {
+        s_spin_count++;
+    }
+    xSemaphoreGive((SemaphoreHandle_t)arg);
+    vTaskDelete(NULL);
+}
+
+typedef struct {
+    uint32_t frames;
+    uint64_t bytes;
+    int64_t elapsed_us;
+    uint32_t spins;
+} bench_result_t;
+
+static void bench_workload(esp_lcd_panel_handle_t panel, uint16_t *bufs[2], uint16_t band_lines,
+                           const bench_workload_t *wl, bench_result_t *out) {
+    uint32_t seed = 1;
+    uint16_t color = 0;
+    int cur = 0;
+    *out = (bench_result_t){0};
+
+    uint32_t spin0 = s_spin_count;
+    int64_t t0 = esp_timer_get_time();
+    while (esp_timer_get_time() - t0 < BENCH_WORKLOAD_MS * 1000LL) {
+        color += 0x0841;
+        for (int a = 0; a < wl->n_areas; a++) {
+            seed = seed * 1103515245u + 12345u;
+            int x0 = (wl->w < LCD_H_RES) ? (int)((seed >> 8) % (LCD_H_RES - wl->w)) : 0;
+            int y0 = (wl->h < LCD_V_RES) ? (int)((seed >> 20) % (LCD_V_RES - wl->h)) : 0;
+
+            // Areas taller than a band go out in bands, like a partial LVGL buffer
+            for (int y = y0; y < y0 + wl->h; y += band_lines) {
+                int lines = (y0 + wl->h - y < band_lines) ? y0 + wl->h - y : band_lines;
+                size_t px = (size_t)wl->w * lines;
+                xSemaphoreTake(s_bench_free_bufs, portMAX_DELAY);
+                for (size_t i = 0; i < px; i++) {
+                    bufs[cur][i] = color;
+                }
+                esp_lcd_panel_draw_bitmap(panel, x0, y, x0 + wl->w, y + lines, bufs[cur]);
+                out->bytes += px * sizeof(uint16_t);
+                cur ^= 1;
+            }
+        }
+        out->frames++;
+    }
+    // Drain: both buffers back means the last band is on the panel
+    xSemaphoreTake(s_bench_free_bufs, portMAX_DELAY);
+    xSemaphoreTake(s_bench_free_bufs, portMAX_DELAY);
+    out->elapsed_us = esp_timer_get_time() - t0;
+    out->spins = s_spin_count - spin0;
+    xSemaphoreGive(s_bench_free_bufs);
+    xSemaphoreGive(s_bench_free_bufs);
+}
+
+static void display_bench_run(const display_t *disp) {
+    size_t buf_px = LCD_H_RES * DISPLAY_MAX_BAND_LINES;
+    uint16_t *bufs[2] = {
+        heap_caps_malloc(buf_px * sizeof(uint16_t), MALLOC_CAP_DMA),
+        heap_caps_malloc(buf_px * sizeof(uint16_t), MALLOC_CAP_DMA),
+    };
+    SemaphoreHandle_t spin_done = xSemaphoreCreateBinary();
+    s_bench_free_bufs = xSemaphoreCreateCounting(2, 2);
+    if (!bufs[0] || !bufs[1] || !spin_done || !s_bench_free_bufs) {
+        ESP_LOGE(TAG, "Display benchmark: no mem");
+        goto out;
+    }
+
+    // Benchmark above the spinner, spinner on the same core. The spinner starves
+    // that core's idle task for the whole sweep: off the task watchdog meanwhile.
+    UBaseType_t prio = uxTaskPriorityGet(NULL);
+    vTaskPrioritySet(NULL, 5);
+    TaskHandle_t idle = xTaskGetIdleTaskHandleForCPU(xPortGetCoreID());
+    bool idle_wdt = esp_task_wdt_status(idle) == ESP_OK;
+    if (idle_wdt) {
+        esp_task_wdt_delete(idle);
+    }
+    s_spin_run = true;
+    xTaskCreatePinnedToCore(bench_spin_task, "bench_spin", 2048, spin_done, 1, NULL, xPortGetCoreID());
+
+    // Spin rate with nothing else to do = 100% idle
+    uint32_t spin0 = s_spin_count;
+    int64_t t0 = esp_timer_get_time();
+    vTaskDelay(pdMS_TO_TICKS(200));
+    double idle_rate = (double)(s_spin_count - spin0) / (double)(esp_timer_get_time() - t0);
+
+    ESP_LOGI(TAG, "Display benchmark: %u ms per workload", BENCH_WORKLOAD_MS);
+    for (size_t p = 0; p < sizeof(k_bench_pclk_hz) / sizeof(k_bench_pclk_hz[0]); p++) {
+        for (size_t q = 0; q < sizeof(k_bench_queue_depth) / sizeof(k_bench_queue_depth[0]); q++) {
+            esp_lcd_panel_io_handle_t io = NULL;
+            esp_lcd_panel_handle_t panel = NULL;
+            if (panel_create(disp, k_bench_pclk_hz[p], k_bench_queue_depth[q], bench_on_color_done, NULL, &io,
+                             &panel) != ESP_OK) {
+                continue;
+            }
+            for (size_t b = 0; b < sizeof(k_bench_band_lines) / sizeof(k_bench_band_lines[0]); b++) {
+                for (size_t w = 0; w < sizeof(k_bench_workloads) / sizeof(k_bench_workloads[0]); w++) {
+                    bench_result_t r;
+                    bench_workload(panel, bufs, k_bench_band_lines[b], &k_bench_workloads[w], &r);
+                    double idle = (idle_rate > 0.0) ? 100.0 * r.spins / (idle_rate * r.elapsed_us) : 0.0;
+                    ESP_LOGI(TAG, "pclk %2u MHz band %2u queue %2u %-8s %6.1f fps %6.2f MB/s idle %3.0f%%",
+                             (unsigned)(k_bench_pclk_hz[p] / 1000000), k_bench_band_lines[b],
+                             k_bench_queue_depth[q], k_bench_workloads[w].name, r.frames * 1e6 / r.elapsed_us,
+                             r.bytes / (double)r.elapsed_us, idle);
+                }
+            }
+            esp_lcd_panel_del(panel);
+            esp_lcd_panel_io_del(io);
+        }
+    }
+
+    s_spin_run = false;
+    xSemaphoreTake(spin_done, portMAX_DELAY);
+    if (idle_wdt) {
+        esp_task_wdt_add(idle);
+    }
+    vTaskPrioritySet(NULL, prio);
+
+out:
+    heap_caps_free(bufs[0]);
+    heap_caps_free(bufs[1]);
+    if (spin_done) {
+        vSemaphoreDelete(spin_done);
+    }
+    if (s_bench_free_bufs) {
+        vSemaphoreDelete(s_bench_free_bufs);
+        s_bench_free_bufs = NULL;
+    }
+}
+#endif
+
+esp_err_t display_init(display_t *disp) {
+
+    ESP_RETURN_ON_FALSE(disp, ESP_ERR_INVALID_ARG, TAG, "display_t pointer is NULL");
+
+    disp->io = NULL;
+    disp->panel = NULL;
+    disp->touch = NULL;
+    disp->touch_io = NULL;
+
+    disp->rotation_swap_xy = true;
+    disp->rotation_mirror_x = false;
+    disp->rotation_mirror_y = false;
+
+    ESP_LOGI(TAG, "Initializing SPI bus");
+    spi_bus_config_t buscfg = {
+        .sclk_io_num = PIN_NUM_CLK,
+        .mosi_io_num = PIN_NUM_MOSI,
+        .miso_io_num = PIN_NUM_MISO,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = LCD_H_RES * DISPLAY_MAX_BAND_LINES * sizeof(uint16_t),
+    };
+    ESP_RETURN_ON_ERROR(spi_bus_initialize(LCD_HOST, &buscfg, 0), TAG, "spi_bus_initialize failed");
 
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_swap_xy(panel_handle, disp->rotation_swap_xy), TAG, "panel swap_xy failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_mirror(panel_handle, disp->rotation_mirror_x, disp->rotation_mirror_y), TAG, "panel mirror failed");
+#if BENCH_DISPLAY
+    enable_backlight();
+    display_bench_run(disp);
+#endif
 
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_invert_color(panel_handle, false), TAG, "invert color failed");
-    ESP_RETURN_ON_ERROR(esp_lcd_panel_disp_on_off(panel_handle, true), TAG, "disp_on_off failed");
+    esp_lcd_panel_io_handle_t io_handle = NULL;
+    esp_lcd_panel_handle_t panel_handle = NULL;
+    ESP_RETURN_ON_ERROR(panel_create(disp, DISPLAY_PCLK_HZ, DISPLAY_TRANS_QUEUE_DEPTH, NULL, NULL, &io_handle,
+                                     &panel_handle), TAG, "panel init failed");
     enable_backlight();
 
 #if DEBUG_DISPLAY
@@ -226,6 +445,59 @@ esp_err_t display_init(display_t *disp) {
     return ESP_OK;
 }
 
+#if DISPLAY_NATIVE_RGB565
+// CPU time the per-flush byte swap would cost for one full screen, i.e. what
+// rendering in the panel's byte order saves (same band size as the draw buffer)
+static void log_swap_savings(void) {
+    const uint32_t band_px = LCD_H_RES * DISPLAY_BAND_LINES;
+    uint16_t *band = heap_caps_malloc(band_px * sizeof(uint16_t), MALLOC_CAP_DMA);
+    if (!band) {
+        return;
+    }
+    memset(band, 0x5A, band_px * sizeof(uint16_t));
+
+    int64_t t0 = esp_timer_get_time();
+    for (int y = 0; y < LCD_V_RES; y += DISPLAY_BAND_LINES) {
+        lv_draw_sw_rgb565_swap(band, band_px);
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+    heap_caps_free(band);
+
+    ESP_LOGI(TAG, "Native RGB565 byte order: %lld us of byte swapping saved per full-screen flush", (long long)dt);
+}
+#endif
+
+// LVGL task
+static void refr_event_cb(lv_event_t *e) {
+    int64_t now = esp_timer_get_time();
+    if (lv_event_get_code(e) == LV_EVENT_REFR_START) {
+        s_refr_start_us = now;
+        return;
+    }
+    if (!s_refr_start_us) {
+        return;
+    }
+    int64_t gap = s_refr_start_us - s_refr_prev_start_us;
+    int64_t late = (s_refr_prev_start_us && gap < REFR_IDLE_GAP_US) ? gap - REFR_PERIOD_US : 0;
+    taskENTER_CRITICAL(&s_refr_lock);
+    orbit_sched_stats_add(&s_refr_stats, late, now - s_refr_start_us, REFR_PERIOD_US);
+    taskEXIT_CRITICAL(&s_refr_lock);
+    s_refr_prev_start_us = s_refr_start_us;
+}
+
+void display_get_refresh_stats(display_refresh_stats_t *out_stats, bool reset) {
+    if (!out_stats) {
+        return;
+    }
+    out_stats->period_us = REFR_PERIOD_US;
+    taskENTER_CRITICAL(&s_refr_lock);
+    out_stats->stats = s_refr_stats;
+    if (reset) {
+        memset(&s_refr_stats, 0, sizeof(s_refr_stats));
+    }
+    taskEXIT_CRITICAL(&s_refr_lock);
+}
+
 esp_err_t display_lvgl_init(display_t *disp) {
     const lvgl_port_cfg_t lvgl_cfg = ESP_LVGL_PORT_INIT_CONFIG();
     ESP_RETURN_ON_ERROR(lvgl_port_init(&lvgl_cfg), TAG, "lvgl_port_init failed");
@@ -234,7 +506,7 @@ esp_err_t display_lvgl_init(display_t *disp) {
 
     disp_cfg.io_handle = disp->io;
     disp_cfg.panel_handle = disp->panel;
-    disp_cfg.buffer_size = LCD_H_RES * 40;
+    disp_cfg.buffer_size = LCD_H_RES * DISPLAY_BAND_LINES;
     disp_cfg.double_buffer = true;
     disp_cfg.hres = LCD_H_RES;
     disp_cfg.vres = LCD_V_RES;
@@ -246,21 +518,32 @@ esp_err_t display_lvgl_init(display_t *disp) {
     disp_cfg.rotation.mirror_y = disp->rotation_mirror_y;
 
     disp_cfg.flags.buff_dma = true;
-    disp_cfg.flags.swap_bytes = true;
+    disp_cfg.flags.swap_bytes = !DISPLAY_NATIVE_RGB565;
 
     s_lv_disp = lvgl_port_add_disp(&disp_cfg);
     ESP_RETURN_ON_FALSE(s_lv_disp, ESP_FAIL, TAG, "lvgl_port_add_disp failed");
 
-    lv_disp_set_default(s_lv_disp);
+#if DISPLAY_NATIVE_RGB565
+    // The port only takes plain RGB565; render straight into the panel's byte order
+    lvgl_port_lock(0);
+    lv_display_set_color_format(s_lv_disp, LV_COLOR_FORMAT_RGB565_SWAPPED);
+    lvgl_port_unlock();
+    log_swap_savings();
+#endif
 
-    if (disp->touch) {
-        lvgl_port_touch_cfg_t touch_cfg = (lvgl_port_touch_cfg_t){0};
-        touch_cfg.disp = s_lv_disp;
-        touch_cfg.handle = disp->touch;
+    lv_disp_set_default(s_lv_disp);
 
-        s_lv_touch = lvgl_port_add_touch(&touch_cfg);
-        ESP_RETURN_ON_FALSE(s_lv_touch, ESP_FAIL, TAG, "lvgl_port_add_touch failed");
-    } else {
+    lvgl_port_lock(0);
+    lv_display_add_event_cb(s_lv_disp, refr_event_cb, LV_EVENT_REFR_START, NULL);
+    lv_display_add_event_cb(s_lv_disp, refr_event_cb, LV_EVENT_REFR_READY, NULL);
+    lvgl_port_unlock();
+
+    // Flushes and touch reads share LCD_HOST: both go through the bus scheduler
+    lvgl_port_lock(0);
+    esp_err_t ret = display_bus_start(disp, s_lv_disp);
+    lvgl_port_unlock();
+    ESP_RETURN_ON_ERROR(ret, TAG, "display_bus_start failed");
+    if (!disp->touch) {
         ESP_LOGW(TAG, "Touch handle is NULL, LVGL will run without touch input");
     }
 
@@ -272,6 +555,22 @@ bool display_poll_touch(display_t *disp, uint16_t *x, uint16_t *y, uint16_t *str
         return false;
     }
 
+    // Once the bus scheduler samples touch, don't put extra reads on the bus
+    uint16_t cx, cy, cs;
+    bool pressed;
+    if (display_bus_read_touch(&cx, &cy, &cs, &pressed)) {
+        if (pressed && x) {
+            *x = cx;
+        }
+        if (pressed && y) {
+            *y = cy;
+        }
+        if (pressed && strength) {
+            *strength = cs;
+        }
+        return pressed;
+    }
+
     esp_err_t ret = esp_lcd_touch_read_data(disp->touch);
     if (ret != ESP_OK) {
         return false;
@@ -0,0 +1,247 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+#include "esp_check.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "esp_lcd_panel_io.h"
+#include "esp_lcd_panel_ops.h"
+#include "esp_lcd_touch.h"
+
+#include "display_priv.h"
+
+static const char *TAG = "display_bus";
+
+// The ST7796 and the XPT2046 share LCD_HOST. Flush bands always go first: touch is
+// sampled when no band is in flight, and only forced in behind the flush once a
+// sample has been deferred for TOUCH_MAX_DEFER_MS (the latency bound).
+#define TOUCH_SAMPLE_MS    20
+#define TOUCH_MAX_DEFER_MS 30
+#define BUS_STATS_LOG_MS   30000
+
+static struct {
+    esp_lcd_panel_handle_t panel;
+    esp_lcd_touch_handle_t touch;
+    lv_display_t *lv_disp;
+    TaskHandle_t touch_task;
+    portMUX_TYPE lock;
+
+    // Flush state, updated from the LVGL task and the DMA done ISR
+    uint32_t lcd_in_flight;
+    int64_t lcd_busy_since;
+    bool touch_waiting; // touch task wants a notification when the bus goes idle
+
+    // Latest touch sample
+    uint16_t x;
+    uint16_t y;
+    uint16_t strength;
+    bool pressed;
+
+    display_bus_stats_t stats;
+    int64_t stats_since;
+} s_bus = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+};
+
+static void dev_account(display_bus_dev_stats_t *dev, int64_t busy_us, int64_t wait_us) {
+    dev->busy_us += busy_us;
+    dev->wait_us += wait_us;
+    dev->max_wait_us = (wait_us > dev->max_wait_us) ? (uint32_t)wait_us : dev->max_wait_us;
+    dev->transactions++;
+}
+
+static bool bus_on_color_done(esp_lcd_panel_io_handle_t io, esp_lcd_panel_io_event_data_t *edata, void *ctx) {
+    int64_t now = esp_timer_get_time();
+    bool notify = false;
+
+    portENTER_CRITICAL_ISR(&s_bus.lock);
+    if (s_bus.lcd_in_flight > 0 && --s_bus.lcd_in_flight == 0) {
+        s_bus.stats.lcd.busy_us += now - s_bus.lcd_busy_since;
+        notify = s_bus.touch_waiting;
+        s_bus.touch_waiting = false;
+    }
+    portEXIT_CRITICAL_ISR(&s_bus.lock);
+
+    lv_display_flush_ready(s_bus.lv_disp);
+
+    BaseType_t woken = pdFALSE;
+    if (notify) {
+        vTaskNotifyGiveFromISR(s_bus.touch_task, &woken);
+    }
+    return woken == pdTRUE;
+}
+
+static void bus_flush_cb(lv_display_t *disp, const lv_area_t *area, uint8_t *px_map) {
+#if !DISPLAY_NATIVE_RGB565
+    lv_draw_sw_rgb565_swap(px_map, lv_area_get_size(area));
+#endif
+    int64_t t0 = esp_timer_get_time();
+    portENTER_CRITICAL(&s_bus.lock);
+    if (s_bus.lcd_in_flight++ == 0) {
+        s_bus.lcd_busy_since = t0;
+    }
+    portEXIT_CRITICAL(&s_bus.lock);
+
+    // Blocks while the queue is full or a touch read holds the bus
+    esp_lcd_panel_draw_bitmap(s_bus.panel, area->x1, area->y1, area->x2 + 1, area->y2 + 1, px_map);
+
+    int64_t wait = esp_timer_get_time() - t0;
+    portENTER_CRITICAL(&s_bus.lock);
+    s_bus.stats.lcd.wait_us += wait;
+    s_bus.stats.lcd.max_wait_us = (wait > s_bus.stats.lcd.max_wait_us) ? (uint32_t)wait : s_bus.stats.lcd.max_wait_us;
+    s_bus.stats.lcd.transactions++;
+    portEXIT_CRITICAL(&s_bus.lock);
+}
+
+static void touch_read_cb(lv_indev_t *indev, lv_indev_data_t *data) {
+    portENTER_CRITICAL(&s_bus.lock);
+    data->point.x = s_bus.x;
+    data->point.y = s_bus.y;
+    data->state = s_bus.pressed ? LV_INDEV_STATE_PRESSED : LV_INDEV_STATE_RELEASED;
+    portEXIT_CRITICAL(&s_bus.lock);
+}
+
+// Wait for a gap between flush bands, at most TOUCH_MAX_DEFER_MS. Returns false
+// when the bound expired with a flush still in flight.
+static bool wait_bus_gap(void) {
+    int64_t deadline = esp_timer_get_time() + TOUCH_MAX_DEFER_MS * 1000LL;
+    while (true) {
+        portENTER_CRITICAL(&s_bus.lock);
+        bool idle = s_bus.lcd_in_flight == 0;
+        s_bus.touch_waiting = !idle;
+        portEXIT_CRITICAL(&s_bus.lock);
+        if (idle) {
+            return true;
+        }
+
+        int64_t left_us = deadline - esp_timer_get_time();
+        if (left_us <= 0) {
+            portENTER_CRITICAL(&s_bus.lock);
+            s_bus.touch_waiting = false;
+            portEXIT_CRITICAL(&s_bus.lock);
+            return false;
+        }
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(left_us / 1000) + 1);
+    }
+}
+
+static void log_stats(void) {
+    display_bus_stats_t st;
+    display_get_bus_stats(&st, true);
+    if (st.window_us <= 0) {
+        return;
+    }
+    ESP_LOGI(TAG, "lcd: busy %.1f%%, %u flushes, wait avg %u us max %u us", 100.0 * st.lcd.busy_us / st.window_us,
+             (unsigned)st.lcd.transactions,
+             (unsigned)(st.lcd.transactions ? st.lcd.wait_us / st.lcd.transactions : 0), (unsigned)st.lcd.max_wait_us);
+    ESP_LOGI(TAG, "touch: busy %.1f%%, %u reads (%u deferred, %u forced), wait avg %u us max %u us",
+             100.0 * st.touch.busy_us / st.window_us, (unsigned)st.touch.transactions, (unsigned)st.touch_deferred,
+             (unsigned)st.touch_forced,
+             (unsigned)(st.touch.transactions ? st.touch.wait_us / st.touch.transactions : 0),
+             (unsigned)st.touch.max_wait_us);
+}
+
+static void touch_task(void *arg) {
+    TickType_t last_wake = xTaskGetTickCount();
+    int64_t last_log = esp_timer_get_time();
+
+    while (true) {
+        vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(TOUCH_SAMPLE_MS));
+
+        int64_t due = esp_timer_get_time();
+        bool gap = wait_bus_gap();
+        int64_t t0 = esp_timer_get_time();
+
+        esp_lcd_touch_point_data_t point = {0};
+        uint8_t count = 0;
+        bool ok = esp_lcd_touch_read_data(s_bus.touch) == ESP_OK &&
+                  esp_lcd_touch_get_data(s_bus.touch, &point, &count, 1) == ESP_OK;
+        int64_t t1 = esp_timer_get_time();
+
+        portENTER_CRITICAL(&s_bus.lock);
+        if (ok) {
+            s_bus.pressed = count > 0;
+            if (count > 0) {
+                s_bus.x = point.x;
+                s_bus.y = point.y;
+                s_bus.strength = point.strength;
+            }
+        }
+        dev_account(&s_bus.stats.touch, t1 - t0, t0 - due);
+        s_bus.stats.touch_deferred += (t0 - due) > 100;
+        s_bus.stats.touch_forced += !gap;
+        portEXIT_CRITICAL(&s_bus.lock);
+
+        if (t1 - last_log >= BUS_STATS_LOG_MS * 1000LL) {
+            last_log = t1;
+            log_stats();
+        }
+    }
+}
+
+esp_err_t display_bus_start(display_t *disp, lv_display_t *lv_disp) {
+    ESP_RETURN_ON_FALSE(disp && disp->panel && lv_disp, ESP_ERR_INVALID_ARG, TAG, "invalid args");
+
+    s_bus.panel = disp->panel;
+    s_bus.touch = disp->touch;
+    s_bus.lv_disp = lv_disp;
+    s_bus.stats_since = esp_timer_get_time();
+
+    const esp_lcd_panel_io_callbacks_t cbs = {
+        .on_color_trans_done = bus_on_color_done,
+    };
+    ESP_RETURN_ON_ERROR(esp_lcd_panel_io_register_event_callbacks(disp->io, &cbs, NULL), TAG,
+                        "register io callbacks failed");
+    lv_display_set_flush_cb(lv_disp, bus_flush_cb);
+
+    if (!disp->touch) {
+        return ESP_OK;
+    }
+    BaseType_t ok = xTaskCreate(touch_task, "touch", 3072, NULL, 5, &s_bus.touch_task);
+    ESP_RETURN_ON_FALSE(ok == pdPASS, ESP_ERR_NO_MEM, TAG, "touch task create failed");
+
+    lv_indev_t *indev = lv_indev_create();
+    ESP_RETURN_ON_FALSE(indev, ESP_ERR_NO_MEM, TAG, "lv_indev_create failed");
+    lv_indev_set_type(indev, LV_INDEV_TYPE_POINTER);
+    lv_indev_set_read_cb(indev, touch_read_cb);
+    lv_indev_set_display(indev, lv_disp);
+    return ESP_OK;
+}
+
+bool display_bus_read_touch(uint16_t *x, uint16_t *y, uint16_t *strength, bool *pressed) {
+    if (!s_bus.touch_task) {
+        return false;
+    }
+    portENTER_CRITICAL(&s_bus.lock);
+    *x = s_bus.x;
+    *y = s_bus.y;
+    *strength = s_bus.strength;
+    *pressed = s_bus.pressed;
+    portEXIT_CRITICAL(&s_bus.lock);
+    return true;
+}
+
+void display_get_bus_stats(display_bus_stats_t *out_stats, bool reset) {
+    if (!out_stats) {
+        return;
+    }
+    int64_t now = esp_timer_get_time();
+    portENTER_CRITICAL(&s_bus.lock);
+    *out_stats = s_bus.stats;
+    // Count the running flush up to now
+    if (s_bus.lcd_in_flight > 0) {
+        out_stats->lcd.busy_us += now - s_bus.lcd_busy_since;
+    }
+    out_stats->window_us = now - s_bus.stats_since;
+    if (reset) {
+        memset(&s_bus.stats, 0, sizeof(s_bus.stats));
+        s_bus.stats_since = now;
+        if (s_bus.lcd_in_flight > 0) {
+            s_bus.lcd_busy_since = now;
+        }
+    }
+    portEXIT_CRITICAL(&s_bus.lock);
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "esp_err.h"
+#include "lvgl.h"
+
+#include "display.h"
+
+// Shared LCD_HOST scheduling (display_bus.c): takes over the LVGL flush callback
+// and the panel IO done event, and replaces the port's touch indev with one that
+// reads samples taken in the gaps between flush bands.
+esp_err_t display_bus_start(display_t *disp, lv_display_t *lv_disp);
+
+// Latest touch sample; false when the scheduler isn't running
+bool display_bus_read_touch(uint16_t *x, uint16_t *y, uint16_t *strength, bool *pressed);
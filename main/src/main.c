@@ -1,10 +1,14 @@
 #include <dirent.h>
 #include <errno.h>
+#include <math.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <sys/stat.h>
 
 #include "freertos/FreeRTOS.h"
+#include "freertos/queue.h"
 #include "freertos/task.h"
 
 #include "driver/gpio.h"
@@ -12,6 +16,7 @@
 #include "driver/spi_master.h"
 
 #include "esp_log.h"
+#include "esp_system.h"
 #include "esp_timer.h"
 #include "esp_vfs_fat.h"
 
@@ -24,14 +29,1119 @@
 #include "esp_lcd_touch.h"
 #include "esp_lcd_touch_xpt2046.h"
 
+#include "esp_lvgl_port.h"
+
 #include "board_pins.h"
 #include "display.h"
 #include "orbit.h"
+#include "orbit_catalog.h"
+#include "orbit_conj.h"
+#include "orbit_coverage.h"
+#include "orbit_doppler.h"
+#include "orbit_ephem.h"
+#include "orbit_observer.h"
+#include "orbit_pass.h"
+#include "orbit_plan.h"
+#include "orbit_prefilter.h"
+#include "orbit_proj.h"
+#include "orbit_sched.h"
+#include "orbit_sun.h"
 #include "sdcard.h"
+#include "telemetry.h"
+#include "timebase.h"
 #include "ui.h"
 
 static const char *TAG = "main";
 
+#define CATALOG_TLE_PATH MOUNT_POINT "/TLE.TXT"
+#define CATALOG_POLL_MS  10000
+#define CATALOG_WARMUP_US 20000 // lazy SGP4 init per main loop pass
+#define EPHEM_PATH       MOUNT_POINT "/EPHEM.BIN"
+
+// Ground stations; the first one drives the sky plot and the list
+static const struct {
+    double lat_deg;
+    double lon_deg;
+    double alt_km;
+    float min_el_deg;
+} k_stations[] = {
+    {-34.90, -56.16, 0.04, 0.0f}, // Montevideo
+};
+#define N_STATIONS (sizeof(k_stations) / sizeof(k_stations[0]))
+
+#define SKY_TICK_MS             1000
+#define LOOK_TICK_MS            2000
+#define PASS_WINDOW_S           (24 * 3600)
+#define PREFILTER_PERIOD_S      3600
+#define PASS_PREDICT_PER_TICK   2
+#define PREFILTER_BENCH_SAMPLES 2
+#define MAP_FULL_EVERY_TICKS    5
+#define COVERAGE_WINDOW_S       (24 * 3600)
+#define SUN_DARK_EL_DEG         (-6.0f) // civil dusk: sunlit satellites stand out
+#define DOPPLER_DOWNLINK_HZ     437000000 // 70 cm amateur satellite band (LUR-1 and most cubesats)
+// ORBIT_PROJ_AZEQ: azimuthal equidistant map centered on the first station
+#define MAP_PROJECTION ORBIT_PROJ_EQUIRECT
+
+// Simulation: sky and look ticks every SIM_FRAME_MS. Up to SIM_KNOT_MAX_S of
+// simulated time per SIM_KNOT_FRAMES frames the catalog is propagated at knots
+// and the frames in between are interpolated; faster rates propagate every frame,
+// prefiltered candidates only (full catalog every MAP_FULL_EVERY_TICKS frames).
+#define SIM_FRAME_MS     200
+#define SIM_KNOT_FRAMES  4
+#define SIM_KNOT_MIN_S   60
+#define SIM_KNOT_MAX_S   600
+#define SIM_STATS_LOG_MS 10000
+
+// Close-approach screening: one coarse step of the screener every CONJ_STEP_MS, a
+// new screen from the current time every CONJ_PERIOD_S (or after catalog changes)
+#define CONJ_STEP_MS  1000
+#define CONJ_PERIOD_S 3600
+
+// Antenna plan: the "plan" task collects the passes of every candidate over the
+// next PLAN_WINDOW_S, PLAN_BUDGET_US per run (searches in PLAN_CHUNK_S pieces),
+// then orbit_plan_solve() picks the ones the rotator tracks. Collected again every
+// PLAN_PERIOD_S and after catalog or time changes; a sky plot change only re-solves.
+// PLAN_MAX_PASSES is a day above PLAN_MIN_EL_DEG for about 750 LEO satellites
+// (~5.4 each), 28 bytes per pass plus 12 while solving; past that a full list
+// keeps the highest priority, then weight, passes (plan_add()).
+#define PLAN_TICK_MS    100
+#define PLAN_BUDGET_US  10000
+#define PLAN_WINDOW_S   PASS_WINDOW_S
+#define PLAN_CHUNK_S    (2 * 3600)
+#define PLAN_PERIOD_S   3600
+#define PLAN_MAX_PASSES 4096
+#define PLAN_MIN_EL_DEG 5.0f // lower culminations aren't worth the antenna time
+#define PLAN_PRIO_LUR1  4.0f
+#define PLAN_PRIO_SKY   2.0f // satellites on the sky plot
+
+// Main loop: periodic tasks with deadlines, released by orbit_sched; the loop
+// sleeps on an esp_timer until the next release instead of FreeRTOS ticks.
+// LOOP_POLL_MS covers input, telemetry and the SGP4 warm-up.
+#define LOOP_POLL_MS  30
+#define SCHED_LOG_MS  60000
+#define LUR1_NORAD_ID           60506
+
+// Satellites shown on the sky plot, one per slot, with the pass whose arc and
+// Doppler curve are cached
+typedef struct {
+    uint32_t norad_id; // 0 = free slot
+    orbit_pass_t pass;
+    bool has_pass;
+    int64_t no_pass_before; // last search found nothing up to this time
+    bool has_doppler;
+    orbit_doppler_t doppler;
+} sky_track_t;
+
+static orbit_station_t s_stations[N_STATIONS];
+static sky_track_t s_sky[UI_SKYPLOT_SLOTS];
+
+// Catalog-wide state of the last look tick, index = catalog index
+static orbit_soa_t s_soa;
+static orbit_look_t *s_looks = NULL; // [sat][station]
+static uint8_t *s_visible = NULL;    // [sat][station]
+static float *s_sub_lat = NULL;
+static float *s_sub_lon = NULL;
+static int16_t *s_map_x = NULL; // marker positions on the map projection
+static int16_t *s_map_y = NULL;
+static orbit_proj_t *s_proj = NULL;
+static uint8_t *s_illum = NULL;
+static float *s_mag = NULL; // from station 0, ORBIT_MAG_NONE unless optically visible
+static orbit_sun_t s_sun;
+static size_t s_look_cap = 0;
+static size_t s_look_count = 0;
+
+// Element-based visibility prefilter and the next AOS of each candidate (0 = not yet
+// predicted, -1 = no pass in the window)
+static uint8_t *s_candidate = NULL;
+static int64_t *s_next_aos = NULL;
+static bool s_prefilter_due = true;
+static bool s_candidate_valid = false; // prefiltered since the last catalog load
+static bool s_prefilter_bench_due = true;
+static int64_t s_prefilter_time = 0;
+static size_t s_pass_cursor = 0;
+static uint32_t s_look_ticks = 0;
+static orbit_coverage_t *s_coverage = NULL;
+static int64_t s_last_pass_step_us = 0;
+static int64_t s_last_look_now = 0;
+
+// Simulation knots: s_knots[0] <= now <= s_knots[1], s_knot_s apart (0 = none)
+static orbit_soa_t s_knots[2];
+static int64_t s_knot_s = 0;
+static struct {
+    uint32_t frames;
+    uint32_t knots;
+    int64_t frame_us;
+    int64_t max_frame_us;
+} s_sim_stats;
+static orbit_conj_t *s_conj = NULL;
+static bool s_conj_due = true;
+// Catalog entries still waiting for their lazy SGP4 init
+static size_t s_warmup_pending = 0;
+static QueueHandle_t s_select_queue = NULL;
+static bool s_catalog_updating = false; // set under the LVGL lock around a reload
+static orbit_sched_t *s_sched = NULL;
+static esp_timer_handle_t s_loop_timer = NULL;
+static TaskHandle_t s_loop_task = NULL;
+static int s_task_poll = -1;
+static int s_task_sky = -1;
+static int s_task_look = -1;
+
+// Passes are sorted by LOS after a solve; selected holds the tracked ones' indices
+static struct {
+    orbit_plan_pass_t *passes;
+    uint32_t *selected;
+    size_t n;
+    size_t n_selected;
+    size_t cap;
+    int64_t start; // window start, origin of the pass times
+    size_t cursor; // catalog index being searched
+    int64_t t;     // its search time
+    bool collecting;
+    bool due;         // collect again
+    bool resolve_due; // priorities changed
+    bool truncated;
+    int64_t collect_us;
+    int64_t now_min; // of the timeline's now marker
+} s_plan;
+
+// Markers follow the catalog entries; the entry keeps the marker across TLE refreshes
+static void catalog_on_added(orbit_catalog_entry_t *entry, void *ctx) {
+    entry->user_data = ui_sat_marker_create(entry->norad_id, entry->name);
+}
+
+// New elements invalidate the cached pass arc
+static void catalog_on_changed(orbit_catalog_entry_t *entry, void *ctx) {
+    for (int i = 0; i < UI_SKYPLOT_SLOTS; i++) {
+        if (s_sky[i].norad_id == entry->norad_id) {
+            s_sky[i].has_pass = false;
+            s_sky[i].no_pass_before = 0;
+        }
+    }
+}
+
+static void catalog_on_removed(orbit_catalog_entry_t *entry, void *ctx) {
+    ui_sat_marker_destroy((ui_sat_marker_t *)entry->user_data);
+    entry->user_data = NULL;
+}
+
+// Satellite list rows are read straight from the catalog (LVGL lock held)
+static bool sat_list_row_cb(size_t index, ui_sat_row_t *row, void *ctx) {
+    if (s_catalog_updating) {
+        return false;
+    }
+    orbit_catalog_entry_t *entry = orbit_catalog_at((orbit_catalog_t *)ctx, index);
+    if (!entry) {
+        return false;
+    }
+    strlcpy(row->name, entry->name, sizeof(row->name));
+    row->has_elevation = index < s_look_count && s_visible[index * N_STATIONS];
+    row->elevation_deg = row->has_elevation ? s_looks[index * N_STATIONS].el_deg : 0.0f;
+    row->next_pass_unix = (index < s_look_count && s_next_aos[index] > 0) ? s_next_aos[index] : 0;
+    row->has_illum = index < s_look_count;
+    row->sunlit = row->has_illum && s_illum[index] >= (ORBIT_ILLUM_FULL + 1) / 2;
+    row->has_magnitude = row->has_illum && s_mag[index] < ORBIT_MAG_NONE;
+    row->magnitude = row->has_magnitude ? s_mag[index] : 0.0f;
+    return true;
+}
+
+// Runs in the LVGL task: hand the NORAD ID over to the main loop
+static void sat_list_select_cb(size_t index, void *ctx) {
+    if (s_catalog_updating) {
+        return;
+    }
+    orbit_catalog_entry_t *entry = orbit_catalog_at((orbit_catalog_t *)ctx, index);
+    if (entry) {
+        xQueueSend(s_select_queue, &entry->norad_id, 0);
+        xTaskNotifyGive(s_loop_task);
+    }
+}
+
+// Limit the binary position stream to the sky plot satellites (antenna rotator)
+static void sky_stream_tracked(void) {
+    uint32_t ids[UI_SKYPLOT_SLOTS];
+    size_t n = 0;
+    for (int i = 0; i < UI_SKYPLOT_SLOTS; i++) {
+        if (s_sky[i].norad_id != 0) {
+            ids[n++] = s_sky[i].norad_id;
+        }
+    }
+    telemetry_set_subset(ids, n);
+}
+
+// Tapping a listed satellite toggles it on the sky plot (oldest slot is replaced when full)
+static void sky_toggle(uint32_t norad_id) {
+    static int s_next_slot = 0;
+
+    for (int i = 0; i < UI_SKYPLOT_SLOTS; i++) {
+        if (s_sky[i].norad_id == norad_id) {
+            s_sky[i].norad_id = 0;
+            ui_skyplot_clear(i);
+            sky_stream_tracked();
+            s_plan.resolve_due = true;
+            return;
+        }
+    }
+
+    int slot = -1;
+    for (int i = 0; i < UI_SKYPLOT_SLOTS && slot < 0; i++) {
+        if (s_sky[i].norad_id == 0) {
+            slot = i;
+        }
+    }
+    if (slot < 0) {
+        slot = s_next_slot;
+        s_next_slot = (s_next_slot + 1) % UI_SKYPLOT_SLOTS;
+    }
+    s_sky[slot].norad_id = norad_id;
+    s_sky[slot].has_pass = false;
+    s_sky[slot].no_pass_before = 0;
+    sky_stream_tracked();
+    s_plan.resolve_due = true;
+    // A full pass list may have evicted its passes at the old priority
+    s_plan.due |= s_plan.truncated;
+}
+
+// Sub-satellite point and altitude for the footprint overlay
+static bool footprint_of(orbit_sat_t *sat, int64_t now, ui_footprint_t *out_fp) {
+    orbit_eci_t teme, ecef;
+    if (orbit_sat_propagate_unix(sat, now, &teme) != ESP_OK) {
+        return false;
+    }
+    orbit_geodetic_t geo;
+    orbit_teme_to_ecef(&teme, orbit_gmst_rad((double)now), &ecef);
+    orbit_ecef_to_geodetic(&ecef, &geo);
+    out_fp->lat_deg = (float)geo.lat_deg;
+    out_fp->lon_deg = (float)geo.lon_deg;
+    out_fp->alt_km = (float)geo.alt_km;
+    return true;
+}
+
+// Pass arcs are computed and projected once per pass; every tick only the live
+// look angles are evaluated. Tracked satellites also get their footprint on the map.
+static void sky_tick(orbit_catalog_t *catalog, int64_t now) {
+    ui_footprint_t fps[UI_SKYPLOT_SLOTS];
+    size_t n_fps = 0;
+
+    for (int i = 0; i < UI_SKYPLOT_SLOTS; i++) {
+        sky_track_t *trk = &s_sky[i];
+        if (trk->norad_id == 0) {
+            continue;
+        }
+        orbit_catalog_entry_t *entry = orbit_catalog_find(catalog, trk->norad_id);
+        if (!entry) {
+            trk->norad_id = 0;
+            ui_skyplot_clear(i);
+            continue;
+        }
+        orbit_sat_t *sat = orbit_catalog_entry_sat(entry);
+        if (!sat) {
+            trk->norad_id = 0;
+            ui_skyplot_clear(i);
+            continue;
+        }
+        n_fps += footprint_of(sat, now, &fps[n_fps]);
+
+        // Without a pass in the window the search waits for the window's end
+        if ((!trk->has_pass || now > trk->pass.los_unix) && now >= trk->no_pass_before) {
+            orbit_look_t arc[UI_SKYPLOT_ARC_POINTS];
+            ui_azel_t azel[UI_SKYPLOT_ARC_POINTS];
+
+            trk->has_pass =
+                orbit_pass_find(sat, &s_stations[0], now, PASS_WINDOW_S, &trk->pass) == ESP_OK &&
+                orbit_pass_sample(sat, &s_stations[0], &trk->pass, arc, UI_SKYPLOT_ARC_POINTS) == ESP_OK;
+            if (!trk->has_pass) {
+                trk->no_pass_before = now + PASS_WINDOW_S;
+                ui_skyplot_clear(i);
+                continue;
+            }
+            for (int k = 0; k < UI_SKYPLOT_ARC_POINTS; k++) {
+                azel[k].az_deg = arc[k].az_deg;
+                azel[k].el_deg = arc[k].el_deg;
+            }
+            ui_skyplot_set_pass(i, entry->name, azel, UI_SKYPLOT_ARC_POINTS, trk->pass.aos_unix, trk->pass.los_unix,
+                                trk->pass.max_el_deg);
+            trk->has_doppler = orbit_doppler_build(sat, &s_stations[0], &trk->pass, DOPPLER_DOWNLINK_HZ,
+                                                   ORBIT_DOPPLER_STEP_S, &trk->doppler) == ESP_OK;
+        }
+        if (!trk->has_pass) {
+            continue;
+        }
+
+        // Table lookup during the pass, no SGP4
+        int32_t shift_hz = 0;
+        bool in_pass = trk->has_doppler && orbit_doppler_lookup(&trk->doppler, (double)now, &shift_hz);
+        ui_skyplot_set_doppler(i, in_pass, shift_hz);
+
+        orbit_look_t look;
+        if (orbit_station_look_sat(&s_stations[0], sat, now, &look) == ESP_OK) {
+            ui_skyplot_set_marker(i, look.az_deg, look.el_deg);
+        }
+    }
+    ui_footprint_update(fps, n_fps, k_stations[0].min_el_deg);
+}
+
+static bool look_buffers_reserve(size_t n) {
+    if (n <= s_look_cap) {
+        return true;
+    }
+    orbit_look_t *looks = realloc(s_looks, n * N_STATIONS * sizeof(*looks));
+    uint8_t *visible = realloc(s_visible, n * N_STATIONS);
+    float *lat = realloc(s_sub_lat, n * sizeof(float));
+    float *lon = realloc(s_sub_lon, n * sizeof(float));
+    uint8_t *cand = realloc(s_candidate, n);
+    int64_t *aos = realloc(s_next_aos, n * sizeof(int64_t));
+    uint8_t *illum = realloc(s_illum, n);
+    float *mag = realloc(s_mag, n * sizeof(float));
+    int16_t *map_x = realloc(s_map_x, n * sizeof(int16_t));
+    int16_t *map_y = realloc(s_map_y, n * sizeof(int16_t));
+    s_looks = looks ? looks : s_looks;
+    s_visible = visible ? visible : s_visible;
+    s_sub_lat = lat ? lat : s_sub_lat;
+    s_sub_lon = lon ? lon : s_sub_lon;
+    s_candidate = cand ? cand : s_candidate;
+    s_next_aos = aos ? aos : s_next_aos;
+    s_illum = illum ? illum : s_illum;
+    s_mag = mag ? mag : s_mag;
+    s_map_x = map_x ? map_x : s_map_x;
+    s_map_y = map_y ? map_y : s_map_y;
+    if (!looks || !visible || !lat || !lon || !cand || !aos || !illum || !mag || !map_x || !map_y) {
+        ESP_LOGE(TAG, "No mem for look angles of %u satellites", (unsigned)n);
+        return false;
+    }
+    // Entries skipped by masked ticks keep their illumination: start them sunlit
+    memset(s_illum + s_look_cap, ORBIT_ILLUM_FULL, n - s_look_cap);
+    s_look_cap = n;
+    return true;
+}
+
+// Sub-satellite points of the tick to map pixels, the whole catalog in one call
+static void map_project(size_t n) {
+    orbit_proj_forward_batch(s_proj, s_sub_lat, s_sub_lon, s_soa.valid, n, s_map_x, s_map_y);
+}
+
+static void map_marker_place(ui_sat_marker_t *marker, size_t i) {
+    ui_sat_marker_set_pos(marker, s_map_x[i], s_map_y[i]);
+}
+
+// Time pass searches for a few catalog entries with the given prefilter verdict
+static int64_t pass_search_cost_us(orbit_catalog_t *catalog, int64_t now, uint8_t candidate, size_t *out_samples) {
+    orbit_pass_t pass;
+    size_t samples = 0;
+    int64_t t0 = esp_timer_get_time();
+    for (size_t i = 0; i < orbit_catalog_count(catalog) && samples < PREFILTER_BENCH_SAMPLES; i++) {
+        if (s_candidate[i] == candidate) {
+            orbit_sat_t *sat = orbit_catalog_entry_sat(orbit_catalog_at(catalog, i));
+            orbit_pass_find(sat, &s_stations[0], now, PASS_WINDOW_S, &pass);
+            samples++;
+        }
+    }
+    *out_samples = samples;
+    return samples ? (esp_timer_get_time() - t0) / (int64_t)samples : 0;
+}
+
+// What the prefilter buys: one unfiltered vs one filtered look update, and the
+// measured per-satellite pass search cost of kept vs pruned entries. The looks go
+// to scratch buffers, so the list keeps reading its own without the LVGL lock;
+// s_soa is only used by this task and redone by the look tick anyway.
+static void prefilter_bench(orbit_catalog_t *catalog, int64_t now, const orbit_prefilter_stats_t *st) {
+    size_t n = orbit_catalog_count(catalog), n_vis;
+    orbit_look_t *looks = malloc(n * N_STATIONS * sizeof(*looks));
+    uint8_t *visible = malloc(n * N_STATIONS);
+    if (!looks || !visible) {
+        ESP_LOGW(TAG, "No mem to benchmark the prefilter on %u satellites", (unsigned)n);
+        free(looks);
+        free(visible);
+        return;
+    }
+    int64_t t0 = esp_timer_get_time();
+    orbit_catalog_propagate_soa(catalog, now, NULL, &s_soa);
+    orbit_look_batch(s_stations, N_STATIONS, &s_soa, true, looks, visible, &n_vis);
+    int64_t t1 = esp_timer_get_time();
+    orbit_catalog_propagate_soa(catalog, now, s_candidate, &s_soa);
+    orbit_look_batch(s_stations, N_STATIONS, &s_soa, true, looks, visible, &n_vis);
+    int64_t t2 = esp_timer_get_time();
+    free(looks);
+    free(visible);
+    ESP_LOGI(TAG, "Look update: %lld us full, %lld us prefiltered (%.1fx)", (long long)(t1 - t0),
+             (long long)(t2 - t1), (t2 > t1) ? (double)(t1 - t0) / (double)(t2 - t1) : 0.0);
+
+    size_t n_kept, n_pruned;
+    int64_t kept_us = pass_search_cost_us(catalog, now, 1, &n_kept);
+    int64_t pruned_us = pass_search_cost_us(catalog, now, 0, &n_pruned);
+    if (n_kept && n_pruned) {
+        double full = (double)kept_us * st->kept + (double)pruned_us * (st->total - st->kept);
+        ESP_LOGI(TAG, "Pass prediction: %lld ms/sat kept, %lld ms/sat pruned, sweep %.1f s -> %.1f s (%.1fx)",
+                 (long long)(kept_us / 1000), (long long)(pruned_us / 1000), full / 1e6,
+                 (double)kept_us * st->kept / 1e6, full / ((double)kept_us * st->kept));
+    }
+}
+
+static void prefilter_refresh(orbit_catalog_t *catalog, int64_t now) {
+    orbit_prefilter_stats_t st;
+    // The window covers the pass horizon until the next refresh
+    if (orbit_prefilter_catalog(catalog, s_stations, N_STATIONS, now, PASS_WINDOW_S + PREFILTER_PERIOD_S,
+                                s_candidate, &st) != ESP_OK) {
+        return;
+    }
+    lvgl_port_lock(0);
+    memset(s_next_aos, 0, st.total * sizeof(int64_t));
+    lvgl_port_unlock();
+
+    ESP_LOGI(TAG, "Prefilter: pruned %u of %u (%.1f%%: latitude %u, longitude %u, decayed %u) in %lld us",
+             (unsigned)(st.total - st.kept), (unsigned)st.total,
+             st.total ? 100.0 * (double)(st.total - st.kept) / (double)st.total : 0.0, (unsigned)st.pruned_latitude,
+             (unsigned)st.pruned_longitude, (unsigned)st.pruned_decayed, (long long)st.elapsed_us);
+
+    if (s_prefilter_bench_due && s_warmup_pending == 0) {
+        s_prefilter_bench_due = false;
+        prefilter_bench(catalog, now, &st);
+    }
+    s_prefilter_due = false;
+    s_candidate_valid = true;
+    s_prefilter_time = now;
+}
+
+// Fold the states of a full propagation into the coverage heatmap, once a minute
+static void coverage_sample(int64_t now) {
+    if (!orbit_coverage_due(s_coverage, now)) {
+        return;
+    }
+    int64_t t0 = esp_timer_get_time();
+    if (orbit_coverage_add(s_coverage, &s_soa, s_sub_lat, s_sub_lon) != ESP_OK) {
+        return;
+    }
+    ui_coverage_update(orbit_coverage_minutes(s_coverage), ORBIT_COVERAGE_W, ORBIT_COVERAGE_H);
+    ESP_LOGD(TAG, "Coverage sample of %u sats in %lld us", (unsigned)s_soa.count,
+             (long long)(esp_timer_get_time() - t0));
+}
+
+// Predict the next AOS of a few candidates per tick, round robin over the catalog
+static void next_pass_step(orbit_catalog_t *catalog, size_t n, int64_t now) {
+    for (size_t done = 0, scanned = 0; done < PASS_PREDICT_PER_TICK && scanned < n; scanned++) {
+        size_t i = s_pass_cursor;
+        s_pass_cursor = (s_pass_cursor + 1) % n;
+        if (!s_candidate[i] || (s_next_aos[i] != 0 && (s_next_aos[i] < 0 || s_next_aos[i] > now))) {
+            continue;
+        }
+        orbit_pass_t pass;
+        orbit_sat_t *sat = orbit_catalog_entry_sat(orbit_catalog_at(catalog, i));
+        esp_err_t ret = orbit_pass_find(sat, &s_stations[0], now, PASS_WINDOW_S, &pass);
+        lvgl_port_lock(0);
+        s_next_aos[i] = (ret == ESP_OK) ? pass.aos_unix : -1;
+        lvgl_port_unlock();
+        done++;
+    }
+}
+
+static float plan_priority(uint32_t norad_id) {
+    if (norad_id == LUR1_NORAD_ID) {
+        return PLAN_PRIO_LUR1;
+    }
+    for (int i = 0; i < UI_SKYPLOT_SLOTS; i++) {
+        if (s_sky[i].norad_id == norad_id) {
+            return PLAN_PRIO_SKY;
+        }
+    }
+    return 1.0f;
+}
+
+static bool plan_reserve(size_t n) {
+    if (n <= s_plan.cap) {
+        return true;
+    }
+    size_t cap = s_plan.cap ? s_plan.cap * 2 : 128;
+    cap = (cap > PLAN_MAX_PASSES) ? PLAN_MAX_PASSES : cap;
+    if (n > cap) {
+        return false;
+    }
+    orbit_plan_pass_t *passes = realloc(s_plan.passes, cap * sizeof(*passes));
+    uint32_t *selected = realloc(s_plan.selected, cap * sizeof(*selected));
+    s_plan.passes = passes ? passes : s_plan.passes;
+    s_plan.selected = selected ? selected : s_plan.selected;
+    if (!passes || !selected) {
+        ESP_LOGE(TAG, "No mem for %u planned passes", (unsigned)cap);
+        return false;
+    }
+    s_plan.cap = cap;
+    return true;
+}
+
+// Weight = priority x duration: the plan maximizes the prioritized tracking time
+static float plan_weight(const orbit_plan_pass_t *p) {
+    return plan_priority(p->norad_id) * (float)(p->los_s - p->aos_s);
+}
+
+// Priority first, so LUR-1 and sky plot passes are never evicted for others
+static bool plan_outweighs(const orbit_plan_pass_t *a, const orbit_plan_pass_t *b) {
+    float pa = plan_priority(a->norad_id), pb = plan_priority(b->norad_id);
+    return (pa != pb) ? pa > pb : a->weight > b->weight;
+}
+
+// Once the list is full, a pass replaces the lowest one if it outweighs it, so the
+// passes kept don't depend on the catalog order
+static void plan_add(uint32_t norad_id, const orbit_pass_t *pass) {
+    orbit_plan_pass_t p;
+    orbit_plan_pass_init(&p, norad_id, s_plan.start, pass->aos_unix, pass->los_unix, pass->aos_az_deg,
+                         pass->los_az_deg, pass->max_el_deg);
+    p.weight = plan_weight(&p);
+    if (plan_reserve(s_plan.n + 1)) {
+        s_plan.passes[s_plan.n++] = p;
+        return;
+    }
+    s_plan.truncated = true;
+    size_t lowest = 0;
+    for (size_t i = 1; i < s_plan.n; i++) {
+        lowest = plan_outweighs(&s_plan.passes[lowest], &s_plan.passes[i]) ? i : lowest;
+    }
+    if (s_plan.n > 0 && plan_outweighs(&p, &s_plan.passes[lowest])) {
+        s_plan.passes[lowest] = p;
+    }
+}
+
+static int cmp_u32(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a, y = *(const uint32_t *)b;
+    return (x > y) - (x < y);
+}
+
+// Timeline rows, in LOS order (LVGL lock held)
+static bool plan_pass_cb(size_t index, ui_plan_pass_t *out, void *ctx) {
+    if (index >= s_plan.n) {
+        return false;
+    }
+    const orbit_plan_pass_t *p = &s_plan.passes[index];
+    uint32_t key = (uint32_t)index;
+    out->aos_unix = s_plan.start + p->aos_s;
+    out->los_unix = s_plan.start + p->los_s;
+    out->max_el_deg = p->max_el_deg;
+    out->priority = plan_priority(p->norad_id) > 1.0f;
+    out->tracked = bsearch(&key, s_plan.selected, s_plan.n_selected, sizeof(key), cmp_u32) != NULL;
+    out->name[0] = '\0';
+    if (out->tracked) {
+        orbit_catalog_entry_t *entry = orbit_catalog_find((orbit_catalog_t *)ctx, p->norad_id);
+        strlcpy(out->name, entry ? entry->name : "?", sizeof(out->name));
+    }
+    return true;
+}
+
+// Weights again: the sky plot selection may have changed since the collection
+static void plan_solve(orbit_catalog_t *catalog) {
+    for (size_t i = 0; i < s_plan.n; i++) {
+        s_plan.passes[i].weight = plan_weight(&s_plan.passes[i]);
+    }
+    const orbit_plan_rotator_t rot = ORBIT_PLAN_ROTATOR_DEFAULT();
+    orbit_plan_stats_t st;
+    if (orbit_plan_solve(s_plan.passes, s_plan.n, &rot, s_plan.selected, &s_plan.n_selected, &st) != ESP_OK) {
+        s_plan.n_selected = 0;
+        return;
+    }
+    s_plan.resolve_due = false;
+    s_plan.now_min = 0; // the marker on the new window
+    ESP_LOGI(TAG, "Antenna plan: %u of %u passes, %.1f h tracked, %.0f%% of the weight, %u slew checks, %lld us",
+             (unsigned)st.n_selected, (unsigned)st.n_passes, st.tracked_s / 3600.0,
+             st.value_all > 0.0f ? 100.0 * st.value / st.value_all : 0.0, (unsigned)st.slew_checks,
+             (long long)st.elapsed_us);
+    ui_timeline_set_plan(s_plan.start, s_plan.start + PLAN_WINDOW_S, s_plan.n, plan_pass_cb, catalog);
+}
+
+// One budget of pass searches; the plan is solved once every candidate is done
+static void plan_step(orbit_catalog_t *catalog, int64_t now) {
+    if (now / 60 != s_plan.now_min) {
+        s_plan.now_min = now / 60;
+        ui_timeline_set_now(now);
+    }
+    size_t n = orbit_catalog_count(catalog);
+    // Candidates come from the prefilter of the look tick
+    if (n == 0 || s_look_count != n) {
+        return;
+    }
+    if (s_plan.due || (!s_plan.collecting && (now < s_plan.start || now - s_plan.start >= PLAN_PERIOD_S))) {
+        s_plan.due = false;
+        s_plan.collecting = true;
+        s_plan.truncated = false;
+        s_plan.start = now;
+        s_plan.t = now;
+        s_plan.cursor = 0;
+        s_plan.n = 0;
+        s_plan.collect_us = 0;
+    } else if (!s_plan.collecting) {
+        if (s_plan.resolve_due) {
+            plan_solve(catalog);
+        }
+        return;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    int64_t end = s_plan.start + PLAN_WINDOW_S;
+    while (s_plan.cursor < n && esp_timer_get_time() - t0 < PLAN_BUDGET_US) {
+        orbit_catalog_entry_t *entry = orbit_catalog_at(catalog, s_plan.cursor);
+        orbit_sat_t *sat = s_candidate[s_plan.cursor] ? orbit_catalog_entry_sat(entry) : NULL;
+        if (!sat || s_plan.t >= end) {
+            s_plan.cursor++;
+            s_plan.t = s_plan.start;
+            continue;
+        }
+        int64_t span = (end - s_plan.t < PLAN_CHUNK_S) ? end - s_plan.t : PLAN_CHUNK_S;
+        orbit_pass_t pass;
+        esp_err_t ret = orbit_pass_find(sat, &s_stations[0], s_plan.t, span, &pass);
+        if (ret == ESP_ERR_NOT_FOUND) {
+            s_plan.t += span;
+        } else if (ret != ESP_OK) {
+            s_plan.t = end;
+        } else {
+            if (pass.max_el_deg >= PLAN_MIN_EL_DEG) {
+                plan_add(entry->norad_id, &pass);
+            }
+            s_plan.t = pass.los_unix + 1;
+        }
+    }
+    s_plan.collect_us += esp_timer_get_time() - t0;
+    if (s_plan.cursor < n) {
+        return;
+    }
+
+    s_plan.collecting = false;
+    ESP_LOGI(TAG, "Antenna plan: %u passes collected in %lld ms%s", (unsigned)s_plan.n,
+             (long long)(s_plan.collect_us / 1000), s_plan.truncated ? ", list full: lowest dropped" : "");
+    plan_solve(catalog);
+}
+
+// Knot spacing for the interpolated path, 0 when SGP4 runs every tick. Knots
+// propagate the whole catalog, so they wait for the SGP4 warm-up.
+static int64_t sim_knot_spacing(void) {
+    if (!timebase_is_sim() || s_warmup_pending) {
+        return 0;
+    }
+    float frame_s = timebase_rate() * SIM_FRAME_MS / 1000.0f;
+    if (frame_s * SIM_KNOT_FRAMES > SIM_KNOT_MAX_S) {
+        return 0;
+    }
+    int64_t knot_s = (int64_t)(frame_s * SIM_KNOT_FRAMES);
+    return (knot_s < SIM_KNOT_MIN_S) ? SIM_KNOT_MIN_S : knot_s;
+}
+
+static esp_err_t sim_knot_propagate(orbit_catalog_t *catalog, int64_t t, orbit_soa_t *knot) {
+    s_sim_stats.knots++;
+    return orbit_catalog_propagate_soa(catalog, t, NULL, knot);
+}
+
+// States of the whole catalog at now into s_soa, interpolated between SGP4 knots.
+// Crossing into the next interval reuses the later knot.
+static esp_err_t sim_interp_states(orbit_catalog_t *catalog, size_t n, double now, int64_t knot_s) {
+    int64_t k0 = (int64_t)floor(now / (double)knot_s) * knot_s;
+    if (s_knot_s != knot_s || s_knots[0].count != n || (int64_t)s_knots[0].unix_time_sec != k0) {
+        esp_err_t ret;
+        if (s_knot_s == knot_s && s_knots[1].count == n && (int64_t)s_knots[1].unix_time_sec == k0) {
+            orbit_soa_t tmp = s_knots[0];
+            s_knots[0] = s_knots[1];
+            s_knots[1] = tmp;
+        } else if ((ret = sim_knot_propagate(catalog, k0, &s_knots[0])) != ESP_OK) {
+            s_knot_s = 0;
+            return ret;
+        }
+        if ((ret = sim_knot_propagate(catalog, k0 + knot_s, &s_knots[1])) != ESP_OK) {
+            s_knot_s = 0;
+            return ret;
+        }
+        s_knot_s = knot_s;
+    }
+    return orbit_soa_interp(&s_knots[0], &s_knots[1], now, &s_soa);
+}
+
+// Going back in time (simulation stepped back or returning to real time) leaves
+// predictions made for a later time: redo them
+static void on_time_back(void) {
+    s_prefilter_due = true;
+    s_conj_due = true;
+    s_plan.due = true;
+    s_knot_s = 0;
+    lvgl_port_lock(0);
+    memset(s_next_aos, 0, s_look_cap * sizeof(int64_t));
+    lvgl_port_unlock();
+    for (int i = 0; i < UI_SKYPLOT_SLOTS; i++) {
+        s_sky[i].has_pass = false;
+        s_sky[i].no_pass_before = 0;
+    }
+}
+
+// Propagate the prefiltered catalog once, then derive the satellites x stations
+// look matrix and map positions from the same SoA states. Pruned satellites can't
+// be above any station but are still on the map: they move every few ticks, and
+// those full ticks feed the coverage heatmap.
+static void look_tick(orbit_catalog_t *catalog, double now_s) {
+    size_t n = orbit_catalog_count(catalog);
+    if (n == 0 || !look_buffers_reserve(n)) {
+        return;
+    }
+    int64_t now = (int64_t)now_s;
+    if (now < s_last_look_now) {
+        on_time_back();
+    }
+    s_last_look_now = now;
+    if (s_prefilter_due || now - s_prefilter_time >= PREFILTER_PERIOD_S) {
+        prefilter_refresh(catalog, now);
+    }
+
+    const uint8_t *mask = NULL;
+    int64_t knot_s = sim_knot_spacing();
+    esp_err_t ret;
+    if (knot_s > 0) {
+        ret = sim_interp_states(catalog, n, now_s, knot_s);
+    } else {
+        // Full ticks wait for the warm-up instead of initializing the whole catalog at once
+        mask = (s_look_ticks++ % MAP_FULL_EVERY_TICKS || s_warmup_pending) ? s_candidate : NULL;
+        ret = orbit_catalog_propagate_soa(catalog, now, mask, &s_soa);
+    }
+    if (ret != ESP_OK) {
+        return;
+    }
+
+    int64_t t0 = esp_timer_get_time();
+    size_t n_visible = 0;
+    lvgl_port_lock(0);
+    orbit_look_batch(s_stations, N_STATIONS, &s_soa, true, s_looks, s_visible, &n_visible);
+    // One Sun vector for the tick, then the shadow test over the same states
+    size_t n_eclipsed = 0;
+    orbit_sun_at(s_soa.unix_time_sec, &s_sun);
+    orbit_illum_batch(&s_sun, &s_soa, s_illum, NULL, &n_eclipsed);
+    bool dark = orbit_sun_elevation_deg(&s_sun, &s_stations[0]) < SUN_DARK_EL_DEG;
+    for (size_t i = 0; i < n; i++) {
+        s_mag[i] = (dark && s_soa.valid[i] && s_visible[i * N_STATIONS])
+                       ? orbit_visual_magnitude(&s_sun, &s_stations[0], &s_soa, i, s_illum[i], ORBIT_STD_MAG_DEFAULT)
+                       : ORBIT_MAG_NONE;
+    }
+    s_look_count = n;
+    lvgl_port_unlock();
+    orbit_subpoint_batch(&s_soa, s_sub_lat, s_sub_lon);
+    map_project(n);
+    ESP_LOGD(TAG, "Look angles and illumination %u sats x %u stations in %lld us, %u visible, %u eclipsed",
+             (unsigned)n, (unsigned)N_STATIONS, (long long)(esp_timer_get_time() - t0), (unsigned)n_visible,
+             (unsigned)n_eclipsed);
+
+    for (size_t i = 0; i < n; i++) {
+        orbit_catalog_entry_t *entry = orbit_catalog_at(catalog, i);
+        if (s_soa.valid[i] && entry->user_data) {
+            map_marker_place((ui_sat_marker_t *)entry->user_data, i);
+            ui_sat_marker_set_sunlit((ui_sat_marker_t *)entry->user_data, s_illum[i] >= (ORBIT_ILLUM_FULL + 1) / 2);
+        }
+    }
+    if (!mask) {
+        coverage_sample(now);
+    }
+    // Pass searches are the expensive part: at the real-time rate whatever the tick rate
+    if (esp_timer_get_time() - s_last_pass_step_us >= LOOK_TICK_MS * 1000LL) {
+        s_last_pass_step_us = esp_timer_get_time();
+        next_pass_step(catalog, n, now);
+    }
+    ui_sat_list_refresh();
+}
+
+// Achieved simulated seconds per wall second and the cost of the look frames
+static void sim_log_stats(void) {
+    timebase_stats_t st;
+    timebase_get_stats(&st, true);
+    if (timebase_is_sim() && st.wall_us > 0) {
+        int64_t knot_s = sim_knot_spacing();
+        ESP_LOGI(TAG, "Sim x%.0f%s: %.0f sim s per wall s (%.0f%% of wall time not played), %u frames avg %lld us "
+                      "max %lld us, %s",
+                 timebase_rate(), timebase_paused() ? " paused" : "", st.sim_s * 1e6 / st.wall_us,
+                 100.0 * st.dropped_us / st.wall_us, (unsigned)s_sim_stats.frames,
+                 (long long)(s_sim_stats.frames ? s_sim_stats.frame_us / s_sim_stats.frames : 0),
+                 (long long)s_sim_stats.max_frame_us, knot_s ? "interpolated" : "SGP4 every frame");
+        if (knot_s) {
+            ESP_LOGI(TAG, "Sim knots %lld s apart, %u propagated", (long long)knot_s, (unsigned)s_sim_stats.knots);
+        }
+    }
+    memset(&s_sim_stats, 0, sizeof(s_sim_stats));
+}
+
+static void conj_report(int64_t now) {
+    const orbit_conj_event_t *ev;
+    size_t n = orbit_conj_events(s_conj, &ev);
+    orbit_conj_stats_t st;
+    orbit_conj_get_stats(s_conj, &st);
+    ESP_LOGI(TAG, "Conjunction screen: %u steps, %llu refined, prop %lld ms hash %lld ms pairs %lld ms",
+             (unsigned)st.steps, (unsigned long long)st.gated_pairs, (long long)(st.propagate_us / 1000),
+             (long long)(st.hash_us / 1000), (long long)(st.refine_us / 1000));
+    for (size_t k = 0; k < n; k++) {
+        ESP_LOGW(TAG, "Close approach %lu - %lu: %.2f km at %+.0f s, %.1f km/s", (unsigned long)ev[k].norad_a,
+                 (unsigned long)ev[k].norad_b, ev[k].miss_km, ev[k].tca_unix - (double)now, ev[k].rel_speed_km_s);
+    }
+    if (n == 0) {
+        ui_alert_set(NULL);
+        return;
+    }
+    // Events are sorted by miss distance
+    char text[80];
+    snprintf(text, sizeof(text), "%u close approach%s, %lu - %lu %.1f km in %.0f min", (unsigned)n, n > 1 ? "es" : "",
+             (unsigned long)ev[0].norad_a, (unsigned long)ev[0].norad_b, ev[0].miss_km,
+             (ev[0].tca_unix - (double)now) / 60.0);
+    ui_alert_set(text);
+}
+
+// One screener step per call, in this task so the catalog can't change under it.
+// Steps propagate the whole catalog: not before the SGP4 warm-up is done.
+static void conj_tick(orbit_catalog_t *catalog, int64_t now) {
+    if (!s_conj || s_warmup_pending) {
+        return;
+    }
+    int64_t start = orbit_conj_start_time(s_conj);
+    if (s_conj_due || (!orbit_conj_running(s_conj) && (now < start || now - start >= CONJ_PERIOD_S))) {
+        s_conj_due = false;
+        orbit_conj_start(s_conj, now);
+    } else if (!orbit_conj_running(s_conj)) {
+        return;
+    }
+    esp_err_t ret = orbit_conj_step(s_conj, catalog);
+    if (ret == ESP_OK) {
+        conj_report(now);
+    } else if (ret != ESP_ERR_NOT_FINISHED) {
+        ESP_LOGE(TAG, "Conjunction screen failed: 0x%x", ret);
+    }
+}
+
+// Background lazy SGP4 init, a slice per main loop pass. The prefilter benchmark
+// compares full and filtered updates, so it waits for a warm catalog.
+static void warmup_step(orbit_catalog_t *catalog) {
+    static int64_t t_start = 0;
+    t_start = t_start ? t_start : esp_timer_get_time();
+    // Candidates first once the prefilter has run on this catalog: until then
+    // s_candidate may be too short or indexed by the previous load
+    const uint8_t *priority = (s_candidate_valid && s_look_cap >= orbit_catalog_count(catalog)) ? s_candidate : NULL;
+    s_warmup_pending = orbit_catalog_warmup(catalog, priority, CATALOG_WARMUP_US);
+    if (s_warmup_pending == 0) {
+        ESP_LOGI(TAG, "SGP4 warm-up of %u sats done in %lld ms, %lu bytes free", (unsigned)orbit_catalog_count(catalog),
+                 (long long)((esp_timer_get_time() - t_start) / 1000), (unsigned long)esp_get_free_heap_size());
+        t_start = 0;
+        if (s_prefilter_bench_due) {
+            s_prefilter_due = true;
+        }
+    }
+}
+
+// Reload the TLE file when its modification time changes
+static void catalog_refresh_if_changed(orbit_catalog_t *catalog, time_t *last_mtime) {
+    struct stat st;
+    if (stat(CATALOG_TLE_PATH, &st) != 0 || st.st_mtime == *last_mtime) {
+        return;
+    }
+    *last_mtime = st.st_mtime;
+
+    // The list screen reads the catalog from the LVGL task: its callbacks back off
+    // while the file is parsed, the lock is only held to flip the flag and rebind
+    lvgl_port_lock(0);
+    s_catalog_updating = true;
+    lvgl_port_unlock();
+    orbit_catalog_update_stats_t stats;
+    uint32_t heap_before = esp_get_free_heap_size();
+    esp_err_t ret = orbit_catalog_update_from_file(catalog, CATALOG_TLE_PATH, &stats);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "Catalog refresh from %s failed: 0x%x", CATALOG_TLE_PATH, ret);
+    }
+    ESP_LOGI(TAG, "Catalog load: %lld ms, heap %ld bytes, %lu free", (long long)(stats.elapsed_us / 1000),
+             (long)heap_before - (long)esp_get_free_heap_size(), (unsigned long)esp_get_free_heap_size());
+    s_warmup_pending = orbit_catalog_count(catalog);
+    // Rows refer to catalog indices: drop look angles until the next look tick
+    s_look_count = 0;
+    s_prefilter_due = true;
+    s_candidate_valid = false;
+    s_prefilter_bench_due = true;
+    s_knot_s = 0;
+    s_conj_due = true;
+    s_plan.due = true;
+    lvgl_port_lock(0);
+    s_catalog_updating = false;
+    ui_sat_list_set_source(orbit_catalog_count(catalog), sat_list_row_cb, catalog);
+    lvgl_port_unlock();
+}
+
+// State of the main loop tasks
+typedef struct {
+    orbit_catalog_t *catalog;
+    display_t *display;
+    bool touch_debug;
+    time_t tle_mtime;
+} loop_ctx_t;
+
+static void task_poll(void *ctx) {
+    loop_ctx_t *lc = ctx;
+    uint16_t x = 0, y = 0, strength = 0;
+    if (lc->touch_debug && display_poll_touch(lc->display, &x, &y, &strength)) {
+        ESP_LOGI(TAG, "Touch: x=%u y=%u strength=%u", x, y, strength);
+    }
+    uint32_t selected_norad = 0;
+    while (xQueueReceive(s_select_queue, &selected_norad, 0) == pdTRUE) {
+        sky_toggle(selected_norad);
+        orbit_sched_trigger(s_sched, s_task_sky);
+    }
+    telemetry_tick(lc->catalog, &s_stations[0], timebase_now());
+    if (s_warmup_pending) {
+        warmup_step(lc->catalog);
+    }
+}
+
+static void task_catalog(void *ctx) {
+    loop_ctx_t *lc = ctx;
+    catalog_refresh_if_changed(lc->catalog, &lc->tle_mtime);
+}
+
+static void task_sky(void *ctx) {
+    sky_tick(((loop_ctx_t *)ctx)->catalog, timebase_now_unix());
+}
+
+static void task_look(void *ctx) {
+    int64_t t0 = esp_timer_get_time();
+    look_tick(((loop_ctx_t *)ctx)->catalog, timebase_now());
+    int64_t frame_us = esp_timer_get_time() - t0;
+    s_sim_stats.frames++;
+    s_sim_stats.frame_us += frame_us;
+    s_sim_stats.max_frame_us = (frame_us > s_sim_stats.max_frame_us) ? frame_us : s_sim_stats.max_frame_us;
+}
+
+static void task_conj(void *ctx) {
+    conj_tick(((loop_ctx_t *)ctx)->catalog, timebase_now_unix());
+}
+
+static void task_plan(void *ctx) {
+    plan_step(((loop_ctx_t *)ctx)->catalog, timebase_now_unix());
+}
+
+static void task_sim_stats(void *ctx) {
+    sim_log_stats();
+}
+
+// Execution time and lateness per task plus the LVGL refresh, then reset
+static void task_sched_log(void *ctx) {
+    static char buf[ORBIT_SCHED_MAX_TASKS * 160];
+    orbit_sched_format_all(s_sched, buf, sizeof(buf), true);
+    char *save = NULL;
+    for (char *line = strtok_r(buf, "\n", &save); line; line = strtok_r(NULL, "\n", &save)) {
+        ESP_LOGI(TAG, "%s", line);
+    }
+    display_refresh_stats_t refr;
+    display_get_refresh_stats(&refr, true);
+    orbit_sched_format("lvgl", refr.period_us, &refr.stats, buf, sizeof(buf));
+    ESP_LOGI(TAG, "%s", buf);
+}
+
+static void loop_wake_cb(void *arg) {
+    xTaskNotifyGive(s_loop_task);
+}
+
+// Deadline = period. A full task table drops the task (logged) and returns -1
+static int loop_task_add(const char *name, int64_t period_ms, orbit_sched_fn_t fn, void *ctx) {
+    const orbit_sched_task_cfg_t cfg = {.name = name, .period_us = period_ms * 1000LL, .fn = fn, .ctx = ctx};
+    int id = -1;
+    if (orbit_sched_add(s_sched, &cfg, &id) != ESP_OK) {
+        ESP_LOGE(TAG, "Task %s disabled", name);
+        return -1;
+    }
+    return id;
+}
+
+static void sched_init(void) {
+    s_loop_task = xTaskGetCurrentTaskHandle();
+    ESP_ERROR_CHECK(orbit_sched_create(NULL, NULL, &s_sched));
+    const esp_timer_create_args_t timer_args = {.callback = loop_wake_cb, .name = "loop_wake"};
+    ESP_ERROR_CHECK(esp_timer_create(&timer_args, &s_loop_timer));
+}
+
+// Runs the released tasks and sleeps until the next release; a list selection
+// wakes it early. Never returns.
+static void sched_loop_run(void) {
+    loop_task_add("sched_log", SCHED_LOG_MS, task_sched_log, NULL);
+
+    while (true) {
+        timebase_tick();
+        bool sim = timebase_is_sim();
+        if (s_task_sky >= 0) {
+            orbit_sched_set_period(s_sched, s_task_sky, (sim ? SIM_FRAME_MS : SKY_TICK_MS) * 1000LL, 0);
+        }
+        if (s_task_look >= 0) {
+            orbit_sched_set_period(s_sched, s_task_look, (sim ? SIM_FRAME_MS : LOOK_TICK_MS) * 1000LL, 0);
+        }
+
+        int64_t wait_us = orbit_sched_run(s_sched) - esp_timer_get_time();
+        if (wait_us > 0) {
+            esp_timer_stop(s_loop_timer);
+            esp_timer_start_once(s_loop_timer, (uint64_t)wait_us);
+            ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+            // Woken by a selection: the poll task drains the queue now, not at its period
+            if (s_task_poll >= 0 && uxQueueMessagesWaiting(s_select_queue) > 0) {
+                orbit_sched_trigger(s_sched, s_task_poll);
+            }
+        } else {
+            vTaskDelay(1); // overloaded: still let the idle task in
+        }
+    }
+}
+
+// Kiosk mode: a precomputed ephemeris replaces the TLE catalog and SGP4
+static orbit_ephem_t *s_ephem = NULL;
+static ui_sat_marker_t **s_ephem_markers = NULL;
+
+static bool ephem_row_cb(size_t index, ui_sat_row_t *row, void *ctx) {
+    const orbit_ephem_sat_rec_t *rec = orbit_ephem_sat(s_ephem, index);
+    if (!rec) {
+        return false;
+    }
+    memcpy(row->name, rec->name, ORBIT_EPHEM_NAME_LEN);
+    row->name[ORBIT_EPHEM_NAME_LEN] = '\0';
+    row->has_elevation = index < s_look_count && s_visible[index * N_STATIONS];
+    row->elevation_deg = row->has_elevation ? s_looks[index * N_STATIONS].el_deg : 0.0f;
+    row->next_pass_unix = 0;
+    return true;
+}
+
+static void ephem_tick(double now) {
+    size_t n = orbit_ephem_count(s_ephem);
+    if (!look_buffers_reserve(n)) {
+        return;
+    }
+    esp_err_t ret = orbit_ephem_propagate_soa(s_ephem, now, &s_soa);
+    if (ret != ESP_OK) {
+        ESP_LOGW(TAG, "No ephemeris for now=%lld: 0x%x", (long long)now, ret);
+        return;
+    }
+
+    lvgl_port_lock(0);
+    orbit_look_batch(s_stations, N_STATIONS, &s_soa, true, s_looks, s_visible, NULL);
+    s_look_count = n;
+    lvgl_port_unlock();
+    orbit_subpoint_batch(&s_soa, s_sub_lat, s_sub_lon);
+    map_project(n);
+    for (size_t i = 0; i < n; i++) {
+        if (s_soa.valid[i] && s_ephem_markers[i]) {
+            map_marker_place(s_ephem_markers[i], i);
+        }
+    }
+    coverage_sample((int64_t)now);
+    ui_sat_list_refresh();
+}
+
+static void task_ephem(void *ctx) {
+    ephem_tick(timebase_now());
+}
+
+static void ephem_kiosk_run(void) {
+    size_t n = orbit_ephem_count(s_ephem);
+    s_ephem_markers = calloc(n, sizeof(ui_sat_marker_t *));
+    if (!s_ephem_markers) {
+        ESP_LOGE(TAG, "No mem for %u markers", (unsigned)n);
+        return;
+    }
+    for (size_t i = 0; i < n; i++) {
+        const orbit_ephem_sat_rec_t *rec = orbit_ephem_sat(s_ephem, i);
+        char name[ORBIT_EPHEM_NAME_LEN + 1];
+        memcpy(name, rec->name, ORBIT_EPHEM_NAME_LEN);
+        name[ORBIT_EPHEM_NAME_LEN] = '\0';
+        s_ephem_markers[i] = ui_sat_marker_create(rec->norad_id, name);
+    }
+    ui_sat_list_set_source(n, ephem_row_cb, NULL);
+
+    s_task_look = loop_task_add("ephem", LOOK_TICK_MS, task_ephem, NULL);
+    sched_loop_run();
+}
+
 void app_main(void) {
     ESP_LOGI(TAG, "App start");
 
@@ -48,27 +1158,91 @@ void app_main(void) {
     ESP_ERROR_CHECK(display_lvgl_init(&display));
     ui_init();
 
-    orbit_sat_t *lur1 = NULL;
-    ESP_LOGI(TAG, "Creating LUR-1 satellite from TLE");
-    ESP_ERROR_CHECK(orbit_sat_create_from_tle(ORBIT_TLE_LUR1_L1, ORBIT_TLE_LUR1_L2, &lur1));
+    for (size_t i = 0; i < N_STATIONS; i++) {
+        orbit_station_init(&s_stations[i], k_stations[i].lat_deg, k_stations[i].lon_deg, k_stations[i].alt_km,
+                           k_stations[i].min_el_deg);
+    }
+    if (orbit_proj_create(MAP_PROJECTION, LCD_H_RES, LCD_V_RES, k_stations[0].lat_deg, k_stations[0].lon_deg,
+                          &s_proj) != ESP_OK) {
+        ESP_ERROR_CHECK(orbit_proj_create(ORBIT_PROJ_EQUIRECT, LCD_H_RES, LCD_V_RES, 0.0, 0.0, &s_proj));
+    }
+    ui_map_set_projection(s_proj);
+    s_select_queue = xQueueCreate(4, sizeof(uint32_t));
+    if (orbit_coverage_create(COVERAGE_WINDOW_S, k_stations[0].min_el_deg, &s_coverage) != ESP_OK) {
+        ESP_LOGW(TAG, "Coverage heatmap disabled");
+    }
+    orbit_conj_config_t conj_cfg = ORBIT_CONJ_DEFAULT_CONFIG();
+    if (orbit_conj_create(&conj_cfg, &s_conj) != ESP_OK) {
+        ESP_LOGW(TAG, "Close-approach screening disabled");
+    }
+    telemetry_config_t tlm_cfg = TELEMETRY_DEFAULT_CONFIG();
+    if (telemetry_start(&tlm_cfg) != ESP_OK) {
+        ESP_LOGW(TAG, "Position stream disabled");
+    }
 
     // UTC 2025-12-09 23:00:00
     int64_t now_unix = 1765321200;
     ESP_LOGI(TAG, "Using now_unix=%lld (UTC 2025-12-09 23:00:00)", (long long)now_unix);
+    // Real clock runs from the fixed start time until SNTP/RTC is available
+    timebase_init(now_unix);
+    sched_init();
 
-    orbit_eci_t lur1_eci = {0};
-    esp_err_t orbit_ret = orbit_sat_propagate_unix(lur1, now_unix, &lur1_eci);
-    if (orbit_ret == ESP_OK) {
-        ESP_LOGI(TAG, "LUR-1 ECI [km]: x=%.3f y=%.3f z=%.3f", lur1_eci.x, lur1_eci.y, lur1_eci.z);
-    } else {
-        ESP_LOGE(TAG, "orbit_sat_propagate_unix failed: 0x%x", orbit_ret);
+    if (sd_ret == ESP_OK && orbit_ephem_open(EPHEM_PATH, &s_ephem) == ESP_OK) {
+        ESP_LOGI(TAG, "%s found: kiosk mode, positions from the ephemeris", EPHEM_PATH);
+        ephem_kiosk_run();
     }
 
-    while (true) {
-        uint16_t x = 0, y = 0, strength = 0;
-        if (touch_debug && display_poll_touch(&display, &x, &y, &strength)) {
-            ESP_LOGI(TAG, "Touch: x=%u y=%u strength=%u", x, y, strength);
+    const orbit_catalog_callbacks_t catalog_cbs = {
+        .on_added = catalog_on_added,
+        .on_changed = catalog_on_changed,
+        .on_removed = catalog_on_removed,
+    };
+    orbit_catalog_t *catalog = NULL;
+    ESP_ERROR_CHECK(orbit_catalog_create(&catalog_cbs, &catalog));
+    // Only elements at load time: SGP4 init on first use and in the background,
+    // visibility candidates first
+    orbit_catalog_set_lazy(catalog, true);
+
+    time_t tle_mtime = 0;
+    if (sd_ret == ESP_OK) {
+        catalog_refresh_if_changed(catalog, &tle_mtime);
+    }
+    if (orbit_catalog_count(catalog) == 0) {
+        ESP_LOGI(TAG, "No TLE file, creating LUR-1 satellite from TLE");
+        const orbit_catalog_tle_src_t lur1_src = {
+            .name = "LUR-1",
+            .line1 = ORBIT_TLE_LUR1_L1,
+            .line2 = ORBIT_TLE_LUR1_L2,
+        };
+        ESP_ERROR_CHECK(orbit_catalog_update(catalog, &lur1_src, 1, NULL));
+        ui_sat_list_set_source(orbit_catalog_count(catalog), sat_list_row_cb, catalog);
+    }
+    ui_sat_list_set_select_cb(sat_list_select_cb, catalog);
+
+    orbit_catalog_entry_t *lur1 = orbit_catalog_find(catalog, LUR1_NORAD_ID);
+    if (lur1) {
+        orbit_eci_t lur1_eci = {0};
+        esp_err_t orbit_ret = orbit_sat_propagate_unix(orbit_catalog_entry_sat(lur1), now_unix, &lur1_eci);
+        if (orbit_ret == ESP_OK) {
+            ESP_LOGI(TAG, "LUR-1 ECI [km]: x=%.3f y=%.3f z=%.3f", lur1_eci.x, lur1_eci.y, lur1_eci.z);
+        } else {
+            ESP_LOGE(TAG, "orbit_sat_propagate_unix failed: 0x%x", orbit_ret);
         }
-        vTaskDelay(pdMS_TO_TICKS(30));
     }
+
+    if (lur1) {
+        sky_toggle(LUR1_NORAD_ID);
+    }
+
+    loop_ctx_t lc = {.catalog = catalog, .display = &display, .touch_debug = touch_debug, .tle_mtime = tle_mtime};
+    s_task_poll = loop_task_add("poll", LOOP_POLL_MS, task_poll, &lc);
+    s_task_sky = loop_task_add("sky", SKY_TICK_MS, task_sky, &lc);
+    s_task_look = loop_task_add("look", LOOK_TICK_MS, task_look, &lc);
+    loop_task_add("conj", CONJ_STEP_MS, task_conj, &lc);
+    loop_task_add("plan", PLAN_TICK_MS, task_plan, &lc);
+    if (sd_ret == ESP_OK) {
+        loop_task_add("catalog", CATALOG_POLL_MS, task_catalog, &lc);
+    }
+    loop_task_add("sim_log", SIM_STATS_LOG_MS, task_sim_stats, NULL);
+    sched_loop_run();
 }
@@ -0,0 +1,167 @@
+#include <math.h>
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/ringbuf.h"
+#include "freertos/task.h"
+
+#include "driver/uart.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "board_pins.h"
+#include "orbit_telemetry.h"
+#include "telemetry.h"
+
+static const char *TAG = "telemetry";
+
+#define TELEMETRY_RX_BUF    256 // unused, the driver wants more than the FIFO
+#define TELEMETRY_CHUNK     512
+#define TELEMETRY_LOG_US    (60 * 1000000LL)
+#define TELEMETRY_TASK_PRIO 3
+
+static struct {
+    RingbufHandle_t ring;
+    int uart_num;
+    int64_t period_us;
+    int64_t last_us;
+    uint32_t seq;
+
+    uint32_t ids[ORBIT_TLM_MAX_RECORDS];
+    size_t n_ids;
+
+    // Producer side only, logged once a minute
+    uint32_t queued;
+    uint32_t dropped;
+    uint64_t bytes;
+    int64_t last_log_us;
+} s_tlm;
+
+// Blocks on the UART (interrupt-driven FIFO refills) so the main loop never does
+static void writer_task(void *arg) {
+    while (true) {
+        size_t len = 0;
+        uint8_t *data = xRingbufferReceiveUpTo(s_tlm.ring, &len, portMAX_DELAY, TELEMETRY_CHUNK);
+        if (data) {
+            uart_write_bytes(s_tlm.uart_num, data, len);
+            vRingbufferReturnItem(s_tlm.ring, data);
+        }
+    }
+}
+
+esp_err_t telemetry_start(const telemetry_config_t *cfg) {
+    if (!cfg || cfg->rate_hz <= 0.0f || cfg->ring_bytes < ORBIT_TLM_FRAME_MAX) {
+        ESP_LOGE(TAG, "telemetry_start: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (s_tlm.ring) {
+        return ESP_ERR_INVALID_STATE;
+    }
+
+    const uart_config_t uart_cfg = {
+        .baud_rate = cfg->baud,
+        .data_bits = UART_DATA_8_BITS,
+        .parity = UART_PARITY_DISABLE,
+        .stop_bits = UART_STOP_BITS_1,
+        .flow_ctrl = UART_HW_FLOWCTRL_DISABLE,
+        .source_clk = UART_SCLK_DEFAULT,
+    };
+    // No driver TX buffer: the ring below is the only copy, written straight to the FIFO
+    esp_err_t ret = uart_driver_install(cfg->uart_num, TELEMETRY_RX_BUF, 0, 0, NULL, 0);
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "uart_driver_install failed: 0x%x", ret);
+        return ret;
+    }
+    ret = uart_param_config(cfg->uart_num, &uart_cfg);
+    if (ret == ESP_OK) {
+        ret = uart_set_pin(cfg->uart_num, cfg->tx_pin, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+    }
+    if (ret != ESP_OK) {
+        ESP_LOGE(TAG, "UART%d setup failed: 0x%x", cfg->uart_num, ret);
+        uart_driver_delete(cfg->uart_num);
+        return ret;
+    }
+
+    s_tlm.ring = xRingbufferCreate(cfg->ring_bytes, RINGBUF_TYPE_BYTEBUF);
+    if (!s_tlm.ring) {
+        uart_driver_delete(cfg->uart_num);
+        return ESP_ERR_NO_MEM;
+    }
+    s_tlm.uart_num = cfg->uart_num;
+    s_tlm.period_us = (int64_t)(1e6f / cfg->rate_hz);
+    s_tlm.last_log_us = esp_timer_get_time();
+    if (xTaskCreate(writer_task, "tlm_tx", 2048, NULL, TELEMETRY_TASK_PRIO, NULL) != pdPASS) {
+        vRingbufferDelete(s_tlm.ring);
+        s_tlm.ring = NULL;
+        uart_driver_delete(cfg->uart_num);
+        return ESP_ERR_NO_MEM;
+    }
+    ESP_LOGI(TAG, "Position stream on UART%d TX GPIO%d at %d baud, %.1f msg/s", cfg->uart_num, cfg->tx_pin,
+             cfg->baud, cfg->rate_hz);
+    return ESP_OK;
+}
+
+esp_err_t telemetry_set_subset(const uint32_t *norad_ids, size_t count) {
+    if ((!norad_ids && count > 0) || count > ORBIT_TLM_MAX_RECORDS) {
+        ESP_LOGE(TAG, "telemetry_set_subset: invalid args");
+        return ESP_ERR_INVALID_ARG;
+    }
+    if (count > 0) {
+        memcpy(s_tlm.ids, norad_ids, count * sizeof(*norad_ids));
+    }
+    s_tlm.n_ids = count;
+    return ESP_OK;
+}
+
+void telemetry_tick(orbit_catalog_t *catalog, const orbit_station_t *st, double now) {
+    int64_t now_us = esp_timer_get_time();
+    if (!s_tlm.ring || s_tlm.n_ids == 0 || now_us - s_tlm.last_us < s_tlm.period_us) {
+        return;
+    }
+    s_tlm.last_us = now_us;
+
+    orbit_tlm_pos_t recs[ORBIT_TLM_MAX_RECORDS];
+    size_t n = 0;
+    for (size_t i = 0; i < s_tlm.n_ids; i++) {
+        orbit_sat_t *sat = orbit_catalog_entry_sat(orbit_catalog_find(catalog, s_tlm.ids[i]));
+        orbit_eci_t pos, vel;
+        if (!sat || orbit_sat_propagate_state(sat, now, &pos, &vel) != ESP_OK) {
+            continue;
+        }
+        orbit_look_t look;
+        orbit_station_look(st, &pos, &vel, now, &look);
+        recs[n] = (orbit_tlm_pos_t){
+            .norad_id = s_tlm.ids[i],
+            .pos_km = {(float)pos.x, (float)pos.y, (float)pos.z},
+            .vel_km_s = {(float)vel.x, (float)vel.y, (float)vel.z},
+            .az_deg = look.az_deg,
+            .el_deg = look.el_deg,
+            .range_km = look.range_km,
+            .range_rate_km_s = look.range_rate_km_s,
+        };
+        n++;
+    }
+
+    uint8_t frame[ORBIT_TLM_FRAME_MAX];
+    size_t len;
+    if (orbit_tlm_encode(s_tlm.seq++, (int64_t)llround(now * 1000.0), recs, n, frame, &len) != ESP_OK) {
+        return;
+    }
+    // Whole frames or nothing: the reader sees a sequence gap, never a torn frame
+    if (xRingbufferSend(s_tlm.ring, frame, len, 0) == pdTRUE) {
+        s_tlm.queued++;
+        s_tlm.bytes += len;
+    } else {
+        s_tlm.dropped++;
+    }
+
+    if (now_us - s_tlm.last_log_us >= TELEMETRY_LOG_US) {
+        ESP_LOGI(TAG, "%lu messages (%llu bytes) queued, %lu dropped in the last minute", (unsigned long)s_tlm.queued,
+                 (unsigned long long)s_tlm.bytes, (unsigned long)s_tlm.dropped);
+        s_tlm.queued = 0;
+        s_tlm.dropped = 0;
+        s_tlm.bytes = 0;
+        s_tlm.last_log_us = now_us;
+    }
+}
@@ -0,0 +1,157 @@
+#include <string.h>
+
+#include "freertos/FreeRTOS.h"
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "timebase.h"
+
+static const char *TAG = "timebase";
+
+// Longest wall-clock step one tick plays in simulation
+#define TIMEBASE_MAX_STEP_US 250000
+
+static struct {
+    portMUX_TYPE lock;
+    double real_ref_unix; // real time at real_ref_us
+    int64_t real_ref_us;
+
+    bool sim;
+    bool paused;
+    float rate;
+    double sim_now;
+    int64_t last_tick_us;
+
+    timebase_stats_t stats;
+} s_tb = {
+    .lock = portMUX_INITIALIZER_UNLOCKED,
+    .rate = 1.0f,
+};
+
+static double real_now(int64_t now_us) {
+    return s_tb.real_ref_unix + (now_us - s_tb.real_ref_us) * 1e-6;
+}
+
+// Leave real time at the current instant; keeps a simulation rate already chosen
+static void enter_sim_locked(int64_t now_us) {
+    if (s_tb.sim) {
+        return;
+    }
+    s_tb.sim = true;
+    s_tb.sim_now = real_now(now_us);
+    s_tb.rate = (s_tb.rate >= TIMEBASE_RATE_MIN) ? s_tb.rate : TIMEBASE_RATE_MIN;
+}
+
+void timebase_init(int64_t unix_time_sec) {
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tb.lock);
+    s_tb.real_ref_unix = (double)unix_time_sec;
+    s_tb.real_ref_us = now_us;
+    s_tb.sim = false;
+    s_tb.paused = false;
+    s_tb.rate = 1.0f;
+    s_tb.last_tick_us = now_us;
+    memset(&s_tb.stats, 0, sizeof(s_tb.stats));
+    portEXIT_CRITICAL(&s_tb.lock);
+}
+
+void timebase_set_real(int64_t unix_time_sec) {
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tb.lock);
+    s_tb.real_ref_unix = (double)unix_time_sec;
+    s_tb.real_ref_us = now_us;
+    portEXIT_CRITICAL(&s_tb.lock);
+}
+
+esp_err_t timebase_set_rate(float rate) {
+    if (rate != 1.0f && (rate < TIMEBASE_RATE_MIN || rate > TIMEBASE_RATE_MAX)) {
+        ESP_LOGE(TAG, "Unsupported rate %.1f", rate);
+        return ESP_ERR_INVALID_ARG;
+    }
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tb.lock);
+    if (rate == 1.0f) {
+        s_tb.sim = false;
+        s_tb.paused = false;
+    } else {
+        enter_sim_locked(now_us);
+    }
+    s_tb.rate = rate;
+    portEXIT_CRITICAL(&s_tb.lock);
+    ESP_LOGI(TAG, "%s x%.0f", rate == 1.0f ? "Real time" : "Simulation", rate);
+    return ESP_OK;
+}
+
+void timebase_set_paused(bool paused) {
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tb.lock);
+    if (paused) {
+        enter_sim_locked(now_us);
+    }
+    s_tb.paused = paused && s_tb.sim;
+    portEXIT_CRITICAL(&s_tb.lock);
+}
+
+void timebase_step(double seconds) {
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tb.lock);
+    enter_sim_locked(now_us);
+    s_tb.sim_now += seconds;
+    portEXIT_CRITICAL(&s_tb.lock);
+}
+
+bool timebase_is_sim(void) {
+    return s_tb.sim;
+}
+
+float timebase_rate(void) {
+    return s_tb.sim ? s_tb.rate : 1.0f;
+}
+
+bool timebase_paused(void) {
+    return s_tb.paused;
+}
+
+void timebase_tick(void) {
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tb.lock);
+    int64_t wall = now_us - s_tb.last_tick_us;
+    s_tb.last_tick_us = now_us;
+    s_tb.stats.wall_us += wall;
+    if (!s_tb.sim) {
+        s_tb.stats.sim_s += wall * 1e-6;
+    } else {
+        int64_t played = (wall > TIMEBASE_MAX_STEP_US) ? TIMEBASE_MAX_STEP_US : wall;
+        s_tb.stats.dropped_us += wall - played;
+        if (!s_tb.paused) {
+            s_tb.sim_now += played * 1e-6 * s_tb.rate;
+            s_tb.stats.sim_s += played * 1e-6 * s_tb.rate;
+        }
+    }
+    portEXIT_CRITICAL(&s_tb.lock);
+}
+
+double timebase_now(void) {
+    int64_t now_us = esp_timer_get_time();
+    portENTER_CRITICAL(&s_tb.lock);
+    double t = s_tb.sim ? s_tb.sim_now : real_now(now_us);
+    portEXIT_CRITICAL(&s_tb.lock);
+    return t;
+}
+
+int64_t timebase_now_unix(void) {
+    return (int64_t)timebase_now();
+}
+
+void timebase_get_stats(timebase_stats_t *out_stats, bool reset) {
+    if (!out_stats) {
+        return;
+    }
+    portENTER_CRITICAL(&s_tb.lock);
+    *out_stats = s_tb.stats;
+    if (reset) {
+        memset(&s_tb.stats, 0, sizeof(s_tb.stats));
+    }
+    portEXIT_CRITICAL(&s_tb.lock);
+}
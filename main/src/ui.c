@@ -2,26 +2,105 @@
 #include "freertos/task.h"
 
 #include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
 #include "esp_err.h"
 #include "esp_log.h"
+#include "esp_timer.h"
 
 #include "esp_lvgl_port.h"
 #include "lvgl.h"
 
 #include "board_pins.h"
 #include "ui.h"
+#include "ui_priv.h"
 
 static const char *TAG = "ui";
 
+static lv_obj_t *s_map_img = NULL;
 static lv_obj_t *s_satellite_dot = NULL;
+static lv_obj_t *s_alert_label = NULL;
+
+// Satellite markers: a list blitted by one overlay object (an object each would
+// exhaust the LVGL pool with a full catalog), from two pre-rendered dots
+struct ui_sat_marker_t {
+    ui_sat_marker_t *prev;
+    ui_sat_marker_t *next;
+    ui_map_label_t *label;
+    uint32_t norad_id;
+    int16_t x; // center
+    int16_t y;
+    bool shown;
+    bool sunlit;
+};
+
+#define SAT_MARKER_SIZE     8
+#define SAT_MARKER_COLOR    0xFFD000
+#define SAT_MARKER_ECLIPSED 0x707070
+
+static lv_obj_t *s_marker_overlay = NULL;
+static ui_sat_marker_t *s_marker_head = NULL;
+static ui_sat_marker_t *s_marker_tail = NULL;
+static lv_color32_t s_marker_px[2][SAT_MARKER_SIZE * SAT_MARKER_SIZE]; // eclipsed, sunlit
+static lv_image_dsc_t s_marker_dsc[2];
+
+// Virtualized satellite list: a pool of rows slightly larger than the viewport is
+// bound to catalog indices (slot = index % pool) and rebound as they scroll in.
+#define SAT_LIST_HEADER_H 32
+#define SAT_LIST_ROW_H    28
+#define SAT_LIST_POOL     ((LCD_V_RES - SAT_LIST_HEADER_H) / SAT_LIST_ROW_H + 2)
+
+typedef struct {
+    lv_obj_t *row;
+    lv_obj_t *name;
+    lv_obj_t *light;
+    lv_obj_t *elev;
+    lv_obj_t *pass;
+    size_t index; // bound catalog index, SIZE_MAX when unbound
+} sat_list_row_t;
+
+static lv_obj_t *s_list_scr = NULL;
+static lv_obj_t *s_sky_scr = NULL;
+static lv_obj_t *s_plan_scr = NULL;
+static lv_obj_t *s_list_cont = NULL;
+static lv_obj_t *s_list_spacer = NULL;
+static lv_obj_t *s_list_title = NULL;
+static sat_list_row_t s_list_rows[SAT_LIST_POOL];
+static size_t s_list_count = 0;
+static ui_sat_list_row_cb_t s_list_row_cb = NULL;
+static void *s_list_row_ctx = NULL;
+static ui_sat_list_select_cb_t s_list_select_cb = NULL;
+static void *s_list_select_ctx = NULL;
 
 // Image generated from main/images/world_480x320.png via lvgl_port_create_c_image
 LV_IMG_DECLARE(world_480x320);
 
+// Reprojected backgrounds are cached at half resolution and stretched (75 KB of
+// RGB565 instead of 300 KB), in the source image's pixel format
+#define MAP_BG_SCALE 2
+#define MAP_BG_W     (LCD_H_RES / MAP_BG_SCALE)
+#define MAP_BG_H     (LCD_V_RES / MAP_BG_SCALE)
+#define MAP_BG_SPACE 0x0000 // outside the mapped area, black in either byte order
+
+static uint16_t *s_map_bg_buf = NULL;
+static lv_image_dsc_t s_map_bg_dsc;
+static bool s_map_equirect = true;
+
 static void map_touch_cb(lv_event_t *e) {
     lv_event_code_t code = lv_event_get_code(e);
 
+    if (code == LV_EVENT_LONG_PRESSED && s_list_scr) {
+        lv_screen_load(s_list_scr);
+        return;
+    }
+    if (code == LV_EVENT_SHORT_CLICKED) {
+        ui_coverage_toggle();
+        return;
+    }
+
     if (code != LV_EVENT_PRESSED && code != LV_EVENT_RELEASED && code != LV_EVENT_PRESSING && code != LV_EVENT_CLICKED) {
         return;
     }
@@ -68,16 +147,245 @@ static void start_satellite_animation(void) {
     lv_anim_start(&a);
 }
 
+static void sat_list_bind_row(sat_list_row_t *r, size_t index) {
+    ui_sat_row_t data = {0};
+    if (index >= s_list_count || !s_list_row_cb || !s_list_row_cb(index, &data, s_list_row_ctx)) {
+        lv_obj_add_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+        r->index = SIZE_MAX;
+        return;
+    }
+
+    char buf[24];
+    lv_label_set_text(r->name, data.name);
+
+    if (data.has_magnitude) {
+        snprintf(buf, sizeof(buf), "%.1f mag", (double)data.magnitude);
+    } else if (data.has_illum) {
+        snprintf(buf, sizeof(buf), "%s", data.sunlit ? "lit" : "ecl");
+    } else {
+        buf[0] = '\0';
+    }
+    lv_label_set_text(r->light, buf);
+
+    if (data.has_elevation) {
+        snprintf(buf, sizeof(buf), "%+.1f", (double)data.elevation_deg);
+    } else {
+        snprintf(buf, sizeof(buf), "--");
+    }
+    lv_label_set_text(r->elev, buf);
+
+    if (data.next_pass_unix > 0) {
+        time_t t = (time_t)data.next_pass_unix;
+        struct tm tm_utc;
+        gmtime_r(&t, &tm_utc);
+        snprintf(buf, sizeof(buf), "%02d:%02d", tm_utc.tm_hour, tm_utc.tm_min);
+    } else {
+        snprintf(buf, sizeof(buf), "--:--");
+    }
+    lv_label_set_text(r->pass, buf);
+
+    lv_obj_set_y(r->row, (lv_coord_t)(index * SAT_LIST_ROW_H));
+    lv_obj_remove_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+    r->index = index;
+}
+
+// Bind the rows covering the viewport. Rows that stay visible keep their binding,
+// so a scroll step only touches the rows entering the view.
+static void sat_list_update_rows(bool force) {
+    if (!s_list_cont) {
+        return;
+    }
+    size_t first = (size_t)(lv_obj_get_scroll_y(s_list_cont) / SAT_LIST_ROW_H);
+    for (size_t i = first; i < first + SAT_LIST_POOL; i++) {
+        sat_list_row_t *r = &s_list_rows[i % SAT_LIST_POOL];
+        if (force || r->index != i) {
+            sat_list_bind_row(r, i);
+        }
+    }
+}
+
+static void sat_list_scroll_cb(lv_event_t *e) {
+    sat_list_update_rows(false);
+}
+
+static void sat_list_back_cb(lv_event_t *e) {
+    lv_screen_load(lv_obj_get_screen(s_map_img));
+}
+
+static void sat_list_sky_cb(lv_event_t *e) {
+    lv_screen_load(s_sky_scr);
+}
+
+static void sat_list_plan_cb(lv_event_t *e) {
+    lv_screen_load(s_plan_scr);
+}
+
+static void sat_list_row_click_cb(lv_event_t *e) {
+    sat_list_row_t *r = (sat_list_row_t *)lv_event_get_user_data(e);
+    if (r->index != SIZE_MAX && s_list_select_cb) {
+        s_list_select_cb(r->index, s_list_select_ctx);
+    }
+}
+
+static lv_obj_t *sat_list_header_button(const char *txt, lv_coord_t x_ofs, lv_event_cb_t cb) {
+    lv_obj_t *btn = lv_button_create(s_list_scr);
+    lv_obj_set_size(btn, 64, SAT_LIST_HEADER_H - 4);
+    lv_obj_align(btn, LV_ALIGN_TOP_RIGHT, x_ofs, 2);
+    lv_obj_add_event_cb(btn, cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *label = lv_label_create(btn);
+    lv_label_set_text(label, txt);
+    lv_obj_center(label);
+    return btn;
+}
+
+static lv_obj_t *sat_list_label(lv_obj_t *row, lv_coord_t x, lv_coord_t w, lv_text_align_t align) {
+    lv_obj_t *label = lv_label_create(row);
+    lv_obj_set_width(label, w);
+    lv_obj_set_pos(label, x, 6);
+    lv_label_set_long_mode(label, LV_LABEL_LONG_MODE_CLIP);
+    lv_obj_set_style_text_align(label, align, 0);
+    lv_obj_set_style_text_color(label, lv_color_hex(0xFFFFFF), 0);
+    return label;
+}
+
+static void create_list_screen(void) {
+    s_list_scr = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(s_list_scr, lv_color_hex(0x101418), 0);
+
+    s_list_title = lv_label_create(s_list_scr);
+    lv_obj_set_style_text_color(s_list_title, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_align(s_list_title, LV_ALIGN_TOP_LEFT, 8, 8);
+    lv_label_set_text(s_list_title, "Satellites");
+
+    sat_list_header_button("Map", -2, sat_list_back_cb);
+    sat_list_header_button("Sky", -70, sat_list_sky_cb);
+    sat_list_header_button("Plan", -138, sat_list_plan_cb);
+
+    s_list_cont = lv_obj_create(s_list_scr);
+    lv_obj_remove_style_all(s_list_cont);
+    lv_obj_set_size(s_list_cont, LCD_H_RES, LCD_V_RES - SAT_LIST_HEADER_H);
+    lv_obj_set_pos(s_list_cont, 0, SAT_LIST_HEADER_H);
+    lv_obj_set_scroll_dir(s_list_cont, LV_DIR_VER);
+    lv_obj_add_event_cb(s_list_cont, sat_list_scroll_cb, LV_EVENT_SCROLL, NULL);
+
+    // Invisible child that gives the container the height of the whole catalog
+    s_list_spacer = lv_obj_create(s_list_cont);
+    lv_obj_remove_style_all(s_list_spacer);
+    lv_obj_set_size(s_list_spacer, 1, 0);
+    lv_obj_remove_flag(s_list_spacer, LV_OBJ_FLAG_CLICKABLE);
+
+    for (size_t i = 0; i < SAT_LIST_POOL; i++) {
+        sat_list_row_t *r = &s_list_rows[i];
+        r->row = lv_obj_create(s_list_cont);
+        lv_obj_remove_style_all(r->row);
+        lv_obj_set_size(r->row, LCD_H_RES, SAT_LIST_ROW_H);
+        lv_obj_set_style_border_side(r->row, LV_BORDER_SIDE_BOTTOM, 0);
+        lv_obj_set_style_border_width(r->row, 1, 0);
+        lv_obj_set_style_border_color(r->row, lv_color_hex(0x303840), 0);
+        lv_obj_add_flag(r->row, LV_OBJ_FLAG_HIDDEN);
+        lv_obj_add_event_cb(r->row, sat_list_row_click_cb, LV_EVENT_CLICKED, r);
+
+        r->name = sat_list_label(r->row, 8, 196, LV_TEXT_ALIGN_LEFT);
+        r->light = sat_list_label(r->row, 204, 72, LV_TEXT_ALIGN_RIGHT);
+        r->elev = sat_list_label(r->row, 276, 80, LV_TEXT_ALIGN_RIGHT);
+        r->pass = sat_list_label(r->row, 372, 96, LV_TEXT_ALIGN_RIGHT);
+        r->index = SIZE_MAX;
+    }
+}
+
+// Filled circle with a 1 px black border, transparent outside
+static void marker_render(int i, uint32_t color) {
+    lv_color32_t fill = lv_color_to_32(lv_color_hex(color), LV_OPA_COVER);
+    lv_color32_t border = lv_color_to_32(lv_color_black(), LV_OPA_COVER);
+    lv_color32_t none = lv_color_to_32(lv_color_black(), LV_OPA_TRANSP);
+    // Twice the distance from the center, squared
+    const int r2 = SAT_MARKER_SIZE * SAT_MARKER_SIZE;
+    const int inner2 = (SAT_MARKER_SIZE - 2) * (SAT_MARKER_SIZE - 2);
+    for (int y = 0; y < SAT_MARKER_SIZE; y++) {
+        for (int x = 0; x < SAT_MARKER_SIZE; x++) {
+            int dx = 2 * x + 1 - SAT_MARKER_SIZE, dy = 2 * y + 1 - SAT_MARKER_SIZE;
+            int d2 = dx * dx + dy * dy;
+            s_marker_px[i][y * SAT_MARKER_SIZE + x] = (d2 > r2) ? none : (d2 > inner2) ? border : fill;
+        }
+    }
+    lv_image_dsc_t *dsc = &s_marker_dsc[i];
+    dsc->header.magic = LV_IMAGE_HEADER_MAGIC;
+    dsc->header.cf = LV_COLOR_FORMAT_ARGB8888;
+    dsc->header.w = SAT_MARKER_SIZE;
+    dsc->header.h = SAT_MARKER_SIZE;
+    dsc->header.stride = SAT_MARKER_SIZE * sizeof(lv_color32_t);
+    dsc->data_size = sizeof(s_marker_px[i]);
+    dsc->data = (const uint8_t *)s_marker_px[i];
+}
+
+static lv_area_t marker_area(const ui_sat_marker_t *m) {
+    lv_area_t area = {.x1 = m->x - SAT_MARKER_SIZE / 2, .y1 = m->y - SAT_MARKER_SIZE / 2};
+    area.x2 = area.x1 + SAT_MARKER_SIZE - 1;
+    area.y2 = area.y1 + SAT_MARKER_SIZE - 1;
+    return area;
+}
+
+// LVGL lock held
+static void marker_invalidate(const ui_sat_marker_t *m) {
+    if (m->shown) {
+        lv_area_t area = marker_area(m);
+        lv_obj_invalidate_area(s_marker_overlay, &area);
+    }
+}
+
+// Markers outside the redrawn area are skipped before they become draw tasks
+static void markers_draw_cb(lv_event_t *e) {
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_area_t coords;
+    lv_obj_get_coords(s_marker_overlay, &coords);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    for (ui_sat_marker_t *m = s_marker_head; m; m = m->next) {
+        if (!m->shown) {
+            continue;
+        }
+        lv_area_t area = marker_area(m);
+        lv_area_move(&area, coords.x1, coords.y1);
+        if (!lv_area_is_on(&area, &layer->_clip_area)) {
+            continue;
+        }
+        dsc.src = &s_marker_dsc[m->sunlit];
+        lv_draw_image(layer, &dsc, &area);
+    }
+}
+
+static void markers_create_overlay(lv_obj_t *map_img) {
+    marker_render(0, SAT_MARKER_ECLIPSED);
+    marker_render(1, SAT_MARKER_COLOR);
+
+    s_marker_overlay = lv_obj_create(map_img);
+    lv_obj_remove_style_all(s_marker_overlay);
+    lv_obj_set_size(s_marker_overlay, LCD_H_RES, LCD_V_RES);
+    lv_obj_set_pos(s_marker_overlay, 0, 0);
+    lv_obj_remove_flag(s_marker_overlay, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(s_marker_overlay, markers_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+}
+
 static void create_main_screen(void) {
     lv_obj_t *scr = lv_disp_get_scr_act(NULL);
 
     lv_obj_t *map_img = lv_img_create(scr);
+    s_map_img = map_img;
     lv_img_set_src(map_img, &world_480x320);
     lv_obj_set_size(map_img, LCD_H_RES, LCD_V_RES);
+    // Reprojected backgrounds are smaller than the map
+    lv_image_set_inner_align(map_img, LV_IMAGE_ALIGN_STRETCH);
+    lv_image_set_antialias(map_img, false);
     lv_obj_align(map_img, LV_ALIGN_TOP_LEFT, 0, 0);
     lv_obj_add_flag(map_img, LV_OBJ_FLAG_CLICKABLE);
     lv_obj_add_event_cb(map_img, map_touch_cb, LV_EVENT_ALL, NULL);
 
+    ui_coverage_create_overlay(map_img);
+    ui_footprint_create_overlay(map_img);
+    ui_labels_create_overlay(map_img);
+    markers_create_overlay(map_img);
+
     s_satellite_dot = lv_obj_create(map_img);
     lv_obj_remove_style_all(s_satellite_dot);
     lv_obj_set_size(s_satellite_dot, 12, 12);
@@ -99,6 +407,19 @@ static void create_main_screen(void) {
     lv_obj_set_pos(s_satellite_dot, center_x, center_y);
 
     start_satellite_animation();
+
+    s_alert_label = lv_label_create(scr);
+    lv_obj_set_width(s_alert_label, LCD_H_RES - 8);
+    lv_label_set_long_mode(s_alert_label, LV_LABEL_LONG_DOT);
+    lv_obj_set_style_bg_color(s_alert_label, lv_color_hex(0x800000), 0);
+    lv_obj_set_style_bg_opa(s_alert_label, LV_OPA_80, 0);
+    lv_obj_set_style_text_color(s_alert_label, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_pad_hor(s_alert_label, 6, 0);
+    lv_obj_set_style_pad_ver(s_alert_label, 3, 0);
+    lv_obj_align(s_alert_label, LV_ALIGN_BOTTOM_MID, 0, -4);
+    lv_obj_add_flag(s_alert_label, LV_OBJ_FLAG_HIDDEN);
+
+    ui_clock_create(scr);
 }
 
 void ui_init(void) {
@@ -106,7 +427,189 @@ void ui_init(void) {
 
     lvgl_port_lock(0);
     create_main_screen();
+    create_list_screen();
+    s_sky_scr = ui_skyplot_create_screen(s_list_scr);
+    s_plan_scr = ui_timeline_create_screen(s_list_scr);
     lvgl_port_unlock();
 
     ESP_LOGI(TAG, "UI initialized");
 }
+
+ui_sat_marker_t *ui_sat_marker_create(uint32_t norad_id, const char *name) {
+    if (!s_marker_overlay) {
+        ESP_LOGE(TAG, "ui_sat_marker_create: UI not initialized");
+        return NULL;
+    }
+
+    ui_sat_marker_t *marker = calloc(1, sizeof(*marker));
+    if (!marker) {
+        ESP_LOGE(TAG, "ui_sat_marker_create: no mem");
+        return NULL;
+    }
+    marker->norad_id = norad_id;
+    marker->sunlit = true;
+
+    lvgl_port_lock(0);
+    marker->label = ui_labels_add(name);
+    marker->prev = s_marker_tail;
+    if (s_marker_tail) {
+        s_marker_tail->next = marker;
+    } else {
+        s_marker_head = marker;
+    }
+    s_marker_tail = marker;
+    lvgl_port_unlock();
+
+    return marker;
+}
+
+void ui_sat_marker_destroy(ui_sat_marker_t *marker) {
+    if (!marker) {
+        return;
+    }
+    lvgl_port_lock(0);
+    marker_invalidate(marker);
+    if (marker->prev) {
+        marker->prev->next = marker->next;
+    } else {
+        s_marker_head = marker->next;
+    }
+    if (marker->next) {
+        marker->next->prev = marker->prev;
+    } else {
+        s_marker_tail = marker->prev;
+    }
+    ui_labels_remove(marker->label);
+    lvgl_port_unlock();
+    free(marker);
+}
+
+void ui_sat_marker_set_pos(ui_sat_marker_t *marker, int16_t x, int16_t y) {
+    if (!marker || (marker->shown && marker->x == x && marker->y == y)) {
+        return;
+    }
+    lvgl_port_lock(0);
+    marker_invalidate(marker);
+    marker->x = x;
+    marker->y = y;
+    marker->shown = true;
+    marker_invalidate(marker);
+    ui_labels_set_pos(marker->label, x, y);
+    lvgl_port_unlock();
+}
+
+void ui_sat_marker_set_sunlit(ui_sat_marker_t *marker, bool sunlit) {
+    if (!marker || marker->sunlit == sunlit) {
+        return;
+    }
+    lvgl_port_lock(0);
+    marker->sunlit = sunlit;
+    marker_invalidate(marker);
+    lvgl_port_unlock();
+}
+
+void ui_alert_set(const char *text) {
+    if (!s_alert_label) {
+        return;
+    }
+    lvgl_port_lock(0);
+    if (text) {
+        lv_label_set_text(s_alert_label, text);
+        lv_obj_remove_flag(s_alert_label, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(s_alert_label, LV_OBJ_FLAG_HIDDEN);
+    }
+    lvgl_port_unlock();
+}
+
+// Inverse projection per background pixel, sampling the equirectangular source
+static void map_bg_render(const orbit_proj_t *proj, uint16_t *out) {
+    const lv_image_dsc_t *src = &world_480x320;
+    const uint8_t *src_px = src->data;
+    uint32_t src_w = src->header.w, src_h = src->header.h, src_stride = src->header.stride;
+    for (int y = 0; y < MAP_BG_H; y++) {
+        for (int x = 0; x < MAP_BG_W; x++) {
+            double lat, lon;
+            uint16_t px = MAP_BG_SPACE;
+            if (orbit_proj_inverse(proj, (x + 0.5f) * MAP_BG_SCALE, (y + 0.5f) * MAP_BG_SCALE, &lat, &lon)) {
+                uint32_t col = (uint32_t)((lon + 180.0) * src_w / 360.0);
+                uint32_t row = (uint32_t)((90.0 - lat) * src_h / 180.0);
+                col = (col < src_w) ? col : src_w - 1;
+                row = (row < src_h) ? row : src_h - 1;
+                memcpy(&px, src_px + row * src_stride + col * sizeof(uint16_t), sizeof(px));
+            }
+            out[y * MAP_BG_W + x] = px;
+        }
+    }
+}
+
+void ui_map_set_projection(const orbit_proj_t *proj) {
+    if (!s_map_img || !proj) {
+        return;
+    }
+    bool equirect = orbit_proj_kind(proj) == ORBIT_PROJ_EQUIRECT;
+    uint16_t *buf = NULL;
+    if (!equirect) {
+        buf = malloc(MAP_BG_W * MAP_BG_H * sizeof(uint16_t));
+        if (!buf) {
+            ESP_LOGE(TAG, "No mem for the %dx%d map background", MAP_BG_W, MAP_BG_H);
+            return;
+        }
+        // Once per projection, outside the LVGL lock
+        int64_t t0 = esp_timer_get_time();
+        map_bg_render(proj, buf);
+        ESP_LOGI(TAG, "Map background reprojected in %lld ms", (long long)((esp_timer_get_time() - t0) / 1000));
+    }
+
+    lvgl_port_lock(0);
+    if (equirect) {
+        lv_image_set_src(s_map_img, &world_480x320);
+    } else {
+        s_map_bg_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+        s_map_bg_dsc.header.cf = world_480x320.header.cf;
+        s_map_bg_dsc.header.w = MAP_BG_W;
+        s_map_bg_dsc.header.h = MAP_BG_H;
+        s_map_bg_dsc.header.stride = MAP_BG_W * sizeof(uint16_t);
+        s_map_bg_dsc.data = (const uint8_t *)buf;
+        s_map_bg_dsc.data_size = MAP_BG_W * MAP_BG_H * sizeof(uint16_t);
+        lv_image_cache_drop(&s_map_bg_dsc);
+        lv_image_set_src(s_map_img, &s_map_bg_dsc);
+    }
+    free(s_map_bg_buf);
+    s_map_bg_buf = buf;
+    s_map_equirect = equirect;
+    ui_coverage_apply_visibility();
+    lvgl_port_unlock();
+}
+
+bool ui_map_is_equirect(void) {
+    return s_map_equirect;
+}
+
+void ui_sat_list_set_source(size_t count, ui_sat_list_row_cb_t row_cb, void *ctx) {
+    lvgl_port_lock(0);
+    s_list_count = count;
+    s_list_row_cb = row_cb;
+    s_list_row_ctx = ctx;
+    if (s_list_spacer) {
+        lv_obj_set_height(s_list_spacer, (lv_coord_t)(count * SAT_LIST_ROW_H));
+        lv_label_set_text_fmt(s_list_title, "Satellites (%u)", (unsigned)count);
+    }
+    sat_list_update_rows(true);
+    lvgl_port_unlock();
+}
+
+void ui_sat_list_set_select_cb(ui_sat_list_select_cb_t select_cb, void *ctx) {
+    lvgl_port_lock(0);
+    s_list_select_cb = select_cb;
+    s_list_select_ctx = ctx;
+    lvgl_port_unlock();
+}
+
+void ui_sat_list_refresh(void) {
+    lvgl_port_lock(0);
+    if (s_list_scr && lv_screen_active() == s_list_scr) {
+        sat_list_update_rows(true);
+    }
+    lvgl_port_unlock();
+}
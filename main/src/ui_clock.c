@@ -0,0 +1,78 @@
+#include <stdio.h>
+#include <time.h>
+
+#include "esp_log.h"
+
+#include "lvgl.h"
+
+#include "timebase.h"
+#include "ui_priv.h"
+
+static const char *TAG = "ui_clock";
+
+// UTC clock on the map. Tap: next simulation rate (back to real time after the
+// fastest); long press: pause / resume; tap while paused: step CLOCK_STEP_S.
+#define CLOCK_REFRESH_MS 250
+#define CLOCK_STEP_S     60
+
+static const float k_rates[] = {1.0f, 10.0f, 100.0f, 1000.0f, 10000.0f};
+#define N_RATES (sizeof(k_rates) / sizeof(k_rates[0]))
+
+static lv_obj_t *s_clock_label = NULL;
+
+static void clock_refresh(void) {
+    time_t t = (time_t)timebase_now_unix();
+    struct tm tm_utc;
+    gmtime_r(&t, &tm_utc);
+
+    char buf[32];
+    if (!timebase_is_sim()) {
+        snprintf(buf, sizeof(buf), "%02d:%02d:%02d", tm_utc.tm_hour, tm_utc.tm_min, tm_utc.tm_sec);
+    } else {
+        snprintf(buf, sizeof(buf), "%02d-%02d %02d:%02d:%02d %s%.0f", tm_utc.tm_mon + 1, tm_utc.tm_mday,
+                 tm_utc.tm_hour, tm_utc.tm_min, tm_utc.tm_sec, timebase_paused() ? "|| x" : "x",
+                 (double)timebase_rate());
+    }
+    lv_label_set_text(s_clock_label, buf);
+}
+
+static void clock_timer_cb(lv_timer_t *timer) {
+    clock_refresh();
+}
+
+static void clock_event_cb(lv_event_t *e) {
+    lv_event_code_t code = lv_event_get_code(e);
+    if (code == LV_EVENT_LONG_PRESSED) {
+        timebase_set_paused(!timebase_paused());
+    } else if (code == LV_EVENT_SHORT_CLICKED) {
+        if (timebase_paused()) {
+            timebase_step(CLOCK_STEP_S);
+        } else {
+            size_t i = 0;
+            while (i < N_RATES && k_rates[i] != timebase_rate()) {
+                i++;
+            }
+            timebase_set_rate(k_rates[(i + 1) % N_RATES]);
+        }
+    } else {
+        return;
+    }
+    clock_refresh();
+}
+
+void ui_clock_create(lv_obj_t *scr) {
+    s_clock_label = lv_label_create(scr);
+    lv_obj_set_style_bg_color(s_clock_label, lv_color_hex(0x000000), 0);
+    lv_obj_set_style_bg_opa(s_clock_label, LV_OPA_60, 0);
+    lv_obj_set_style_text_color(s_clock_label, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_set_style_pad_hor(s_clock_label, 6, 0);
+    lv_obj_set_style_pad_ver(s_clock_label, 3, 0);
+    lv_obj_align(s_clock_label, LV_ALIGN_TOP_RIGHT, -4, 4);
+    lv_obj_add_flag(s_clock_label, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(s_clock_label, clock_event_cb, LV_EVENT_ALL, NULL);
+
+    clock_refresh();
+    if (!lv_timer_create(clock_timer_cb, CLOCK_REFRESH_MS, NULL)) {
+        ESP_LOGE(TAG, "Clock timer create failed");
+    }
+}
@@ -0,0 +1,143 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+
+#include "board_pins.h"
+#include "ui.h"
+#include "ui_priv.h"
+
+static const char *TAG = "ui_cov";
+
+// Coverage heatmap: a 4-bit indexed image one pixel per grid cell, stretched over
+// the map. Index 0 is transparent, 1..15 a blue -> red ramp relative to the best
+// covered cell.
+#define COV_LEVELS     16
+#define COV_PALETTE_SZ (COV_LEVELS * sizeof(lv_color32_t))
+#define COV_ALPHA      0xA0
+
+static const uint32_t k_ramp[] = {0x2040FF, 0x00C0FF, 0x00E060, 0xFFE000, 0xFF2000};
+#define N_RAMP (sizeof(k_ramp) / sizeof(k_ramp[0]))
+
+static lv_obj_t *s_map_img = NULL;
+static lv_obj_t *s_cov_img = NULL;
+static lv_image_dsc_t s_cov_dsc;
+static uint8_t *s_cov_buf = NULL; // palette, then the pixels
+static size_t s_cov_w = 0;
+static size_t s_cov_h = 0;
+static bool s_cov_visible = false;
+
+static void palette_init(lv_color32_t *pal) {
+    memset(&pal[0], 0, sizeof(pal[0]));
+    for (int i = 1; i < COV_LEVELS; i++) {
+        // Linear interpolation along the ramp stops
+        int pos = (i - 1) * (int)(N_RAMP - 1) * 256 / (COV_LEVELS - 2);
+        int k = pos >> 8, f = pos & 0xFF;
+        uint32_t a = k_ramp[k], b = k_ramp[(k + 1 < (int)N_RAMP) ? k + 1 : k];
+        pal[i].red = (uint8_t)((((a >> 16) & 0xFF) * (256 - f) + ((b >> 16) & 0xFF) * f) >> 8);
+        pal[i].green = (uint8_t)((((a >> 8) & 0xFF) * (256 - f) + ((b >> 8) & 0xFF) * f) >> 8);
+        pal[i].blue = (uint8_t)(((a & 0xFF) * (256 - f) + (b & 0xFF) * f) >> 8);
+        pal[i].alpha = COV_ALPHA;
+    }
+}
+
+static bool image_alloc(size_t w, size_t h) {
+    size_t stride = (w + 1) / 2;
+    uint8_t *buf = calloc(1, COV_PALETTE_SZ + stride * h);
+    if (!buf) {
+        ESP_LOGE(TAG, "No mem for the %ux%u heatmap", (unsigned)w, (unsigned)h);
+        return false;
+    }
+    palette_init((lv_color32_t *)buf);
+    free(s_cov_buf);
+    s_cov_buf = buf;
+    s_cov_w = w;
+    s_cov_h = h;
+
+    s_cov_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    s_cov_dsc.header.cf = LV_COLOR_FORMAT_I4;
+    s_cov_dsc.header.w = w;
+    s_cov_dsc.header.h = h;
+    s_cov_dsc.header.stride = stride;
+    s_cov_dsc.data = buf;
+    s_cov_dsc.data_size = COV_PALETTE_SZ + stride * h;
+
+    if (s_cov_img) {
+        lv_image_set_src(s_cov_img, &s_cov_dsc);
+        return true;
+    }
+    s_cov_img = lv_image_create(s_map_img);
+    lv_image_set_src(s_cov_img, &s_cov_dsc);
+    lv_image_set_inner_align(s_cov_img, LV_IMAGE_ALIGN_STRETCH);
+    lv_image_set_antialias(s_cov_img, false);
+    lv_obj_set_size(s_cov_img, LCD_H_RES, LCD_V_RES);
+    lv_obj_set_pos(s_cov_img, 0, 0);
+    lv_obj_remove_flag(s_cov_img, LV_OBJ_FLAG_CLICKABLE);
+    // Under the footprints and the markers
+    lv_obj_move_to_index(s_cov_img, 0);
+    ui_coverage_apply_visibility();
+    return true;
+}
+
+// The image is created on the first update, once the grid size is known
+void ui_coverage_create_overlay(lv_obj_t *map_img) {
+    s_map_img = map_img;
+}
+
+void ui_coverage_apply_visibility(void) {
+    if (!s_cov_img) {
+        return;
+    }
+    if (s_cov_visible && ui_map_is_equirect()) {
+        lv_obj_remove_flag(s_cov_img, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(s_cov_img, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void ui_coverage_toggle(void) {
+    s_cov_visible = !s_cov_visible;
+    ui_coverage_apply_visibility();
+}
+
+void ui_coverage_update(const uint16_t *cell_minutes, size_t w, size_t h) {
+    if (!s_map_img || !cell_minutes || w == 0 || h == 0) {
+        return;
+    }
+
+    uint16_t max_min = 0;
+    for (size_t c = 0; c < w * h; c++) {
+        max_min = (cell_minutes[c] > max_min) ? cell_minutes[c] : max_min;
+    }
+
+    lvgl_port_lock(0);
+    if ((w != s_cov_w || h != s_cov_h) && !image_alloc(w, h)) {
+        lvgl_port_unlock();
+        return;
+    }
+    size_t stride = (w + 1) / 2;
+    uint32_t range = (max_min > 1) ? max_min - 1 : 1;
+    uint8_t *px = s_cov_buf + COV_PALETTE_SZ;
+    memset(px, 0, stride * h);
+    for (size_t y = 0; y < h; y++) {
+        for (size_t x = 0; x < w; x++) {
+            uint16_t m = cell_minutes[y * w + x];
+            if (m == 0) {
+                continue;
+            }
+            uint8_t level = (uint8_t)(1 + (uint32_t)(m - 1) * (COV_LEVELS - 2) / range);
+            // High nibble is the left pixel
+            px[y * stride + x / 2] |= (x & 1) ? level : (uint8_t)(level << 4);
+        }
+    }
+    lv_image_cache_drop(&s_cov_dsc);
+    if (s_cov_visible && ui_map_is_equirect()) {
+        lv_obj_invalidate(s_cov_img);
+    }
+    lvgl_port_unlock();
+
+    ESP_LOGD(TAG, "Heatmap updated, best cell %u min", (unsigned)max_min);
+}
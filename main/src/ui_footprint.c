@@ -0,0 +1,201 @@
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+
+#include "board_pins.h"
+#include "orbit_footprint.h"
+#include "ui.h"
+#include "ui_priv.h"
+
+static const char *TAG = "ui_fp";
+
+// Footprints are rasterized into a half-resolution A8 mask stretched over the map
+// (38 KB instead of 150 KB) and tinted with the image recolor.
+#define FP_SCALE     2
+#define FP_W         (LCD_H_RES / FP_SCALE)
+#define FP_H         (LCD_V_RES / FP_SCALE)
+#define FP_ALPHA     70
+#define FP_COLOR     0x40C0FF
+#define FP_BUDGET_US 2000
+
+// Span tables keyed by altitude bucket, sub-satellite row and mask elevation.
+// Rows depend on latitude so a table is only reused on the same row; moving in
+// longitude just shifts the spans. At least one slot per footprint so a table
+// looked up in an update can't be evicted by a later one of the same update.
+#define FP_ALT_BUCKET_KM 25.0f
+#define FP_CACHE_SLOTS   UI_FOOTPRINT_MAX
+
+typedef struct {
+    int16_t alt_bucket; // -1 = empty slot
+    int16_t row;
+    float min_el_deg;
+    uint32_t last_use;
+    int16_t half_width[FP_H];
+} fp_spans_t;
+
+static lv_obj_t *s_fp_img = NULL;
+static lv_image_dsc_t s_fp_dsc;
+static uint8_t *s_fp_buf = NULL;
+static fp_spans_t s_cache[FP_CACHE_SLOTS];
+static uint32_t s_use_clock = 0;
+static uint32_t s_cache_hits = 0;
+static uint32_t s_cache_misses = 0;
+static int s_row_min = FP_H; // rows drawn by the previous update
+static int s_row_max = -1;
+
+static const fp_spans_t *spans_get(float alt_km, int row, float min_el_deg) {
+    int16_t bucket = (int16_t)(alt_km / FP_ALT_BUCKET_KM);
+    fp_spans_t *victim = &s_cache[0];
+    s_use_clock++;
+    for (int i = 0; i < FP_CACHE_SLOTS; i++) {
+        fp_spans_t *e = &s_cache[i];
+        if (e->alt_bucket == bucket && e->row == row && e->min_el_deg == min_el_deg) {
+            e->last_use = s_use_clock;
+            s_cache_hits++;
+            return e;
+        }
+        if (e->alt_bucket < 0 || (victim->alt_bucket >= 0 && e->last_use < victim->last_use)) {
+            victim = e;
+        }
+    }
+
+    // Built at the center of the bucket and the row
+    double lat = 90.0 - (row + 0.5) * 180.0 / FP_H;
+    double lam = orbit_footprint_half_angle_rad((bucket + 0.5) * FP_ALT_BUCKET_KM, min_el_deg);
+    orbit_footprint_spans(lat, lam, FP_W, FP_H, victim->half_width);
+    victim->alt_bucket = bucket;
+    victim->row = (int16_t)row;
+    victim->min_el_deg = min_el_deg;
+    victim->last_use = s_use_clock;
+    s_cache_misses++;
+    return victim;
+}
+
+static void add_span(uint8_t *line, int x0, int x1) {
+    for (int x = x0; x <= x1; x++) {
+        int v = line[x] + FP_ALPHA;
+        line[x] = (v > 255) ? 255 : (uint8_t)v;
+    }
+}
+
+// One footprint centered on column cx; spans past either edge wrap around the antimeridian
+static void draw_footprint(const fp_spans_t *sp, int cx, int *row_min, int *row_max) {
+    for (int row = 0; row < FP_H; row++) {
+        int16_t hw = sp->half_width[row];
+        if (hw == ORBIT_FOOTPRINT_NO_ROW) {
+            continue;
+        }
+        uint8_t *line = &s_fp_buf[row * FP_W];
+        *row_min = (row < *row_min) ? row : *row_min;
+        *row_max = (row > *row_max) ? row : *row_max;
+
+        if (hw == ORBIT_FOOTPRINT_FULL_ROW) {
+            add_span(line, 0, FP_W - 1);
+            continue;
+        }
+        int x0 = cx - hw, x1 = cx + hw;
+        if (x0 < 0) {
+            add_span(line, x0 + FP_W, FP_W - 1);
+            x0 = 0;
+        }
+        if (x1 >= FP_W) {
+            add_span(line, 0, x1 - FP_W);
+            x1 = FP_W - 1;
+        }
+        add_span(line, x0, x1);
+    }
+}
+
+void ui_footprint_create_overlay(lv_obj_t *map_img) {
+    for (int i = 0; i < FP_CACHE_SLOTS; i++) {
+        s_cache[i].alt_bucket = -1;
+    }
+
+    s_fp_buf = calloc(FP_W * FP_H, 1);
+    if (!s_fp_buf) {
+        ESP_LOGE(TAG, "No mem for the footprint overlay");
+        return;
+    }
+    s_fp_dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    s_fp_dsc.header.cf = LV_COLOR_FORMAT_A8;
+    s_fp_dsc.header.w = FP_W;
+    s_fp_dsc.header.h = FP_H;
+    s_fp_dsc.header.stride = FP_W;
+    s_fp_dsc.data = s_fp_buf;
+    s_fp_dsc.data_size = FP_W * FP_H;
+
+    s_fp_img = lv_image_create(map_img);
+    lv_image_set_src(s_fp_img, &s_fp_dsc);
+    lv_image_set_inner_align(s_fp_img, LV_IMAGE_ALIGN_STRETCH);
+    lv_image_set_antialias(s_fp_img, false);
+    lv_obj_set_size(s_fp_img, LCD_H_RES, LCD_V_RES);
+    lv_obj_set_pos(s_fp_img, 0, 0);
+    lv_obj_set_style_image_recolor(s_fp_img, lv_color_hex(FP_COLOR), 0);
+    lv_obj_set_style_image_recolor_opa(s_fp_img, LV_OPA_COVER, 0);
+    lv_obj_remove_flag(s_fp_img, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_flag(s_fp_img, LV_OBJ_FLAG_HIDDEN);
+}
+
+void ui_footprint_update(const ui_footprint_t *fps, size_t n, float min_el_deg) {
+    if (!s_fp_img) {
+        return;
+    }
+    // Spans are equirectangular: nothing to draw on other projections
+    n = !ui_map_is_equirect() ? 0 : (n > UI_FOOTPRINT_MAX) ? UI_FOOTPRINT_MAX : n;
+
+    // Span tables (the trigonometry) outside the LVGL lock
+    const fp_spans_t *spans[UI_FOOTPRINT_MAX];
+    int cols[UI_FOOTPRINT_MAX];
+    for (size_t i = 0; i < n; i++) {
+        int row = (int)((90.0f - fps[i].lat_deg) * FP_H / 180.0f);
+        row = (row < 0) ? 0 : (row >= FP_H) ? FP_H - 1 : row;
+        int col = (int)lroundf((fps[i].lon_deg + 180.0f) * FP_W / 360.0f);
+        cols[i] = ((col % FP_W) + FP_W) % FP_W;
+        spans[i] = spans_get(fps[i].alt_km, row, min_el_deg);
+    }
+
+    lvgl_port_lock(0);
+    int64_t t0 = esp_timer_get_time();
+    if (s_row_max >= s_row_min) {
+        memset(&s_fp_buf[s_row_min * FP_W], 0, (size_t)(s_row_max - s_row_min + 1) * FP_W);
+    }
+    int row_min = FP_H, row_max = -1;
+    for (size_t i = 0; i < n; i++) {
+        draw_footprint(spans[i], cols[i], &row_min, &row_max);
+    }
+
+    // Redraw the union of the old and the new bands
+    int inv_min = (row_min < s_row_min) ? row_min : s_row_min;
+    int inv_max = (row_max > s_row_max) ? row_max : s_row_max;
+    s_row_min = row_min;
+    s_row_max = row_max;
+    if (inv_max >= inv_min) {
+        lv_image_cache_drop(&s_fp_dsc);
+        lv_area_t area = {
+            .x1 = 0,
+            .y1 = (int32_t)(inv_min * FP_SCALE),
+            .x2 = LCD_H_RES - 1,
+            .y2 = (int32_t)(inv_max * FP_SCALE + FP_SCALE - 1),
+        };
+        lv_obj_invalidate_area(s_fp_img, &area);
+    }
+    if (row_max >= 0) {
+        lv_obj_remove_flag(s_fp_img, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(s_fp_img, LV_OBJ_FLAG_HIDDEN);
+    }
+    int64_t dt = esp_timer_get_time() - t0;
+    lvgl_port_unlock();
+
+    ESP_LOGD(TAG, "%u footprints in %lld us (span cache %u hits, %u misses)", (unsigned)n, (long long)dt,
+             (unsigned)s_cache_hits, (unsigned)s_cache_misses);
+    if (dt > FP_BUDGET_US) {
+        ESP_LOGW(TAG, "%u footprints took %lld us, budget %d us", (unsigned)n, (long long)dt, FP_BUDGET_US);
+    }
+}
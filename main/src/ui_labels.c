@@ -0,0 +1,363 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+
+#include "board_pins.h"
+#include "ui_priv.h"
+
+static const char *TAG = "ui_lbl";
+
+// Satellite name tags. Names are rasterized once into A8 bitmaps (through a scratch
+// ARGB8888 canvas, keeping only the coverage) and blitted by one overlay object.
+// The bitmaps live in a byte-bounded cache: filled at load while it has room, then
+// refilled least recently shown first for the tags that get placed.
+#define LABEL_FONT        (&lv_font_montserrat_14)
+#define LABEL_MAX_W       96 // longer names are clipped
+#define LABEL_MAX_H       16
+#define LABEL_DX          6 // gap right of the marker center
+#define LABEL_COLOR       0xE8E8E8
+#define LABEL_CACHE_BYTES (24 * 1024)
+#define LABEL_LAYOUT_MS   100
+#define LABEL_RENDER_MAX  8 // bitmaps rendered per layout pass
+#define LABEL_LOG_US      (60 * 1000000LL)
+
+// Collision culling on a coarse occupancy grid: a tag touching a cell claimed by
+// an earlier tag is skipped
+#define GRID_CELL  4
+#define GRID_W     ((LCD_H_RES + GRID_CELL - 1) / GRID_CELL)
+#define GRID_H     ((LCD_V_RES + GRID_CELL - 1) / GRID_CELL)
+#define LABEL_NONE INT16_MIN
+
+struct ui_map_label_t {
+    ui_map_label_t *prev;
+    ui_map_label_t *next;
+    char name[UI_LABEL_NAME_LEN];
+    int16_t x; // marker center, LABEL_NONE until placed
+    int16_t y;
+    int16_t w;       // bitmap width, measured before rendering
+    lv_area_t shown; // drawn area of the last layout
+    bool is_shown;
+    bool wanted; // placed by the last layout without a bitmap
+    uint32_t last_use;
+    lv_image_dsc_t dsc; // data == NULL while not cached
+};
+
+static lv_obj_t *s_overlay = NULL;
+static lv_obj_t *s_canvas = NULL;
+LV_DRAW_BUF_DEFINE_STATIC(s_canvas_buf, LABEL_MAX_W, LABEL_MAX_H, LV_COLOR_FORMAT_ARGB8888);
+static int16_t s_label_h = LABEL_MAX_H;
+
+static ui_map_label_t *s_head = NULL;
+static ui_map_label_t *s_tail = NULL;
+static uint8_t s_grid[GRID_H][(GRID_W + 7) / 8];
+static bool s_layout_due = false;
+static uint32_t s_use_clock = 0;
+
+static struct {
+    size_t labels;
+    size_t cached;
+    size_t cache_bytes;
+    uint32_t shown;
+    uint32_t culled;
+    uint32_t uncached; // placed but over the cache budget
+    uint32_t renders;
+    uint32_t evictions;
+    int64_t last_log_us;
+} s_stats;
+
+static int16_t measure(const char *name) {
+    int w = 0;
+    for (const char *c = name; *c && w < LABEL_MAX_W; c++) {
+        w += lv_font_get_glyph_width(LABEL_FONT, (uint8_t)c[0], (uint8_t)c[1]);
+    }
+    return (int16_t)((w < LABEL_MAX_W) ? w : LABEL_MAX_W);
+}
+
+static void bitmap_free(ui_map_label_t *l) {
+    if (!l->dsc.data) {
+        return;
+    }
+    lv_image_cache_drop(&l->dsc);
+    free((void *)l->dsc.data);
+    l->dsc.data = NULL;
+    s_stats.cached--;
+    s_stats.cache_bytes -= l->dsc.data_size;
+}
+
+// Least recently shown bitmap, never one placed by the current layout
+static bool evict_one(void) {
+    ui_map_label_t *victim = NULL;
+    for (ui_map_label_t *l = s_head; l; l = l->next) {
+        if (l->dsc.data && !l->is_shown && (!victim || l->last_use < victim->last_use)) {
+            victim = l;
+        }
+    }
+    if (!victim) {
+        return false;
+    }
+    bitmap_free(victim);
+    s_stats.evictions++;
+    return true;
+}
+
+// LVGL lock held
+static bool render(ui_map_label_t *l, bool may_evict) {
+    size_t size = (size_t)l->w * s_label_h;
+    while (s_stats.cache_bytes + size > LABEL_CACHE_BYTES) {
+        if (!may_evict || !evict_one()) {
+            return false;
+        }
+    }
+    uint8_t *bmp = malloc(size ? size : 1);
+    if (!bmp) {
+        return false;
+    }
+
+    lv_canvas_fill_bg(s_canvas, lv_color_black(), LV_OPA_TRANSP);
+    lv_layer_t layer;
+    lv_canvas_init_layer(s_canvas, &layer);
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.font = LABEL_FONT;
+    dsc.color = lv_color_white();
+    dsc.text = l->name;
+    dsc.flag = LV_TEXT_FLAG_EXPAND; // one line, clipped by the canvas
+    lv_area_t area = {0, 0, LABEL_MAX_W - 1, s_label_h - 1};
+    lv_draw_label(&layer, &dsc, &area);
+    lv_canvas_finish_layer(s_canvas, &layer);
+
+    for (int y = 0; y < s_label_h; y++) {
+        const lv_color32_t *row = (const lv_color32_t *)(s_canvas_buf.data + y * s_canvas_buf.header.stride);
+        for (int x = 0; x < l->w; x++) {
+            bmp[y * l->w + x] = row[x].alpha;
+        }
+    }
+
+    l->dsc.header.magic = LV_IMAGE_HEADER_MAGIC;
+    l->dsc.header.cf = LV_COLOR_FORMAT_A8;
+    l->dsc.header.w = l->w;
+    l->dsc.header.h = s_label_h;
+    l->dsc.header.stride = l->w;
+    l->dsc.data_size = size;
+    l->dsc.data = bmp;
+    s_stats.cached++;
+    s_stats.cache_bytes += size;
+    s_stats.renders++;
+    return true;
+}
+
+// Claims the cells under area, or nothing if any is taken
+static bool grid_claim(const lv_area_t *area) {
+    int cx0 = area->x1 / GRID_CELL, cx1 = area->x2 / GRID_CELL;
+    int cy0 = area->y1 / GRID_CELL, cy1 = area->y2 / GRID_CELL;
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            if (s_grid[cy][cx / 8] & (1u << (cx % 8))) {
+                return false;
+            }
+        }
+    }
+    for (int cy = cy0; cy <= cy1; cy++) {
+        for (int cx = cx0; cx <= cx1; cx++) {
+            s_grid[cy][cx / 8] |= (uint8_t)(1u << (cx % 8));
+        }
+    }
+    return true;
+}
+
+// Right of the marker, or left of it at the right edge; false when off the map
+static bool place(const ui_map_label_t *l, lv_area_t *area) {
+    if (l->x == LABEL_NONE || l->w == 0) {
+        return false;
+    }
+    int x1 = l->x + LABEL_DX;
+    if (x1 + l->w > LCD_H_RES) {
+        x1 = l->x - LABEL_DX - l->w;
+    }
+    int y1 = l->y - s_label_h / 2;
+    if (x1 < 0 || y1 < 0 || y1 + s_label_h > LCD_V_RES) {
+        return false;
+    }
+    *area = (lv_area_t){.x1 = x1, .y1 = y1, .x2 = x1 + l->w - 1, .y2 = y1 + s_label_h - 1};
+    return true;
+}
+
+// Greedy placement in list order; only tags whose drawn area changed are invalidated
+static void layout(void) {
+    memset(s_grid, 0, sizeof(s_grid));
+    s_use_clock++;
+    s_stats.shown = s_stats.culled = s_stats.uncached = 0;
+    size_t n_wanted = 0;
+    for (ui_map_label_t *l = s_head; l; l = l->next) {
+        lv_area_t area = {0};
+        bool shown = place(l, &area) && grid_claim(&area);
+        if (shown && !l->dsc.data) {
+            // Keeps its cells so the layout doesn't depend on the cache
+            l->wanted = true;
+            n_wanted++;
+            shown = false;
+        } else {
+            l->wanted = false;
+        }
+        if (shown) {
+            l->last_use = s_use_clock;
+            s_stats.shown++;
+        } else if (l->x != LABEL_NONE && !l->wanted) {
+            s_stats.culled++;
+        }
+        if (l->is_shown && (!shown || !lv_area_is_equal(&area, &l->shown))) {
+            lv_obj_invalidate_area(s_overlay, &l->shown);
+        }
+        if (shown && (!l->is_shown || !lv_area_is_equal(&area, &l->shown))) {
+            lv_obj_invalidate_area(s_overlay, &area);
+        }
+        l->is_shown = shown;
+        l->shown = shown ? area : l->shown;
+    }
+
+    // A few bitmaps per pass; the rest show up on the next ones
+    int budget = LABEL_RENDER_MAX;
+    for (ui_map_label_t *l = s_head; l && n_wanted > 0 && budget > 0; l = l->next) {
+        if (!l->wanted) {
+            continue;
+        }
+        n_wanted--;
+        budget--;
+        if (!render(l, true)) {
+            s_stats.uncached++;
+            continue;
+        }
+        l->wanted = false;
+        l->is_shown = place(l, &l->shown);
+        l->last_use = s_use_clock;
+        s_stats.shown++;
+        lv_obj_invalidate_area(s_overlay, &l->shown);
+    }
+    s_stats.uncached += n_wanted;
+    s_layout_due = n_wanted > 0;
+}
+
+static void layout_timer_cb(lv_timer_t *timer) {
+    if (s_layout_due) {
+        s_layout_due = false;
+        layout();
+    }
+
+    int64_t now_us = esp_timer_get_time();
+    if (now_us - s_stats.last_log_us >= LABEL_LOG_US) {
+        s_stats.last_log_us = now_us;
+        ESP_LOGI(TAG,
+                 "Label cache %u / %u bytes in %u bitmaps (+%u B of %u tags), %u shown, %u culled, %u over budget, "
+                 "%lu renders, %lu evictions",
+                 (unsigned)s_stats.cache_bytes, (unsigned)LABEL_CACHE_BYTES, (unsigned)s_stats.cached,
+                 (unsigned)(s_stats.labels * sizeof(ui_map_label_t)), (unsigned)s_stats.labels,
+                 (unsigned)s_stats.shown, (unsigned)s_stats.culled, (unsigned)s_stats.uncached,
+                 (unsigned long)s_stats.renders, (unsigned long)s_stats.evictions);
+    }
+}
+
+// Blits the cached bitmaps placed by the last layout; LVGL clips them to the redrawn area
+static void overlay_draw_cb(lv_event_t *e) {
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_area_t coords;
+    lv_obj_get_coords(s_overlay, &coords);
+
+    lv_draw_image_dsc_t dsc;
+    lv_draw_image_dsc_init(&dsc);
+    dsc.recolor = lv_color_hex(LABEL_COLOR);
+    dsc.recolor_opa = LV_OPA_COVER;
+    for (ui_map_label_t *l = s_head; l; l = l->next) {
+        if (!l->is_shown || !l->dsc.data) {
+            continue;
+        }
+        lv_area_t area = l->shown;
+        lv_area_move(&area, coords.x1, coords.y1);
+        dsc.src = &l->dsc;
+        lv_draw_image(layer, &dsc, &area);
+    }
+}
+
+void ui_labels_create_overlay(lv_obj_t *map_img) {
+    s_overlay = lv_obj_create(map_img);
+    lv_obj_remove_style_all(s_overlay);
+    lv_obj_set_size(s_overlay, LCD_H_RES, LCD_V_RES);
+    lv_obj_set_pos(s_overlay, 0, 0);
+    lv_obj_remove_flag(s_overlay, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(s_overlay, overlay_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    LV_DRAW_BUF_INIT_STATIC(s_canvas_buf);
+    s_canvas = lv_canvas_create(s_overlay);
+    lv_canvas_set_draw_buf(s_canvas, &s_canvas_buf);
+    lv_obj_add_flag(s_canvas, LV_OBJ_FLAG_HIDDEN);
+    int32_t line_h = lv_font_get_line_height(LABEL_FONT);
+    s_label_h = (int16_t)((line_h < LABEL_MAX_H) ? line_h : LABEL_MAX_H);
+
+    s_stats.last_log_us = esp_timer_get_time();
+    if (!lv_timer_create(layout_timer_cb, LABEL_LAYOUT_MS, NULL)) {
+        ESP_LOGE(TAG, "Label timer create failed");
+    }
+}
+
+ui_map_label_t *ui_labels_add(const char *name) {
+    if (!s_overlay || !name || !name[0]) {
+        return NULL;
+    }
+    ui_map_label_t *l = calloc(1, sizeof(*l));
+    if (!l) {
+        ESP_LOGE(TAG, "ui_labels_add: no mem");
+        return NULL;
+    }
+    strlcpy(l->name, name, sizeof(l->name));
+    l->x = LABEL_NONE;
+    l->y = LABEL_NONE;
+    l->w = measure(l->name);
+    // Rendered at load while the cache has room; later ones when first placed
+    render(l, false);
+
+    l->prev = s_tail;
+    if (s_tail) {
+        s_tail->next = l;
+    } else {
+        s_head = l;
+    }
+    s_tail = l;
+    s_stats.labels++;
+    return l;
+}
+
+void ui_labels_remove(ui_map_label_t *label) {
+    if (!label) {
+        return;
+    }
+    if (label->is_shown) {
+        lv_obj_invalidate_area(s_overlay, &label->shown);
+    }
+    bitmap_free(label);
+    if (label->prev) {
+        label->prev->next = label->next;
+    } else {
+        s_head = label->next;
+    }
+    if (label->next) {
+        label->next->prev = label->prev;
+    } else {
+        s_tail = label->prev;
+    }
+    s_stats.labels--;
+    s_layout_due = true;
+    free(label);
+}
+
+void ui_labels_set_pos(ui_map_label_t *label, int16_t x, int16_t y) {
+    if (!label || (label->x == x && label->y == y)) {
+        return;
+    }
+    label->x = x;
+    label->y = y;
+    s_layout_due = true;
+}
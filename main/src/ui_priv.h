@@ -0,0 +1,37 @@
+#pragma once
+
+#include "lvgl.h"
+
+// Screens living in their own ui_*.c files. back_scr is loaded by their back button.
+lv_obj_t *ui_skyplot_create_screen(lv_obj_t *back_scr);
+lv_obj_t *ui_timeline_create_screen(lv_obj_t *back_scr);
+
+// Footprint overlay (ui_footprint.c), a child of the map image. Create it before
+// the markers so they stay on top.
+void ui_footprint_create_overlay(lv_obj_t *map_img);
+
+// Satellite name tags (ui_labels.c), an overlay of the map image above the
+// footprints. Names are pre-rendered into a bounded LRU cache of A8 bitmaps and
+// tags overlapping an earlier one are skipped. LVGL lock held for all of these.
+#define UI_LABEL_NAME_LEN 25
+
+typedef struct ui_map_label_t ui_map_label_t;
+
+void ui_labels_create_overlay(lv_obj_t *map_img);
+ui_map_label_t *ui_labels_add(const char *name);
+void ui_labels_remove(ui_map_label_t *label);
+// Marker center; the tag goes right of it
+void ui_labels_set_pos(ui_map_label_t *label, int16_t x, int16_t y);
+
+// Coverage heatmap (ui_coverage.c), a child of the map image below the footprints.
+// A short tap on the map shows / hides it.
+void ui_coverage_create_overlay(lv_obj_t *map_img);
+void ui_coverage_toggle(void);
+// Re-applies the shown / hidden state after a projection change
+void ui_coverage_apply_visibility(void);
+
+// The map background is the equirectangular source image (ui.c)
+bool ui_map_is_equirect(void);
+
+// Simulation clock label and controls on the map screen (ui_clock.c)
+void ui_clock_create(lv_obj_t *scr);
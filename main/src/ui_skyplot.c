@@ -0,0 +1,215 @@
+#include <math.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "esp_log.h"
+
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+
+#include "board_pins.h"
+#include "ui.h"
+#include "ui_priv.h"
+
+static const char *TAG = "ui_sky";
+
+#define SKY_CX     160
+#define SKY_CY     160
+#define SKY_R      148
+#define SKY_DOT    10
+#define SKY_INFO_X 324
+
+typedef struct {
+    lv_obj_t *arc;
+    lv_obj_t *dot;
+    lv_obj_t *info;
+    lv_obj_t *doppler;
+    lv_point_precise_t pts[UI_SKYPLOT_ARC_POINTS]; // cached projection, referenced by the lv_line
+} sky_slot_t;
+
+static const uint32_t s_slot_colors[UI_SKYPLOT_SLOTS] = {0xFF5050, 0x50FF50, 0x50A0FF, 0xFFD000};
+
+static lv_obj_t *s_sky_scr = NULL;
+static lv_obj_t *s_back_scr = NULL;
+static sky_slot_t s_slots[UI_SKYPLOT_SLOTS];
+
+static void sky_project(float az_deg, float el_deg, lv_value_precise_t *x, lv_value_precise_t *y) {
+    if (el_deg < 0.0f) {
+        el_deg = 0.0f;
+    }
+    float r = SKY_R * (90.0f - el_deg) / 90.0f;
+    float az = az_deg * (float)M_PI / 180.0f;
+    *x = (lv_value_precise_t)(SKY_CX + r * sinf(az));
+    *y = (lv_value_precise_t)(SKY_CY - r * cosf(az));
+}
+
+static void sky_back_cb(lv_event_t *e) {
+    lv_screen_load(s_back_scr);
+}
+
+static void sky_ring(lv_obj_t *parent, int r) {
+    lv_obj_t *ring = lv_obj_create(parent);
+    lv_obj_remove_style_all(ring);
+    lv_obj_set_size(ring, 2 * r, 2 * r);
+    lv_obj_set_pos(ring, SKY_CX - r, SKY_CY - r);
+    lv_obj_set_style_radius(ring, LV_RADIUS_CIRCLE, 0);
+    lv_obj_set_style_border_width(ring, 1, 0);
+    lv_obj_set_style_border_color(ring, lv_color_hex(0x406080), 0);
+    lv_obj_remove_flag(ring, LV_OBJ_FLAG_CLICKABLE);
+}
+
+static void sky_axis_label(lv_obj_t *parent, const char *txt, int x, int y) {
+    lv_obj_t *label = lv_label_create(parent);
+    lv_label_set_text(label, txt);
+    lv_obj_set_style_text_color(label, lv_color_hex(0x8090A0), 0);
+    lv_obj_set_pos(label, x, y);
+}
+
+lv_obj_t *ui_skyplot_create_screen(lv_obj_t *back_scr) {
+    static lv_point_precise_t s_axis_h[2] = {{SKY_CX - SKY_R, SKY_CY}, {SKY_CX + SKY_R, SKY_CY}};
+    static lv_point_precise_t s_axis_v[2] = {{SKY_CX, SKY_CY - SKY_R}, {SKY_CX, SKY_CY + SKY_R}};
+
+    s_back_scr = back_scr;
+    s_sky_scr = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(s_sky_scr, lv_color_hex(0x101418), 0);
+    lv_obj_remove_flag(s_sky_scr, LV_OBJ_FLAG_SCROLLABLE);
+
+    // Static grid: horizon, 30 and 60 deg rings, N-S / E-W axes
+    sky_ring(s_sky_scr, SKY_R);
+    sky_ring(s_sky_scr, SKY_R * 2 / 3);
+    sky_ring(s_sky_scr, SKY_R / 3);
+    lv_obj_t *axis = lv_line_create(s_sky_scr);
+    lv_line_set_points(axis, s_axis_h, 2);
+    lv_obj_set_style_line_color(axis, lv_color_hex(0x406080), 0);
+    axis = lv_line_create(s_sky_scr);
+    lv_line_set_points(axis, s_axis_v, 2);
+    lv_obj_set_style_line_color(axis, lv_color_hex(0x406080), 0);
+    sky_axis_label(s_sky_scr, "N", SKY_CX + 4, SKY_CY - SKY_R);
+    sky_axis_label(s_sky_scr, "E", SKY_CX + SKY_R - 12, SKY_CY + 2);
+    sky_axis_label(s_sky_scr, "S", SKY_CX + 4, SKY_CY + SKY_R - 16);
+    sky_axis_label(s_sky_scr, "W", SKY_CX - SKY_R + 2, SKY_CY + 2);
+
+    for (int i = 0; i < UI_SKYPLOT_SLOTS; i++) {
+        sky_slot_t *slot = &s_slots[i];
+        lv_color_t color = lv_color_hex(s_slot_colors[i]);
+
+        slot->arc = lv_line_create(s_sky_scr);
+        lv_obj_set_style_line_color(slot->arc, color, 0);
+        lv_obj_set_style_line_width(slot->arc, 2, 0);
+        lv_obj_add_flag(slot->arc, LV_OBJ_FLAG_HIDDEN);
+
+        slot->dot = lv_obj_create(s_sky_scr);
+        lv_obj_remove_style_all(slot->dot);
+        lv_obj_set_size(slot->dot, SKY_DOT, SKY_DOT);
+        lv_obj_set_style_radius(slot->dot, LV_RADIUS_CIRCLE, 0);
+        lv_obj_set_style_bg_color(slot->dot, color, 0);
+        lv_obj_set_style_bg_opa(slot->dot, LV_OPA_COVER, 0);
+        lv_obj_set_style_border_width(slot->dot, 1, 0);
+        lv_obj_set_style_border_color(slot->dot, lv_color_hex(0xFFFFFF), 0);
+        lv_obj_add_flag(slot->dot, LV_OBJ_FLAG_HIDDEN);
+
+        slot->info = lv_label_create(s_sky_scr);
+        lv_obj_set_width(slot->info, LCD_H_RES - SKY_INFO_X - 4);
+        lv_obj_set_pos(slot->info, SKY_INFO_X, 40 + i * 64);
+        lv_obj_set_style_text_color(slot->info, color, 0);
+        lv_label_set_text(slot->info, "");
+
+        // Fourth line under the pass info
+        slot->doppler = lv_label_create(s_sky_scr);
+        lv_obj_set_pos(slot->doppler, SKY_INFO_X, 40 + i * 64 + 48);
+        lv_obj_set_style_text_color(slot->doppler, color, 0);
+        lv_obj_add_flag(slot->doppler, LV_OBJ_FLAG_HIDDEN);
+    }
+
+    lv_obj_t *back = lv_button_create(s_sky_scr);
+    lv_obj_set_size(back, 64, 28);
+    lv_obj_align(back, LV_ALIGN_TOP_RIGHT, -2, 2);
+    lv_obj_add_event_cb(back, sky_back_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *back_label = lv_label_create(back);
+    lv_label_set_text(back_label, "List");
+    lv_obj_center(back_label);
+
+    return s_sky_scr;
+}
+
+static void fmt_hhmm(char *buf, size_t len, int64_t unix_time) {
+    time_t t = (time_t)unix_time;
+    struct tm tm_utc;
+    gmtime_r(&t, &tm_utc);
+    snprintf(buf, len, "%02d:%02d", tm_utc.tm_hour, tm_utc.tm_min);
+}
+
+void ui_skyplot_set_pass(int slot_idx, const char *name, const ui_azel_t *arc, size_t n, int64_t aos_unix,
+                         int64_t los_unix, float max_el_deg) {
+    if (slot_idx < 0 || slot_idx >= UI_SKYPLOT_SLOTS || !arc || n < 2 || !s_sky_scr) {
+        ESP_LOGE(TAG, "ui_skyplot_set_pass: invalid args");
+        return;
+    }
+    if (n > UI_SKYPLOT_ARC_POINTS) {
+        n = UI_SKYPLOT_ARC_POINTS;
+    }
+
+    lvgl_port_lock(0);
+    sky_slot_t *slot = &s_slots[slot_idx];
+    for (size_t i = 0; i < n; i++) {
+        sky_project(arc[i].az_deg, arc[i].el_deg, &slot->pts[i].x, &slot->pts[i].y);
+    }
+    lv_line_set_points(slot->arc, slot->pts, (uint32_t)n);
+    lv_obj_remove_flag(slot->arc, LV_OBJ_FLAG_HIDDEN);
+
+    char aos[8], los[8];
+    fmt_hhmm(aos, sizeof(aos), aos_unix);
+    fmt_hhmm(los, sizeof(los), los_unix);
+    lv_label_set_text_fmt(slot->info, "%s\nAOS %s LOS %s\nmax el %d", name ? name : "", aos, los, (int)max_el_deg);
+    lvgl_port_unlock();
+}
+
+void ui_skyplot_clear(int slot_idx) {
+    if (slot_idx < 0 || slot_idx >= UI_SKYPLOT_SLOTS || !s_sky_scr) {
+        return;
+    }
+
+    lvgl_port_lock(0);
+    sky_slot_t *slot = &s_slots[slot_idx];
+    lv_obj_add_flag(slot->arc, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(slot->dot, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(slot->doppler, LV_OBJ_FLAG_HIDDEN);
+    lv_label_set_text(slot->info, "");
+    lvgl_port_unlock();
+}
+
+void ui_skyplot_set_doppler(int slot_idx, bool valid, int32_t shift_hz) {
+    if (slot_idx < 0 || slot_idx >= UI_SKYPLOT_SLOTS || !s_sky_scr) {
+        return;
+    }
+
+    lvgl_port_lock(0);
+    sky_slot_t *slot = &s_slots[slot_idx];
+    if (!valid) {
+        lv_obj_add_flag(slot->doppler, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        char buf[24];
+        snprintf(buf, sizeof(buf), "Doppler %+.2f kHz", shift_hz / 1000.0);
+        lv_label_set_text(slot->doppler, buf);
+        lv_obj_remove_flag(slot->doppler, LV_OBJ_FLAG_HIDDEN);
+    }
+    lvgl_port_unlock();
+}
+
+void ui_skyplot_set_marker(int slot_idx, float az_deg, float el_deg) {
+    if (slot_idx < 0 || slot_idx >= UI_SKYPLOT_SLOTS || !s_sky_scr) {
+        return;
+    }
+
+    lvgl_port_lock(0);
+    sky_slot_t *slot = &s_slots[slot_idx];
+    if (el_deg < 0.0f) {
+        lv_obj_add_flag(slot->dot, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_value_precise_t x, y;
+        sky_project(az_deg, el_deg, &x, &y);
+        lv_obj_set_pos(slot->dot, (lv_coord_t)x - SKY_DOT / 2, (lv_coord_t)y - SKY_DOT / 2);
+        lv_obj_remove_flag(slot->dot, LV_OBJ_FLAG_HIDDEN);
+    }
+    lvgl_port_unlock();
+}
@@ -0,0 +1,246 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "esp_log.h"
+
+#include "esp_lvgl_port.h"
+#include "lvgl.h"
+
+#include "board_pins.h"
+#include "ui.h"
+#include "ui_priv.h"
+
+static const char *TAG = "ui_plan";
+
+// Time strip: one column per TL_W-th of the window. Top lane: tracked passes,
+// bottom lane: the others, brighter where more of them overlap.
+#define TL_X        4
+#define TL_W        (LCD_H_RES - 2 * TL_X)
+#define TL_HEADER_H 32
+#define TL_TICK_Y   (TL_HEADER_H + 4)
+#define TL_LANE0_Y  (TL_HEADER_H + 24)
+#define TL_LANE0_H  20
+#define TL_LANE1_Y  (TL_LANE0_Y + TL_LANE0_H + 4)
+#define TL_LANE1_H  12
+#define TL_LIST_Y   (TL_LANE1_Y + TL_LANE1_H + 8)
+#define TL_TICK_S   (3 * 3600)
+#define TL_TICKS    9
+#define TL_LINE_LEN 64
+
+#define TL_COLOR_TRACKED  0x50A0FF
+#define TL_COLOR_PRIORITY 0xFFD000
+#define TL_COLOR_OTHER    0x8090A0
+
+static lv_obj_t *s_plan_scr = NULL;
+static lv_obj_t *s_back_scr = NULL;
+static lv_obj_t *s_title = NULL;
+static lv_obj_t *s_strip = NULL;
+static lv_obj_t *s_now = NULL;
+static lv_obj_t *s_list = NULL;
+static lv_obj_t *s_ticks[TL_TICKS];
+static int64_t s_start = 0;
+static int64_t s_end = 0;
+// Per column: lane 0 is 0 (free), 1 (tracked) or 2 (tracked, priority);
+// lane 1 counts the other passes
+static uint8_t s_cols[2][TL_W];
+
+static void plan_back_cb(lv_event_t *e) {
+    lv_screen_load(s_back_scr);
+}
+
+static int col_of(int64_t t) {
+    int64_t x = (t - s_start) * TL_W / (s_end - s_start);
+    return (x < 0) ? 0 : (x >= TL_W) ? TL_W - 1 : (int)x;
+}
+
+// Runs of equal columns as rectangles
+static void strip_draw_cb(lv_event_t *e) {
+    lv_layer_t *layer = lv_event_get_layer(e);
+    lv_area_t coords;
+    lv_obj_get_coords(s_strip, &coords);
+
+    lv_draw_rect_dsc_t dsc;
+    lv_draw_rect_dsc_init(&dsc);
+    for (int lane = 0; lane < 2; lane++) {
+        int32_t y1 = coords.y1 + (lane ? TL_LANE1_Y - TL_LANE0_Y : 0);
+        int32_t y2 = y1 + (lane ? TL_LANE1_H : TL_LANE0_H) - 1;
+        for (int x = 0; x < TL_W;) {
+            uint8_t v = s_cols[lane][x];
+            int x_end = x + 1;
+            while (x_end < TL_W && s_cols[lane][x_end] == v) {
+                x_end++;
+            }
+            if (v) {
+                if (lane == 0) {
+                    dsc.bg_color = lv_color_hex(v == 2 ? TL_COLOR_PRIORITY : TL_COLOR_TRACKED);
+                    dsc.bg_opa = LV_OPA_COVER;
+                } else {
+                    dsc.bg_color = lv_color_hex(TL_COLOR_OTHER);
+                    dsc.bg_opa = (v >= 4) ? LV_OPA_COVER : (lv_opa_t)(LV_OPA_30 + v * LV_OPA_20);
+                }
+                lv_area_t area = {coords.x1 + x, y1, coords.x1 + x_end - 1, y2};
+                lv_draw_rect(layer, &dsc, &area);
+            }
+            x = x_end;
+        }
+    }
+}
+
+lv_obj_t *ui_timeline_create_screen(lv_obj_t *back_scr) {
+    s_back_scr = back_scr;
+    s_plan_scr = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(s_plan_scr, lv_color_hex(0x101418), 0);
+    lv_obj_remove_flag(s_plan_scr, LV_OBJ_FLAG_SCROLLABLE);
+
+    s_title = lv_label_create(s_plan_scr);
+    lv_obj_set_style_text_color(s_title, lv_color_hex(0xFFFFFF), 0);
+    lv_obj_align(s_title, LV_ALIGN_TOP_LEFT, 8, 8);
+    lv_label_set_text(s_title, "Antenna plan: predicting passes");
+
+    for (int i = 0; i < TL_TICKS; i++) {
+        s_ticks[i] = lv_label_create(s_plan_scr);
+        lv_obj_set_style_text_color(s_ticks[i], lv_color_hex(0x8090A0), 0);
+        lv_obj_add_flag(s_ticks[i], LV_OBJ_FLAG_HIDDEN);
+    }
+
+    s_strip = lv_obj_create(s_plan_scr);
+    lv_obj_remove_style_all(s_strip);
+    lv_obj_set_size(s_strip, TL_W, TL_LANE1_Y + TL_LANE1_H - TL_LANE0_Y);
+    lv_obj_set_pos(s_strip, TL_X, TL_LANE0_Y);
+    lv_obj_set_style_border_width(s_strip, 1, 0);
+    lv_obj_set_style_border_color(s_strip, lv_color_hex(0x406080), 0);
+    lv_obj_set_style_border_side(s_strip, LV_BORDER_SIDE_BOTTOM, 0);
+    lv_obj_remove_flag(s_strip, LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_add_event_cb(s_strip, strip_draw_cb, LV_EVENT_DRAW_MAIN, NULL);
+
+    s_now = lv_obj_create(s_plan_scr);
+    lv_obj_remove_style_all(s_now);
+    lv_obj_set_size(s_now, 2, TL_LANE1_Y + TL_LANE1_H - TL_LANE0_Y + 8);
+    lv_obj_set_style_bg_color(s_now, lv_color_hex(0xFF5050), 0);
+    lv_obj_set_style_bg_opa(s_now, LV_OPA_COVER, 0);
+    lv_obj_add_flag(s_now, LV_OBJ_FLAG_HIDDEN);
+
+    // Tracked passes, one line each, in a scrolling container
+    lv_obj_t *cont = lv_obj_create(s_plan_scr);
+    lv_obj_remove_style_all(cont);
+    lv_obj_set_size(cont, LCD_H_RES - 2 * TL_X, LCD_V_RES - TL_LIST_Y);
+    lv_obj_set_pos(cont, TL_X, TL_LIST_Y);
+    lv_obj_set_scroll_dir(cont, LV_DIR_VER);
+    s_list = lv_label_create(cont);
+    lv_obj_set_width(s_list, LCD_H_RES - 2 * TL_X);
+    lv_obj_set_style_text_color(s_list, lv_color_hex(0xFFFFFF), 0);
+    lv_label_set_text(s_list, "");
+
+    lv_obj_t *back = lv_button_create(s_plan_scr);
+    lv_obj_set_size(back, 64, 28);
+    lv_obj_align(back, LV_ALIGN_TOP_RIGHT, -2, 2);
+    lv_obj_add_event_cb(back, plan_back_cb, LV_EVENT_CLICKED, NULL);
+    lv_obj_t *back_label = lv_label_create(back);
+    lv_label_set_text(back_label, "List");
+    lv_obj_center(back_label);
+
+    return s_plan_scr;
+}
+
+static void fmt_hhmm(char *buf, size_t len, int64_t unix_time) {
+    time_t t = (time_t)unix_time;
+    struct tm tm_utc;
+    gmtime_r(&t, &tm_utc);
+    snprintf(buf, len, "%02d:%02d", tm_utc.tm_hour, tm_utc.tm_min);
+}
+
+// Hour labels on the UTC multiples of TL_TICK_S inside the window
+static void ticks_place(void) {
+    int64_t t = (s_start + TL_TICK_S - 1) / TL_TICK_S * TL_TICK_S;
+    for (int i = 0; i < TL_TICKS; i++, t += TL_TICK_S) {
+        if (t >= s_end) {
+            lv_obj_add_flag(s_ticks[i], LV_OBJ_FLAG_HIDDEN);
+            continue;
+        }
+        char buf[8];
+        fmt_hhmm(buf, sizeof(buf), t);
+        lv_label_set_text(s_ticks[i], buf);
+        int x = TL_X + col_of(t) - 16;
+        lv_obj_set_pos(s_ticks[i], (x < 0) ? 0 : (x > LCD_H_RES - 40) ? LCD_H_RES - 40 : x, TL_TICK_Y);
+        lv_obj_remove_flag(s_ticks[i], LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+void ui_timeline_set_plan(int64_t start_unix, int64_t end_unix, size_t n, ui_plan_pass_cb_t pass_cb, void *ctx) {
+    if (end_unix <= start_unix || (!pass_cb && n > 0) || !s_plan_scr) {
+        ESP_LOGE(TAG, "ui_timeline_set_plan: invalid args");
+        return;
+    }
+
+    lvgl_port_lock(0);
+    s_start = start_unix;
+    s_end = end_unix;
+    memset(s_cols, 0, sizeof(s_cols));
+    size_t n_tracked = 0;
+    int64_t tracked_s = 0;
+    ui_plan_pass_t p;
+    for (size_t i = 0; i < n; i++) {
+        if (!pass_cb(i, &p, ctx) || p.los_unix <= s_start || p.aos_unix >= s_end) {
+            continue;
+        }
+        int x0 = col_of(p.aos_unix), x1 = col_of(p.los_unix);
+        for (int x = x0; x <= x1; x++) {
+            if (p.tracked) {
+                s_cols[0][x] = (p.priority || s_cols[0][x] == 2) ? 2 : 1;
+            } else if (s_cols[1][x] < UINT8_MAX) {
+                s_cols[1][x]++;
+            }
+        }
+        n_tracked += p.tracked;
+        tracked_s += p.tracked ? p.los_unix - p.aos_unix : 0;
+    }
+
+    // Second walk for the list, now that its size is known
+    char *text = malloc(n_tracked * TL_LINE_LEN + 1);
+    if (text) {
+        size_t len = 0, lines = 0;
+        text[0] = '\0';
+        for (size_t i = 0; i < n && lines < n_tracked; i++) {
+            if (!pass_cb(i, &p, ctx) || !p.tracked || p.los_unix <= s_start || p.aos_unix >= s_end) {
+                continue;
+            }
+            char aos[8], los[8];
+            fmt_hhmm(aos, sizeof(aos), p.aos_unix);
+            fmt_hhmm(los, sizeof(los), p.los_unix);
+            int w = snprintf(text + len, TL_LINE_LEN, "%s-%s  %s%s  max el %d\n", aos, los, p.priority ? "* " : "",
+                             p.name, (int)p.max_el_deg);
+            len += (w < TL_LINE_LEN) ? (size_t)w : TL_LINE_LEN - 1;
+            lines++;
+        }
+        lv_label_set_text(s_list, text);
+        free(text);
+    } else {
+        ESP_LOGW(TAG, "No mem for the list of %u passes", (unsigned)n_tracked);
+        lv_label_set_text(s_list, "");
+    }
+    // LVGL's own sprintf has no float support
+    char title[64];
+    snprintf(title, sizeof(title), "Antenna plan: %u of %u passes, %.1f h", (unsigned)n_tracked, (unsigned)n,
+             tracked_s / 3600.0);
+    lv_label_set_text(s_title, title);
+    ticks_place();
+    lv_obj_invalidate(s_strip);
+    lvgl_port_unlock();
+}
+
+void ui_timeline_set_now(int64_t now_unix) {
+    if (!s_plan_scr) {
+        return;
+    }
+
+    lvgl_port_lock(0);
+    if (s_end <= s_start || now_unix < s_start || now_unix >= s_end) {
+        lv_obj_add_flag(s_now, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_set_pos(s_now, TL_X + col_of(now_unix) - 1, TL_LANE0_Y - 4);
+        lv_obj_remove_flag(s_now, LV_OBJ_FLAG_HIDDEN);
+    }
+    lvgl_port_unlock();
+}
@@ -0,0 +1,130 @@
+// Host benchmark of catalog loading with eager and lazy SGP4 initialization
+// (main/orbits/orbit_catalog.c). For each size the same TLE set is loaded both
+// ways and the load time, heap in use after the load and the first full
+// propagation are reported; lazy runs once cold (SGP4 init inside that
+// propagation) and once after a background warm-up in device-sized slices. Heap figures are
+// glibc's, so only the difference between the modes carries over to the ESP32.
+//
+//   catalog_bench [--n 1000,10000] [--tle catalog.txt] [--slice-us US] [--start UNIX]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <malloc.h>
+#include <vector>
+
+#include "orbit_catalog.h"
+#include "tool_util.h"
+
+struct options_t {
+    std::vector<size_t> sizes = {1000, 10000};
+    const char *tle_path = nullptr;
+    int64_t slice_us = 20000; // CATALOG_WARMUP_US in main.c
+    int64_t start = 1765321200; // 2025-12-09 23:00 UTC
+};
+
+static size_t heap_used(void) {
+    struct mallinfo2 mi = mallinfo2();
+    return mi.uordblks + mi.hblkhd;
+}
+
+static void run_mode(const options_t &opt, const std::vector<orbit_catalog_tle_src_t> &src, bool lazy, bool warmup) {
+    size_t heap0 = heap_used();
+    orbit_catalog_t *cat = nullptr;
+    if (orbit_catalog_create(nullptr, &cat) != ESP_OK) {
+        return;
+    }
+    orbit_catalog_set_lazy(cat, lazy);
+
+    double t0 = now_s();
+    orbit_catalog_update_stats_t st;
+    if (orbit_catalog_update(cat, src.data(), src.size(), &st) != ESP_OK) {
+        fprintf(stderr, "Catalog load failed\n");
+        orbit_catalog_destroy(cat);
+        return;
+    }
+    double load_s = now_s() - t0;
+    size_t heap_load = heap_used() - heap0;
+    size_t n = orbit_catalog_count(cat);
+    printf("%-5s load    %8.1f ms  %7.1f us/sat  heap %8.1f KiB (%.0f B/sat), %u rejected\n",
+           lazy ? "lazy" : "eager", load_s * 1e3, load_s * 1e6 / n, heap_load / 1024.0, (double)heap_load / n,
+           (unsigned)st.rejected);
+
+    if (warmup) {
+        // Background warm-up as on the device: a slice per main loop pass, every
+        // fifth entry (standing in for the visibility candidates) first
+        std::vector<uint8_t> priority(n);
+        for (size_t i = 0; i < n; i++) {
+            priority[i] = (i % 5) == 0;
+        }
+        size_t slices = 0, pending = n;
+        t0 = now_s();
+        while (pending) {
+            pending = orbit_catalog_warmup(cat, priority.data(), opt.slice_us);
+            slices++;
+        }
+        double warm_s = now_s() - t0;
+        printf("      warm-up %8.1f ms  %7.1f us/sat  heap %8.1f KiB, %zu slices of %lld us\n", warm_s * 1e3,
+               warm_s * 1e6 / n, (heap_used() - heap0) / 1024.0, slices, (long long)opt.slice_us);
+    }
+
+    orbit_soa_t soa = {};
+    t0 = now_s();
+    orbit_catalog_propagate_soa(cat, opt.start, nullptr, &soa);
+    printf("      first full propagation %8.1f ms\n", (now_s() - t0) * 1e3);
+    orbit_soa_free(&soa);
+    orbit_catalog_destroy(cat);
+}
+
+static void run(const options_t &opt, const std::vector<tle_text_t> &tles) {
+    std::vector<orbit_catalog_tle_src_t> src(tles.size());
+    for (size_t i = 0; i < tles.size(); i++) {
+        src[i].name = tles[i].name.empty() ? nullptr : tles[i].name.c_str();
+        src[i].line1 = tles[i].l1;
+        src[i].line2 = tles[i].l2;
+    }
+    printf("\n== %zu TLEs ==\n", tles.size());
+    run_mode(opt, src, false, false);
+    run_mode(opt, src, true, false);
+    run_mode(opt, src, true, true);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: catalog_bench [--n 1000,10000] [--tle catalog.txt] [--slice-us US] [--start UNIX]\n");
+}
+
+int main(int argc, char **argv) {
+    options_t opt;
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (!strcmp(argv[i], "--n") && has_val) {
+            opt.sizes.clear();
+            for (char *tok = strtok(argv[++i], ","); tok; tok = strtok(nullptr, ",")) {
+                opt.sizes.push_back(strtoul(tok, nullptr, 10));
+            }
+        } else if (!strcmp(argv[i], "--tle") && has_val) {
+            opt.tle_path = argv[++i];
+        } else if (!strcmp(argv[i], "--slice-us") && has_val) {
+            opt.slice_us = strtoll(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--start") && has_val) {
+            opt.start = strtoll(argv[++i], nullptr, 10);
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (opt.tle_path) {
+        std::vector<tle_text_t> tles;
+        if (!load_tle_file(opt.tle_path, tles)) {
+            return 1;
+        }
+        run(opt, tles);
+        return 0;
+    }
+    for (size_t n : opt.sizes) {
+        run(opt, synth_catalog(n, opt.start, 1234, 0.0, true));
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "tool_util.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <random>
+
+#define MU_KM3_S2       398600.4418
+#define EARTH_RADIUS_KM 6378.137
+
+double now_s(void) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Appends the checksum to a line of ORBIT_TLE_LINE_LEN - 1 chars
+static void finish_line(char *line) {
+    size_t n = strlen(line);
+    line[n] = (char)('0' + orbit_tle_checksum(line));
+    line[n + 1] = '\0';
+}
+
+tle_text_t make_tle(uint32_t id, int64_t epoch_unix, double alt_km, double ecc, double incl_deg, double raan_deg,
+                    double argp_deg, double ma_deg, bool drag) {
+    time_t t = (time_t)epoch_unix;
+    struct tm tm_utc;
+    gmtime_r(&t, &tm_utc);
+    double doy = tm_utc.tm_yday + 1 + (tm_utc.tm_hour * 3600 + tm_utc.tm_min * 60 + tm_utc.tm_sec) / 86400.0;
+
+    double a = EARTH_RADIUS_KM + alt_km;
+    double n_rev_day = std::sqrt(MU_KM3_S2 / (a * a * a)) * 86400.0 / (2.0 * M_PI);
+
+    tle_text_t tle;
+    tle.name = "SYN-" + std::to_string(id);
+    snprintf(tle.l1, sizeof(tle.l1), "1 %05uU 25001A   %02d%012.8f  %s 0  999", (unsigned)id,
+             tm_utc.tm_year % 100, doy, drag ? ".00001000  00000-0  50000-4" : ".00000000  00000-0  00000-0");
+    snprintf(tle.l2, sizeof(tle.l2), "2 %05u %8.4f %8.4f %07d %8.4f %8.4f %11.8f%5d", (unsigned)id,
+             incl_deg, std::fmod(raan_deg + 360.0, 360.0), (int)std::lround(ecc * 1e7),
+             std::fmod(argp_deg + 360.0, 360.0), std::fmod(ma_deg + 360.0, 360.0), n_rev_day, 1);
+    finish_line(tle.l1);
+    finish_line(tle.l2);
+    return tle;
+}
+
+std::vector<tle_text_t> synth_catalog(size_t n, int64_t epoch, uint32_t seed, double shell_fraction, bool drag) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    static const double k_incl[] = {51.6, 53.0, 70.0, 86.4, 97.6, 98.7};
+
+    std::vector<tle_text_t> cat;
+    cat.reserve(n);
+    size_t n_shell = std::min(n, (size_t)(n * shell_fraction));
+    size_t planes = std::max<size_t>(1, (size_t)std::sqrt((double)n_shell));
+    size_t per_plane = (n_shell + planes - 1) / planes;
+    for (size_t k = 0; k < n_shell; k++) {
+        size_t p = k / per_plane, s = k % per_plane;
+        double raan = 360.0 * p / planes;
+        double ma = 360.0 * s / per_plane + 360.0 * p / (planes * per_plane) + u(rng) * 0.2;
+        cat.push_back(make_tle((uint32_t)(10000 + k), epoch, 550.0 + u(rng), 0.0001, 53.0, raan, 0.0, ma, drag));
+    }
+    for (size_t k = n_shell; k < n; k++) {
+        double alt = 350.0 + 1100.0 * u(rng);
+        double incl = k_incl[rng() % (sizeof(k_incl) / sizeof(k_incl[0]))] + (u(rng) - 0.5);
+        cat.push_back(make_tle((uint32_t)(10000 + k), epoch, alt, 0.02 * u(rng), incl, 360.0 * u(rng),
+                               360.0 * u(rng), 360.0 * u(rng), drag));
+    }
+    return cat;
+}
+
+bool load_tle_file(const char *path, std::vector<tle_text_t> &out) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Can't open %s\n", path);
+        return false;
+    }
+    // Lines longer than a TLE line are cut to it, as orbit_catalog_update_from_file() does
+    char line[128], prev[128] = "";
+    while (fgets(line, sizeof(line), f)) {
+        line[strcspn(line, "\r\n")] = '\0';
+        if (line[0] == '2' && prev[0] == '1') {
+            tle_text_t t;
+            snprintf(t.l1, sizeof(t.l1), "%.*s", ORBIT_TLE_LINE_LEN, prev);
+            snprintf(t.l2, sizeof(t.l2), "%.*s", ORBIT_TLE_LINE_LEN, line);
+            out.push_back(t);
+        }
+        snprintf(prev, sizeof(prev), "%s", line);
+    }
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+// Helpers shared by the host tools: wall clock, synthetic TLE catalogs and TLE
+// file reading.
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "orbit_tle.h"
+
+struct tle_text_t {
+    std::string name;
+    char l1[ORBIT_TLE_LINE_LEN + 1];
+    char l2[ORBIT_TLE_LINE_LEN + 1];
+};
+
+// Monotonic wall clock [s]
+double now_s(void);
+
+// Element set for a circular-ish orbit at epoch_unix, with fresh checksums. drag
+// gives it a B* term (SGP4 then runs its drag branch), else it has none.
+tle_text_t make_tle(uint32_t id, int64_t epoch_unix, double alt_km, double ecc, double incl_deg, double raan_deg,
+                    double argp_deg, double ma_deg, bool drag);
+
+// shell_fraction of the objects in a 53 deg Walker shell at 550 km (where close
+// approaches cluster), the rest random LEO. NORAD IDs from 10000.
+std::vector<tle_text_t> synth_catalog(size_t n, int64_t epoch, uint32_t seed, double shell_fraction, bool drag);
+
+// Line pairs of a 2-line or 3-line TLE file (names are skipped); false when the
+// file can't be opened
+bool load_tle_file(const char *path, std::vector<tle_text_t> &out);
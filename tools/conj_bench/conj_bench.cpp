@@ -0,0 +1,184 @@
+// Host benchmark of the close-approach screener (main/orbits/orbit_conj.c) on
+// synthetic catalogs: dense Walker shells plus a random LEO population, all at the
+// start epoch. Each size is screened with the spatial hash and, for comparison,
+// with an all-pairs pass over the same coarse states using the same gate (no
+// refinement); the two gated pair counts must match.
+//
+//   conj_bench [--n 1000,10000] [--hours H] [--step S] [--km D] [--tle catalog.txt] [--start UNIX] [--no-brute]
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#include "orbit_catalog.h"
+#include "orbit_conj.h"
+#include "tool_util.h"
+
+// Same bounds as orbit_conj.c, for the all-pairs reference gate
+#define A_REL_MAX_KM_S2 0.02f
+
+struct options_t {
+    std::vector<size_t> sizes = {1000, 10000};
+    double hours = 3.0;
+    int64_t step_s = 60;
+    float threshold_km = 5.0f;
+    const char *tle_path = nullptr;
+    bool brute = true;
+    int64_t start = 1765321200; // 2025-12-09 23:00 UTC
+};
+
+static orbit_catalog_t *build_catalog(const std::vector<tle_text_t> &tles) {
+    std::vector<orbit_catalog_tle_src_t> src(tles.size());
+    for (size_t i = 0; i < tles.size(); i++) {
+        src[i].name = tles[i].name.empty() ? nullptr : tles[i].name.c_str();
+        src[i].line1 = tles[i].l1;
+        src[i].line2 = tles[i].l2;
+    }
+    orbit_catalog_t *cat = nullptr;
+    if (orbit_catalog_create(nullptr, &cat) != ESP_OK ||
+        orbit_catalog_update(cat, src.data(), src.size(), nullptr) != ESP_OK) {
+        orbit_catalog_destroy(cat);
+        return nullptr;
+    }
+    return cat;
+}
+
+// All pairs, same coarse states and gate as the screener
+static uint64_t brute_gated_pairs(orbit_catalog_t *cat, const options_t &opt, double *out_prop_s) {
+    orbit_soa_t soa = {};
+    const float h = opt.step_s * 0.5f;
+    const float gate = opt.threshold_km + 0.5f * A_REL_MAX_KM_S2 * h * h;
+    uint64_t gated = 0;
+    *out_prop_s = 0.0;
+    int64_t steps = (int64_t)(opt.hours * 3600.0) / opt.step_s + 1;
+
+    for (int64_t k = 0; k < steps; k++) {
+        double t0 = now_s();
+        orbit_catalog_propagate_soa(cat, opt.start + k * opt.step_s, nullptr, &soa);
+        *out_prop_s += now_s() - t0;
+        for (size_t i = 0; i < soa.count; i++) {
+            if (!soa.valid[i]) {
+                continue;
+            }
+            for (size_t j = i + 1; j < soa.count; j++) {
+                if (!soa.valid[j]) {
+                    continue;
+                }
+                float rx = soa.x[j] - soa.x[i], ry = soa.y[j] - soa.y[i], rz = soa.z[j] - soa.z[i];
+                float vx = soa.vx[j] - soa.vx[i], vy = soa.vy[j] - soa.vy[i], vz = soa.vz[j] - soa.vz[i];
+                float vv = vx * vx + vy * vy + vz * vz;
+                float tc = (vv > 0.0f) ? -(rx * vx + ry * vy + rz * vz) / vv : 0.0f;
+                tc = (tc < -h) ? -h : (tc > h) ? h : tc;
+                float mx = rx + vx * tc, my = ry + vy * tc, mz = rz + vz * tc;
+                gated += (mx * mx + my * my + mz * mz <= gate * gate);
+            }
+        }
+    }
+    orbit_soa_free(&soa);
+    return gated;
+}
+
+static void run(const options_t &opt, const std::vector<tle_text_t> &tles) {
+    orbit_catalog_t *cat = build_catalog(tles);
+    if (!cat) {
+        fprintf(stderr, "Catalog build failed\n");
+        return;
+    }
+    size_t n = orbit_catalog_count(cat);
+
+    orbit_conj_config_t cfg = ORBIT_CONJ_DEFAULT_CONFIG();
+    cfg.threshold_km = opt.threshold_km;
+    cfg.step_s = opt.step_s;
+    cfg.window_s = (int64_t)(opt.hours * 3600.0);
+    orbit_conj_t *cj = nullptr;
+    if (orbit_conj_create(&cfg, &cj) != ESP_OK) {
+        orbit_catalog_destroy(cat);
+        return;
+    }
+
+    double t0 = now_s();
+    orbit_conj_screen(cj, cat, opt.start);
+    double total = now_s() - t0;
+
+    orbit_conj_stats_t st;
+    orbit_conj_get_stats(cj, &st);
+    printf("\n== %zu objects, %.1f h at %lld s steps, threshold %.1f km ==\n", n, opt.hours, (long long)opt.step_s,
+           opt.threshold_km);
+    printf("hash:   %.2f s total (propagate %.2f s, hash %.3f s, pairs+refine %.3f s)\n", total,
+           st.propagate_us * 1e-6, st.hash_us * 1e-6, st.refine_us * 1e-6);
+    printf("        %llu neighbour pairs (%.1f per object per step), %llu refined, %u approaches\n",
+           (unsigned long long)st.neighbour_pairs, (double)st.neighbour_pairs / ((double)n * st.steps),
+           (unsigned long long)st.gated_pairs, (unsigned)st.events);
+
+    const orbit_conj_event_t *ev;
+    size_t n_ev = orbit_conj_events(cj, &ev);
+    for (size_t k = 0; k < n_ev && k < 5; k++) {
+        printf("        %5u - %5u  miss %.3f km at +%.1f s, %.2f km/s\n", (unsigned)ev[k].norad_a,
+               (unsigned)ev[k].norad_b, ev[k].miss_km, ev[k].tca_unix - (double)opt.start, ev[k].rel_speed_km_s);
+    }
+
+    if (opt.brute) {
+        double prop_s;
+        t0 = now_s();
+        uint64_t gated = brute_gated_pairs(cat, opt, &prop_s);
+        double brute_s = now_s() - t0;
+        uint64_t pairs = (uint64_t)n * (n - 1) / 2 * st.steps;
+        printf("brute:  %.2f s total (propagate %.2f s, %llu pair checks %.2f s), %llu gated pairs: %s\n", brute_s,
+               prop_s, (unsigned long long)pairs, brute_s - prop_s, (unsigned long long)gated,
+               gated == st.gated_pairs ? "match" : "MISMATCH");
+        double hash_pairs_s = (st.hash_us + st.refine_us) * 1e-6;
+        printf("        pair stage speed-up x%.0f\n", (brute_s - prop_s) / std::max(1e-6, hash_pairs_s));
+    }
+
+    orbit_conj_destroy(cj);
+    orbit_catalog_destroy(cat);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: conj_bench [--n 1000,10000] [--hours H] [--step S] [--km D] [--tle catalog.txt] "
+                    "[--start UNIX] [--no-brute]\n");
+}
+
+int main(int argc, char **argv) {
+    options_t opt;
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (!strcmp(argv[i], "--n") && has_val) {
+            opt.sizes.clear();
+            for (char *tok = strtok(argv[++i], ","); tok; tok = strtok(nullptr, ",")) {
+                opt.sizes.push_back(strtoul(tok, nullptr, 10));
+            }
+        } else if (!strcmp(argv[i], "--hours") && has_val) {
+            opt.hours = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--step") && has_val) {
+            opt.step_s = strtoll(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--km") && has_val) {
+            opt.threshold_km = (float)atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--tle") && has_val) {
+            opt.tle_path = argv[++i];
+        } else if (!strcmp(argv[i], "--start") && has_val) {
+            opt.start = strtoll(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--no-brute")) {
+            opt.brute = false;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (opt.tle_path) {
+        std::vector<tle_text_t> tles;
+        if (!load_tle_file(opt.tle_path, tles)) {
+            return 1;
+        }
+        run(opt, tles);
+        return 0;
+    }
+    for (size_t n : opt.sizes) {
+        run(opt, synth_catalog(n, opt.start, 1234, 0.4, false));
+    }
+    return 0;
+}
@@ -0,0 +1,348 @@
+// Host tool: propagate a TLE catalog with perturb over a time span, fit piecewise
+// Chebyshev polynomials per satellite and write an orbit_ephem file for the device.
+// The written file is read back through the device reader (orbit_ephem.c) and
+// compared against SGP4 between the fit nodes; the errors go into the file header.
+//
+//   ephem_gen <catalog.txt> <EPHEM.BIN> [--start UNIX] [--hours H] [--seg S] [--degree D]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+#include <perturb/perturb.hpp>
+
+#include "orbit_ephem.h"
+#include "orbit_tle.h"
+
+using perturb::DateTime;
+using perturb::JulianDate;
+using perturb::Satellite;
+using perturb::Sgp4Error;
+using perturb::StateVector;
+
+static_assert(sizeof(orbit_ephem_file_hdr_t) == 48, "ephemeris header layout");
+static_assert(sizeof(orbit_ephem_sat_rec_t) == 32, "ephemeris satellite record layout");
+
+// Error check points per segment, placed between the fit nodes
+#define CHECKS_PER_SEG 16
+
+struct sat_src_t {
+    std::string name;
+    orbit_tle_t tle;
+    Satellite sat;
+};
+
+struct options_t {
+    const char *tle_path = nullptr;
+    const char *out_path = nullptr;
+    int64_t start = 0;
+    double hours = 48.0;
+    uint32_t seg_len_s = 1200;
+    unsigned degree = 12;
+};
+
+// Unix UTC seconds (fractional) -> JulianDate
+static JulianDate unix_to_julian(double unix_time_sec) {
+    double whole = std::floor(unix_time_sec);
+    time_t t = (time_t)whole;
+    struct tm tm_utc;
+    gmtime_r(&t, &tm_utc);
+
+    DateTime dt;
+    dt.year = tm_utc.tm_year + 1900;
+    dt.month = tm_utc.tm_mon + 1;
+    dt.day = tm_utc.tm_mday;
+    dt.hour = tm_utc.tm_hour;
+    dt.min = tm_utc.tm_min;
+    dt.sec = (double)tm_utc.tm_sec + (unix_time_sec - whole);
+    return JulianDate(dt);
+}
+
+static bool sgp4_pos(Satellite &sat, double unix_time_sec, double out[3]) {
+    StateVector sv;
+    if (sat.propagate(unix_to_julian(unix_time_sec), sv) != Sgp4Error::NONE) {
+        return false;
+    }
+    for (int j = 0; j < 3; j++) {
+        out[j] = sv.position[j];
+    }
+    return true;
+}
+
+static void trim_line(char *s) {
+    size_t n = strlen(s);
+    while (n > 0 && (s[n - 1] == '\n' || s[n - 1] == '\r' || s[n - 1] == ' ')) {
+        s[--n] = '\0';
+    }
+}
+
+// 2-line or 3-line (named) TLE text, same rules as orbit_catalog_update_from_file()
+static bool load_catalog(const char *path, std::vector<sat_src_t> &out) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Cannot open %s\n", path);
+        return false;
+    }
+
+    char name[ORBIT_TLE_NAME_LEN + 1] = {0};
+    char l1[128], l2[128];
+    size_t rejected = 0;
+    while (fgets(l1, sizeof(l1), f)) {
+        trim_line(l1);
+        if (l1[0] != '1' || strlen(l1) < ORBIT_TLE_LINE_LEN) {
+            strncpy(name, l1, ORBIT_TLE_NAME_LEN);
+            continue;
+        }
+        if (!fgets(l2, sizeof(l2), f)) {
+            break;
+        }
+        trim_line(l2);
+
+        sat_src_t src;
+        src.name = name;
+        name[0] = '\0';
+        if (orbit_tle_parse(l1, l2, &src.tle) != ESP_OK) {
+            rejected++;
+            continue;
+        }
+        src.sat = Satellite::from_tle(std::string(l1), std::string(l2));
+        if (src.sat.last_error() != Sgp4Error::NONE) {
+            rejected++;
+            continue;
+        }
+        out.push_back(src);
+    }
+    fclose(f);
+
+    printf("Catalog %s: %zu satellites, %zu rejected\n", path, out.size(), rejected);
+    return !out.empty();
+}
+
+// Chebyshev interpolation of one segment at the n Chebyshev-Gauss nodes:
+// c_k = (2 / n) sum_j f(x_j) T_k(x_j), c_0 halved. coef is [3][n].
+static bool fit_segment(Satellite &sat, double t0, double len, unsigned n, float *coef) {
+    std::vector<double> f(3 * n);
+    std::vector<double> x(n);
+    for (unsigned j = 0; j < n; j++) {
+        x[j] = std::cos(M_PI * (j + 0.5) / n);
+        double p[3];
+        if (!sgp4_pos(sat, t0 + (x[j] + 1.0) * 0.5 * len, p)) {
+            return false;
+        }
+        for (int a = 0; a < 3; a++) {
+            f[a * n + j] = p[a];
+        }
+    }
+
+    for (int a = 0; a < 3; a++) {
+        for (unsigned k = 0; k < n; k++) {
+            double sum = 0.0;
+            for (unsigned j = 0; j < n; j++) {
+                sum += f[a * n + j] * std::cos(k * std::acos(x[j]));
+            }
+            double c = 2.0 * sum / n;
+            coef[a * n + k] = (float)((k == 0) ? 0.5 * c : c);
+        }
+    }
+    return true;
+}
+
+static bool write_file(const options_t &opt, std::vector<sat_src_t> &sats, uint32_t seg_count,
+                       orbit_ephem_file_hdr_t &hdr) {
+    const unsigned n = opt.degree + 1;
+    const size_t rec_floats = 3 * n;
+
+    FILE *f = fopen(opt.out_path, "wb");
+    if (!f) {
+        fprintf(stderr, "Cannot create %s\n", opt.out_path);
+        return false;
+    }
+
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.magic = ORBIT_EPHEM_MAGIC;
+    hdr.version = ORBIT_EPHEM_VERSION;
+    hdr.degree = (uint8_t)opt.degree;
+    hdr.sat_count = (uint32_t)sats.size();
+    hdr.seg_count = seg_count;
+    hdr.seg_len_s = opt.seg_len_s;
+    hdr.t_start_unix = opt.start;
+    hdr.sats_offset = sizeof(hdr);
+    hdr.data_offset = (uint32_t)(sizeof(hdr) + sats.size() * sizeof(orbit_ephem_sat_rec_t));
+    fwrite(&hdr, sizeof(hdr), 1, f);
+
+    for (const sat_src_t &s : sats) {
+        orbit_ephem_sat_rec_t rec;
+        memset(&rec, 0, sizeof(rec));
+        rec.norad_id = s.tle.norad_id;
+        strncpy(rec.name, s.name.c_str(), ORBIT_EPHEM_NAME_LEN);
+        fwrite(&rec, sizeof(rec), 1, f);
+    }
+
+    // Segment-major, so the device loads all satellites of a segment in one read
+    std::vector<float> coef(rec_floats);
+    size_t failed = 0;
+    for (uint32_t seg = 0; seg < seg_count; seg++) {
+        double t0 = (double)opt.start + (double)seg * opt.seg_len_s;
+        for (sat_src_t &s : sats) {
+            if (!fit_segment(s.sat, t0, opt.seg_len_s, n, coef.data())) {
+                std::fill(coef.begin(), coef.end(), 0.0f);
+                coef[0] = NAN;
+                failed++;
+            }
+            fwrite(coef.data(), sizeof(float), rec_floats, f);
+        }
+    }
+
+    bool ok = ferror(f) == 0;
+    ok = (fclose(f) == 0) && ok;
+    if (failed) {
+        printf("%zu segments without SGP4 solution (decayed?) marked invalid\n", failed);
+    }
+    return ok;
+}
+
+// Read the file back through the device reader and compare against SGP4
+static bool verify_file(const options_t &opt, std::vector<sat_src_t> &sats, orbit_ephem_file_hdr_t &hdr,
+                        std::vector<float> &sat_max_err) {
+    orbit_ephem_t *eph = nullptr;
+    if (orbit_ephem_open(opt.out_path, &eph) != ESP_OK) {
+        return false;
+    }
+
+    orbit_soa_t soa;
+    orbit_soa_alloc(&soa, sats.size());
+    sat_max_err.assign(sats.size(), 0.0f);
+    double sum_sq = 0.0, max_err = 0.0;
+    size_t samples = 0;
+    double cheb_s = 0.0, sgp4_s = 0.0;
+
+    for (uint32_t seg = 0; seg < hdr.seg_count; seg++) {
+        for (int c = 0; c < CHECKS_PER_SEG; c++) {
+            double t = (double)opt.start + ((double)seg + (c + 0.5) / CHECKS_PER_SEG) * opt.seg_len_s;
+
+            auto c0 = std::chrono::steady_clock::now();
+            orbit_ephem_propagate_soa(eph, t, &soa);
+            auto c1 = std::chrono::steady_clock::now();
+            cheb_s += std::chrono::duration<double>(c1 - c0).count();
+
+            for (size_t i = 0; i < sats.size(); i++) {
+                double p[3];
+                auto s0 = std::chrono::steady_clock::now();
+                bool ok = sgp4_pos(sats[i].sat, t, p);
+                sgp4_s += std::chrono::duration<double>(std::chrono::steady_clock::now() - s0).count();
+                if (!ok || !soa.valid[i]) {
+                    continue;
+                }
+                double dx = soa.x[i] - p[0], dy = soa.y[i] - p[1], dz = soa.z[i] - p[2];
+                double e2 = dx * dx + dy * dy + dz * dz;
+                double e = std::sqrt(e2);
+                sum_sq += e2;
+                samples++;
+                max_err = std::max(max_err, e);
+                sat_max_err[i] = std::max(sat_max_err[i], (float)e);
+            }
+        }
+    }
+
+    orbit_ephem_stats_t st;
+    orbit_ephem_get_stats(eph, &st);
+    orbit_soa_free(&soa);
+    orbit_ephem_close(eph);
+
+    hdr.max_err_km = (float)max_err;
+    hdr.rms_err_km = samples ? (float)std::sqrt(sum_sq / samples) : 0.0f;
+
+    double evals = (double)hdr.seg_count * CHECKS_PER_SEG * sats.size();
+    printf("Accuracy vs SGP4 (%zu samples): max %.4f km, rms %.4f km\n", samples, max_err, hdr.rms_err_km);
+    printf("Host eval: Chebyshev %.1f ns/sat (%u segment loads, %u bytes read), SGP4 %.1f ns/sat\n",
+           cheb_s * 1e9 / evals, st.block_loads, st.bytes_read, sgp4_s * 1e9 / evals);
+    return true;
+}
+
+// Store the measured errors in the header and satellite table
+static bool patch_errors(const options_t &opt, const orbit_ephem_file_hdr_t &hdr,
+                         const std::vector<float> &sat_max_err) {
+    FILE *f = fopen(opt.out_path, "r+b");
+    if (!f) {
+        return false;
+    }
+    fwrite(&hdr, sizeof(hdr), 1, f);
+    for (size_t i = 0; i < sat_max_err.size(); i++) {
+        long off = (long)(hdr.sats_offset + i * sizeof(orbit_ephem_sat_rec_t) + offsetof(orbit_ephem_sat_rec_t, max_err_km));
+        fseek(f, off, SEEK_SET);
+        fwrite(&sat_max_err[i], sizeof(float), 1, f);
+    }
+    return fclose(f) == 0;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: ephem_gen <catalog.txt> <EPHEM.BIN> [--start UNIX] [--hours H] [--seg S] "
+                    "[--degree D]\n");
+}
+
+int main(int argc, char **argv) {
+    options_t opt;
+    opt.start = (int64_t)time(nullptr) / 3600 * 3600;
+
+    int pos = 0;
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (!strcmp(argv[i], "--start") && has_val) {
+            opt.start = strtoll(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--hours") && has_val) {
+            opt.hours = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--seg") && has_val) {
+            opt.seg_len_s = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--degree") && has_val) {
+            opt.degree = (unsigned)strtoul(argv[++i], nullptr, 10);
+        } else if (argv[i][0] != '-' && pos < 2) {
+            (pos++ == 0 ? opt.tle_path : opt.out_path) = argv[i];
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (pos != 2 || opt.hours <= 0.0 || opt.seg_len_s == 0 || opt.degree < 1 ||
+        opt.degree > ORBIT_EPHEM_MAX_DEGREE) {
+        usage();
+        return 2;
+    }
+
+    std::vector<sat_src_t> sats;
+    if (!load_catalog(opt.tle_path, sats)) {
+        return 1;
+    }
+
+    uint32_t seg_count = (uint32_t)std::ceil(opt.hours * 3600.0 / opt.seg_len_s);
+    orbit_ephem_file_hdr_t hdr;
+    if (!write_file(opt, sats, seg_count, hdr)) {
+        fprintf(stderr, "Writing %s failed\n", opt.out_path);
+        return 1;
+    }
+
+    std::vector<float> sat_max_err;
+    if (!verify_file(opt, sats, hdr, sat_max_err) || !patch_errors(opt, hdr, sat_max_err)) {
+        fprintf(stderr, "Verifying %s failed\n", opt.out_path);
+        return 1;
+    }
+
+    size_t worst = 0;
+    for (size_t i = 1; i < sats.size(); i++) {
+        worst = (sat_max_err[i] > sat_max_err[worst]) ? i : worst;
+    }
+    long size = (long)hdr.data_offset + (long)seg_count * (long)sats.size() * 3 * (opt.degree + 1) * sizeof(float);
+    printf("Worst satellite: %s (%u) %.4f km\n", sats[worst].name.c_str(), (unsigned)sats[worst].tle.norad_id,
+           sat_max_err[worst]);
+    printf("Wrote %s: %ld bytes, %u segments of %u s, degree %u, %.0f bytes/sat/day, %zu bytes per segment load\n",
+           opt.out_path, size, seg_count, opt.seg_len_s, opt.degree,
+           3.0 * (opt.degree + 1) * sizeof(float) * 86400.0 / opt.seg_len_s,
+           sats.size() * 3 * (opt.degree + 1) * sizeof(float));
+    return 0;
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+// Minimal esp_log.h for host tools: errors and warnings to stderr, info to stdout
+
+#include <stdio.h>
+
+#define ESP_LOGE(tag, fmt, ...) fprintf(stderr, "E %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGW(tag, fmt, ...) fprintf(stderr, "W %s: " fmt "\n", tag, ##__VA_ARGS__)
+#define ESP_LOGI(tag, fmt, ...) printf("I %s: " fmt "\n", tag, ##__VA_ARGS__)
+// Debug is compiled out, but the format and arguments are still checked and used
+#define ESP_LOGD(tag, fmt, ...)                                                                                        \
+    do {                                                                                                               \
+        if (0) {                                                                                                       \
+            printf("D %s: " fmt "\n", tag, ##__VA_ARGS__);                                                             \
+        }                                                                                                              \
+    } while (0)
@@ -0,0 +1,352 @@
+// Host benchmark of the antenna tracking planner (main/orbits/orbit_plan.c). For
+// each catalog size a day of passes over one station is planned: synthetic passes
+// with LEO statistics (4-7 per satellite per day, 3-14 min long), or passes
+// predicted with SGP4 from a TLE file (--tle, first N satellites, Montevideo as in
+// main.c). One satellite in a hundred gets priority 2 and the first one priority 4;
+// a pass weighs priority x duration. The plan is compared with two greedy
+// baselines (earliest LOS first, heaviest first) and the solve time is the median
+// of --reps runs. --verify N checks the plan against exhaustive search on N small
+// random pass sets; --max-ms fails the run when a median solve takes longer.
+// Each size is also planned the way the device does it: passes below --min-el
+// dropped and, in catalog order, at most --cap of them kept, the lowest priority
+// then weight evicted when full (PLAN_MIN_EL_DEG and PLAN_MAX_PASSES in main.c).
+//
+//   plan_bench [--sats 100,300,1000] [--tle catalog.txt] [--start UNIX] [--seed N]
+//              [--reps N] [--continuous] [--verify N] [--max-ms MS] [--min-el DEG] [--cap N]
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <random>
+#include <vector>
+
+#include "orbit_catalog.h"
+#include "orbit_observer.h"
+#include "orbit_pass.h"
+#include "orbit_plan.h"
+#include "tool_util.h"
+
+#define DAY_S 86400
+
+struct options_t {
+    std::vector<size_t> sizes = {100, 300, 1000};
+    const char *tle_path = nullptr;
+    int64_t start = 1765321200; // 2025-12-09 23:00 UTC, as main.c
+    uint32_t seed = 1;
+    int reps = 21;
+    bool continuous = false;
+    int verify = 0;
+    double max_ms = -1.0;
+    float min_el_deg = 5.0f;
+    size_t cap = 4096;
+};
+
+static float priority_of(size_t sat) {
+    return (sat == 0) ? 4.0f : (sat % 100 == 50) ? 2.0f : 1.0f;
+}
+
+static void set_weight(orbit_plan_pass_t &p, size_t sat) {
+    p.weight = priority_of(sat) * (float)(p.los_s - p.aos_s);
+}
+
+static float pass_priority(const orbit_plan_pass_t &p) {
+    return p.weight / (float)(p.los_s - p.aos_s);
+}
+
+static bool is_priority(const orbit_plan_pass_t &p) {
+    return pass_priority(p) > 1.0f;
+}
+
+// main.c plan_outweighs()
+static bool outweighs(const orbit_plan_pass_t &a, const orbit_plan_pass_t &b) {
+    float pa = pass_priority(a), pb = pass_priority(b);
+    return (pa != pb) ? pa > pb : a.weight > b.weight;
+}
+
+// Visible revolutions at random, AOS and LOS azimuths roughly opposite
+static std::vector<orbit_plan_pass_t> synth_passes(size_t n_sats, int64_t start, int64_t window_s,
+                                                   std::mt19937 &rng) {
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    std::vector<orbit_plan_pass_t> passes;
+    for (size_t s = 0; s < n_sats; s++) {
+        double period_s = 5400.0 + 1200.0 * u(rng);
+        int per_day = 4 + (int)(u(rng) * 4.0);
+        double p_visible = per_day * period_s / DAY_S;
+        for (double t = start - period_s * u(rng); t < start + window_s; t += period_s) {
+            if (u(rng) >= p_visible) {
+                continue;
+            }
+            double dur = 180.0 + 660.0 * u(rng);
+            int64_t aos = (int64_t)(t + period_s * u(rng));
+            int64_t los = aos + (int64_t)dur;
+            if (aos >= start + window_s || los <= start) {
+                continue;
+            }
+            float aos_az = (float)(360.0 * u(rng));
+            float los_az = aos_az + 120.0f + (float)(120.0 * u(rng));
+            orbit_plan_pass_t p;
+            orbit_plan_pass_init(&p, (uint32_t)(10000 + s), start, aos, los, aos_az, los_az,
+                                 (float)(90.0 * std::pow(dur / 840.0, 2.0)));
+            set_weight(p, s);
+            passes.push_back(p);
+        }
+    }
+    return passes;
+}
+
+// Every pass starting in the window, the way the device collects them
+static std::vector<orbit_plan_pass_t> tle_passes(orbit_catalog_t *cat, size_t n_sats, int64_t start) {
+    orbit_station_t st;
+    orbit_station_init(&st, -34.90, -56.16, 0.04, 0.0f);
+    std::vector<orbit_plan_pass_t> passes;
+    size_t n = std::min(n_sats, orbit_catalog_count(cat));
+    for (size_t s = 0; s < n; s++) {
+        orbit_catalog_entry_t *entry = orbit_catalog_at(cat, s);
+        orbit_sat_t *sat = orbit_catalog_entry_sat(entry);
+        int64_t t = start;
+        orbit_pass_t pass;
+        while (sat && t < start + DAY_S && orbit_pass_find(sat, &st, t, start + DAY_S - t, &pass) == ESP_OK) {
+            orbit_plan_pass_t p;
+            orbit_plan_pass_init(&p, entry->norad_id, start, pass.aos_unix, pass.los_unix, pass.aos_az_deg,
+                                 pass.los_az_deg, pass.max_el_deg);
+            set_weight(p, s);
+            passes.push_back(p);
+            t = pass.los_unix + 1;
+        }
+    }
+    return passes;
+}
+
+static bool fits(const orbit_plan_rotator_t &rot, const orbit_plan_pass_t &a, const orbit_plan_pass_t &b) {
+    return (float)(b.aos_s - a.los_s) >= orbit_plan_slew_s(&rot, a.los_az_ddeg * 0.1f, b.aos_az_ddeg * 0.1f);
+}
+
+// Classic interval scheduling: earliest LOS first, weights ignored
+static float greedy_earliest(const orbit_plan_rotator_t &rot, std::vector<orbit_plan_pass_t> passes) {
+    std::sort(passes.begin(), passes.end(),
+              [](const orbit_plan_pass_t &a, const orbit_plan_pass_t &b) { return a.los_s < b.los_s; });
+    float value = 0.0f;
+    const orbit_plan_pass_t *last = nullptr;
+    for (const orbit_plan_pass_t &p : passes) {
+        if (!last || fits(rot, *last, p)) {
+            value += p.weight;
+            last = &p;
+        }
+    }
+    return value;
+}
+
+// Heaviest first, kept when it fits between its neighbours in time
+static float greedy_heaviest(const orbit_plan_rotator_t &rot, std::vector<orbit_plan_pass_t> passes) {
+    std::sort(passes.begin(), passes.end(),
+              [](const orbit_plan_pass_t &a, const orbit_plan_pass_t &b) { return a.weight > b.weight; });
+    std::multimap<int64_t, const orbit_plan_pass_t *> chosen; // by AOS
+    float value = 0.0f;
+    for (const orbit_plan_pass_t &p : passes) {
+        auto next = chosen.lower_bound(p.aos_s);
+        if (next != chosen.end() && !fits(rot, p, *next->second)) {
+            continue;
+        }
+        if (next != chosen.begin() && !fits(rot, *std::prev(next)->second, p)) {
+            continue;
+        }
+        chosen.emplace(p.aos_s, &p);
+        value += p.weight;
+    }
+    return value;
+}
+
+// Best plan by enumerating every feasible sequence (passes sorted by AOS)
+static float exhaustive(const orbit_plan_rotator_t &rot, const std::vector<orbit_plan_pass_t> &passes, size_t i,
+                        int last) {
+    if (i == passes.size()) {
+        return 0.0f;
+    }
+    float skip = exhaustive(rot, passes, i + 1, last);
+    if (last >= 0 && !fits(rot, passes[last], passes[i])) {
+        return skip;
+    }
+    return std::max(skip, passes[i].weight + exhaustive(rot, passes, i + 1, (int)i));
+}
+
+static bool verify(const options_t &opt, const orbit_plan_rotator_t &rot) {
+    std::mt19937 rng(opt.seed + 1);
+    int mismatches = 0;
+    for (int k = 0; k < opt.verify; k++) {
+        // A busy few hours: 16 passes of 6 satellites, most of them overlapping
+        std::vector<orbit_plan_pass_t> passes = synth_passes(24, opt.start, 4 * 3600, rng);
+        passes.resize(std::min<size_t>(passes.size(), 16));
+        std::vector<orbit_plan_pass_t> by_aos = passes;
+        std::sort(by_aos.begin(), by_aos.end(),
+                  [](const orbit_plan_pass_t &a, const orbit_plan_pass_t &b) { return a.aos_s < b.aos_s; });
+        float best = exhaustive(rot, by_aos, 0, -1);
+
+        std::vector<uint32_t> sel(passes.size());
+        size_t n_sel = 0;
+        orbit_plan_stats_t st;
+        orbit_plan_solve(passes.data(), passes.size(), &rot, sel.data(), &n_sel, &st);
+        bool feasible = true;
+        for (size_t i = 1; i < n_sel; i++) {
+            feasible &= fits(rot, passes[sel[i - 1]], passes[sel[i]]);
+        }
+        if (!feasible || std::fabs(st.value - best) > 1e-3f * best) {
+            mismatches++;
+            printf("verify %d: plan %.0f%s, exhaustive %.0f\n", k, st.value, feasible ? "" : " (infeasible)", best);
+        }
+    }
+    printf("verify: %d of %d plans optimal and feasible\n", opt.verify - mismatches, opt.verify);
+    return mismatches == 0;
+}
+
+// The pass list of main.c plan_add(), fed in catalog order
+static std::vector<orbit_plan_pass_t> device_list(const options_t &opt, const std::vector<orbit_plan_pass_t> &passes,
+                                                  size_t *out_evicted) {
+    std::vector<orbit_plan_pass_t> list;
+    size_t evicted = 0;
+    for (const orbit_plan_pass_t &p : passes) {
+        if (p.max_el_deg < opt.min_el_deg) {
+            continue;
+        }
+        if (list.size() < opt.cap) {
+            list.push_back(p);
+            continue;
+        }
+        evicted++;
+        auto lowest = std::min_element(list.begin(), list.end(), [](const orbit_plan_pass_t &a,
+                                                                    const orbit_plan_pass_t &b) {
+            return outweighs(b, a);
+        });
+        if (lowest != list.end() && outweighs(p, *lowest)) {
+            *lowest = p;
+        }
+    }
+    *out_evicted = evicted;
+    return list;
+}
+
+// Returns the median solve time [ms] and the plan value
+static double run(const options_t &opt, const orbit_plan_rotator_t &rot, const char *tag, size_t n_sats,
+                  const std::vector<orbit_plan_pass_t> &passes, float *out_value) {
+    std::vector<orbit_plan_pass_t> work;
+    std::vector<uint32_t> sel(passes.size());
+    std::vector<double> ms;
+    orbit_plan_stats_t st = {};
+    size_t n_sel = 0;
+    for (int r = 0; r < opt.reps; r++) {
+        work = passes; // unsorted every time, as collected
+        double t0 = now_s();
+        orbit_plan_solve(work.data(), work.size(), &rot, sel.data(), &n_sel, &st);
+        ms.push_back((now_s() - t0) * 1e3);
+    }
+    std::sort(ms.begin(), ms.end());
+    double med = ms[ms.size() / 2];
+
+    float v_early = greedy_earliest(rot, passes);
+    float v_heavy = greedy_heaviest(rot, passes);
+    printf("%-6s %5zu sats %5zu passes: %3zu tracked, %4.1f h, value %.0f (%.1f%% of all passes), "
+           "greedy by LOS %.1f%%, by weight %.1f%% of the plan; %u slew checks, %.3f ms (max %.3f)\n",
+           tag, n_sats, passes.size(), n_sel, st.tracked_s / 3600.0, st.value,
+           st.value_all > 0.0f ? 100.0 * st.value / st.value_all : 0.0,
+           st.value > 0.0f ? 100.0 * v_early / st.value : 0.0, st.value > 0.0f ? 100.0 * v_heavy / st.value : 0.0,
+           (unsigned)st.slew_checks, med, ms.back());
+    *out_value = st.value;
+    return med;
+}
+
+// Returns the median solve time [ms]
+static double run_device(const options_t &opt, const orbit_plan_rotator_t &rot, size_t n_sats,
+                         const std::vector<orbit_plan_pass_t> &passes, float full_value) {
+    size_t evicted = 0;
+    std::vector<orbit_plan_pass_t> list = device_list(opt, passes, &evicted);
+    size_t n_prio = 0, n_prio_kept = 0, n_above = list.size() + evicted;
+    for (const orbit_plan_pass_t &p : passes) {
+        n_prio += p.max_el_deg >= opt.min_el_deg && is_priority(p);
+    }
+    for (const orbit_plan_pass_t &p : list) {
+        n_prio_kept += is_priority(p);
+    }
+    float value = 0.0f;
+    double med = run(opt, rot, "device", n_sats, list, &value);
+    printf("       %zu passes above %.0f deg, %zu kept (cap %zu), priority passes %zu of %zu kept, "
+           "plan value %.1f%% of the unfiltered plan\n",
+           n_above, opt.min_el_deg, list.size(), opt.cap, n_prio_kept, n_prio,
+           full_value > 0.0f ? 100.0 * value / full_value : 0.0);
+    return med;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: plan_bench [--sats 100,300,1000] [--tle catalog.txt] [--start UNIX] [--seed N]\n"
+                    "                  [--reps N] [--continuous] [--verify N] [--max-ms MS] [--min-el DEG]\n"
+                    "                  [--cap N]\n");
+}
+
+int main(int argc, char **argv) {
+    options_t opt;
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (!strcmp(argv[i], "--sats") && has_val) {
+            opt.sizes.clear();
+            for (char *tok = strtok(argv[++i], ","); tok; tok = strtok(nullptr, ",")) {
+                opt.sizes.push_back(strtoul(tok, nullptr, 10));
+            }
+        } else if (!strcmp(argv[i], "--tle") && has_val) {
+            opt.tle_path = argv[++i];
+        } else if (!strcmp(argv[i], "--start") && has_val) {
+            opt.start = strtoll(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--seed") && has_val) {
+            opt.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--reps") && has_val) {
+            opt.reps = std::max(1, atoi(argv[++i]));
+        } else if (!strcmp(argv[i], "--continuous")) {
+            opt.continuous = true;
+        } else if (!strcmp(argv[i], "--verify") && has_val) {
+            opt.verify = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--max-ms") && has_val) {
+            opt.max_ms = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--min-el") && has_val) {
+            opt.min_el_deg = (float)atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--cap") && has_val) {
+            opt.cap = std::max<size_t>(1, strtoul(argv[++i], nullptr, 10));
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    orbit_plan_rotator_t rot = ORBIT_PLAN_ROTATOR_DEFAULT();
+    rot.az_continuous = opt.continuous;
+    printf("rotator %.1f deg/s, settle %.0f s, %s azimuth\n", rot.az_rate_deg_s, rot.settle_s,
+           rot.az_continuous ? "continuous" : "end stop at north");
+
+    orbit_catalog_t *cat = nullptr;
+    if (opt.tle_path) {
+        if (orbit_catalog_create(nullptr, &cat) != ESP_OK ||
+            orbit_catalog_update_from_file(cat, opt.tle_path, nullptr) != ESP_OK) {
+            fprintf(stderr, "can't load %s\n", opt.tle_path);
+            return 1;
+        }
+    }
+
+    bool fail = opt.verify > 0 && !verify(opt, rot);
+    std::mt19937 rng(opt.seed);
+    double worst_ms = 0.0;
+    for (size_t n : opt.sizes) {
+        std::vector<orbit_plan_pass_t> passes =
+            cat ? tle_passes(cat, n, opt.start) : synth_passes(n, opt.start, DAY_S, rng);
+        size_t n_sats = cat ? std::min(n, orbit_catalog_count(cat)) : n;
+        float value = 0.0f;
+        worst_ms = std::max(worst_ms, run(opt, rot, "all", n_sats, passes, &value));
+        worst_ms = std::max(worst_ms, run_device(opt, rot, n_sats, passes, value));
+    }
+    orbit_catalog_destroy(cat);
+
+    if (opt.max_ms >= 0.0 && worst_ms > opt.max_ms) {
+        printf("FAIL: median solve %.3f ms, at most %.3f ms allowed\n", worst_ms, opt.max_ms);
+        fail = true;
+    }
+    return fail ? 1 : 0;
+}
@@ -0,0 +1,227 @@
+// Regression check of the main loop schedule (orbit_sched.c). The device's task
+// set runs with modelled execution times on a simulated clock: each task advances
+// the clock by its cost, the loop sleeps to the next release and wakes after the
+// modelled wake-up latency, either an esp_timer (--wake timer, tens of us) or a
+// FreeRTOS delay rounded up to the tick (--wake tick, CONFIG_FREERTOS_HZ=100).
+// Prints the per-task summary the device logs and exits 1 when the missed
+// deadlines or the p99 lateness (as a share of the task's period) exceed the
+// given bounds.
+//
+// --real runs the same task set on the host clock, sleeping with clock_nanosleep
+// and spinning for the modelled costs, to see the scheduler under real jitter.
+//
+//   sched_sim [--seconds S] [--sim] [--wake timer|tick] [--seed N]
+//             [--max-missed N] [--max-late-p99-pct P] [--real]
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <time.h>
+
+#include "esp_timer.h"
+#include "orbit_sched.h"
+
+struct options_t {
+    double seconds = 600.0;
+    bool sim = false; // sky and look at the simulation frame rate
+    bool wake_tick = false;
+    int64_t tick_us = 10000;
+    int64_t timer_wake_us = 40;
+    uint32_t seed = 1;
+    long max_missed = -1;
+    double max_late_p99_pct = -1.0;
+    bool real = false;
+};
+
+// Execution time model: base, uniform jitter and a rare spike
+struct cost_t {
+    int64_t base_us;
+    int64_t jitter_us;
+    int64_t spike_us;
+    double spike_p;
+};
+
+struct sim_task_t {
+    const char *name;
+    int64_t period_ms;
+    int64_t sim_period_ms; // with --sim, 0 = same
+    cost_t cost;
+};
+
+// Same periods as main.c; costs from device logs (look: 1000 sats, SGP4 at
+// ~40 us each plus the UI update; poll: the SGP4 warm-up while it lasts; plan:
+// its 10 ms search budget, overrun by up to one search, and the hourly solve)
+static const sim_task_t k_tasks[] = {
+    {"poll", 30, 0, {300, 200, 20000, 0.02}},
+    {"sky", 1000, 200, {4000, 2000, 0, 0.0}},
+    {"look", 2000, 200, {60000, 10000, 150000, 0.05}},
+    {"conj", 1000, 0, {12000, 4000, 0, 0.0}},
+    {"plan", 100, 0, {10000, 8000, 30000, 0.0003}},
+    {"catalog", 10000, 0, {2000, 500, 0, 0.0}},
+    {"sim_log", 10000, 0, {500, 100, 0, 0.0}},
+    {"sched_log", 60000, 0, {3000, 500, 0, 0.0}},
+};
+#define N_TASKS (sizeof(k_tasks) / sizeof(k_tasks[0]))
+
+struct sim_t {
+    options_t opt;
+    int64_t now_us = 0;
+    std::mt19937 rng;
+};
+
+static sim_t s_sim;
+
+static int64_t sim_clock(void *ctx) {
+    return static_cast<sim_t *>(ctx)->now_us;
+}
+
+static int64_t cost_draw(const cost_t &c) {
+    std::uniform_real_distribution<double> u(0.0, 1.0);
+    int64_t us = c.base_us + (int64_t)(u(s_sim.rng) * c.jitter_us);
+    if (c.spike_p > 0.0 && u(s_sim.rng) < c.spike_p) {
+        us += c.spike_us;
+    }
+    return us;
+}
+
+static void spin_until(int64_t t_us) {
+    while (esp_timer_get_time() < t_us) {
+    }
+}
+
+static void task_fn(void *ctx) {
+    const sim_task_t *t = static_cast<const sim_task_t *>(ctx);
+    int64_t us = cost_draw(t->cost);
+    if (s_sim.opt.real) {
+        spin_until(esp_timer_get_time() + us);
+    } else {
+        s_sim.now_us += us;
+    }
+}
+
+// Simulated sleep until release: a tick-based delay wakes on the first tick
+// boundary at or after the release (at least one tick), an esp_timer just after it
+static void sim_sleep_until(int64_t release_us) {
+    const options_t &o = s_sim.opt;
+    if (o.wake_tick) {
+        int64_t wait = release_us - s_sim.now_us;
+        int64_t ticks = (wait + o.tick_us - 1) / o.tick_us;
+        ticks = ticks < 1 ? 1 : ticks;
+        s_sim.now_us = (s_sim.now_us / o.tick_us + ticks) * o.tick_us;
+    } else {
+        s_sim.now_us = release_us + o.timer_wake_us;
+    }
+}
+
+static void real_sleep_until(int64_t release_us) {
+    int64_t wait = release_us - esp_timer_get_time();
+    if (wait <= 0) {
+        return;
+    }
+    struct timespec ts;
+    ts.tv_sec = wait / 1000000;
+    ts.tv_nsec = (wait % 1000000) * 1000;
+    clock_nanosleep(CLOCK_MONOTONIC, 0, &ts, nullptr);
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: sched_sim [--seconds S] [--sim] [--wake timer|tick] [--seed N]\n"
+                    "                 [--max-missed N] [--max-late-p99-pct P] [--real]\n");
+}
+
+int main(int argc, char **argv) {
+    options_t &opt = s_sim.opt;
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (!strcmp(argv[i], "--seconds") && has_val) {
+            opt.seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--sim")) {
+            opt.sim = true;
+        } else if (!strcmp(argv[i], "--wake") && has_val) {
+            opt.wake_tick = !strcmp(argv[++i], "tick");
+        } else if (!strcmp(argv[i], "--seed") && has_val) {
+            opt.seed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--max-missed") && has_val) {
+            opt.max_missed = strtol(argv[++i], nullptr, 10);
+        } else if (!strcmp(argv[i], "--max-late-p99-pct") && has_val) {
+            opt.max_late_p99_pct = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--real")) {
+            opt.real = true;
+        } else {
+            usage();
+            return 1;
+        }
+    }
+    s_sim.rng.seed(opt.seed);
+    // Boot time: the release grid starts off the tick grid, as on the device
+    s_sim.now_us = 1000000 + (int64_t)(s_sim.rng() % (uint32_t)opt.tick_us);
+
+    orbit_sched_t *sched = nullptr;
+    if (orbit_sched_create(opt.real ? nullptr : sim_clock, &s_sim, &sched) != ESP_OK) {
+        return 1;
+    }
+    for (size_t i = 0; i < N_TASKS; i++) {
+        const sim_task_t &t = k_tasks[i];
+        int64_t period_ms = (opt.sim && t.sim_period_ms) ? t.sim_period_ms : t.period_ms;
+        orbit_sched_task_cfg_t cfg = {};
+        cfg.name = t.name;
+        cfg.period_us = period_ms * 1000;
+        cfg.fn = task_fn;
+        cfg.ctx = const_cast<sim_task_t *>(&t);
+        if (orbit_sched_add(sched, &cfg, nullptr) != ESP_OK) {
+            return 1;
+        }
+    }
+
+    int64_t t_end = (opt.real ? esp_timer_get_time() : s_sim.now_us) + (int64_t)(opt.seconds * 1e6);
+    uint64_t wakeups = 0;
+    while ((opt.real ? esp_timer_get_time() : s_sim.now_us) < t_end) {
+        int64_t next = orbit_sched_run(sched);
+        if (opt.real) {
+            real_sleep_until(next);
+        } else {
+            sim_sleep_until(next);
+        }
+        wakeups++;
+    }
+
+    printf("%s clock, %s wake-up, %s periods, %.0f s, %llu wake-ups\n", opt.real ? "host" : "simulated",
+           opt.real ? "clock_nanosleep" : (opt.wake_tick ? "10 ms tick" : "esp_timer"),
+           opt.sim ? "simulation" : "real-time", opt.seconds, (unsigned long long)wakeups);
+
+    long missed = 0;
+    double worst_pct = 0.0;
+    const char *worst_name = "";
+    for (size_t i = 0; i < orbit_sched_count(sched); i++) {
+        orbit_sched_stats_t st;
+        orbit_sched_get_stats(sched, (int)i, &st, false);
+        missed += st.missed;
+        const sim_task_t &t = k_tasks[i];
+        int64_t period_ms = (opt.sim && t.sim_period_ms) ? t.sim_period_ms : t.period_ms;
+        double pct = 100.0 * orbit_sched_hist_quantile(st.late_hist, 0.99f) / (period_ms * 1000.0);
+        if (pct > worst_pct) {
+            worst_pct = pct;
+            worst_name = t.name;
+        }
+    }
+    std::vector<char> buf(N_TASKS * 200);
+    orbit_sched_format_all(sched, buf.data(), buf.size(), false);
+    fputs(buf.data(), stdout);
+    orbit_sched_destroy(sched);
+
+    bool fail = false;
+    if (opt.max_missed >= 0 && missed > opt.max_missed) {
+        printf("FAIL: %ld missed deadlines, at most %ld allowed\n", missed, opt.max_missed);
+        fail = true;
+    }
+    if (opt.max_late_p99_pct >= 0.0 && worst_pct > opt.max_late_p99_pct) {
+        printf("FAIL: p99 lateness of %s up to %.1f%% of its period, at most %.1f%% allowed\n", worst_name, worst_pct,
+               opt.max_late_p99_pct);
+        fail = true;
+    }
+    return fail ? 1 : 0;
+}
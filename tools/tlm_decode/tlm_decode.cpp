@@ -0,0 +1,305 @@
+// Host reader of the device's binary position stream (orbit_telemetry_format.h).
+// Reads a serial port (set raw at --baud) or a capture file, cuts frames at the
+// 0x00 delimiters, checks them through the device decoder (orbit_telemetry.c) and
+// prints the records, or with --stats a line per second of rates, CRC errors and
+// sequence gaps.
+//
+// --loopback runs both ends on a pseudo-terminal: a writer thread frames messages
+// of --sats records as fast as the pty takes them, the reader decodes and checks
+// every one, and the sustained messages per second are reported together with the
+// rate a UART at --baud would carry for that frame size.
+//
+//   tlm_decode <port|file> [--baud B] [--stats]
+//   tlm_decode --loopback [--seconds S] [--sats N] [--baud B]
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <termios.h>
+#include <unistd.h>
+
+#include "orbit_telemetry.h"
+#include "tool_util.h"
+
+static_assert(sizeof(orbit_tlm_hdr_t) == 16, "telemetry header layout");
+static_assert(sizeof(orbit_tlm_pos_t) == 44, "telemetry record layout");
+
+struct options_t {
+    const char *path = nullptr;
+    int baud = 921600;
+    bool stats = false;
+    bool loopback = false;
+    double seconds = 5.0;
+    size_t sats = 3;
+};
+
+struct counters_t {
+    uint64_t frames = 0;
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+    uint64_t bad_crc = 0;
+    uint64_t bad_other = 0;
+    uint64_t lost = 0; // messages missing from the sequence
+};
+
+static speed_t baud_constant(int baud) {
+    switch (baud) {
+    case 115200:
+        return B115200;
+    case 230400:
+        return B230400;
+    case 460800:
+        return B460800;
+    case 921600:
+        return B921600;
+    default:
+        return B0;
+    }
+}
+
+static bool set_raw(int fd, int baud) {
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        return true; // plain file
+    }
+    cfmakeraw(&tio);
+    speed_t sp = baud_constant(baud);
+    if (sp != B0) {
+        cfsetispeed(&tio, sp);
+        cfsetospeed(&tio, sp);
+    }
+    tio.c_cc[VMIN] = 1;
+    tio.c_cc[VTIME] = 0;
+    return tcsetattr(fd, TCSANOW, &tio) == 0;
+}
+
+// Splits the byte stream into frames and decodes them
+class frame_reader_t {
+  public:
+    counters_t cnt;
+
+    // Returns the number of frames decoded from data
+    template <typename F> size_t feed(const uint8_t *data, size_t len, F &&on_frame) {
+        size_t decoded = 0;
+        for (size_t i = 0; i < len; i++) {
+            cnt.bytes++;
+            if (data[i] != 0) {
+                // Oversized garbage is dropped; the next delimiter resynchronizes
+                if (buf_.size() < ORBIT_TLM_FRAME_MAX) {
+                    buf_.push_back(data[i]);
+                } else {
+                    overflow_ = true;
+                }
+                continue;
+            }
+            if (!buf_.empty()) {
+                decoded += finish(on_frame);
+            }
+            buf_.clear();
+            overflow_ = false;
+        }
+        return decoded;
+    }
+
+  private:
+    std::vector<uint8_t> buf_;
+    bool overflow_ = false;
+    bool have_seq_ = false;
+    uint32_t next_seq_ = 0;
+
+    template <typename F> size_t finish(F &&on_frame) {
+        orbit_tlm_hdr_t hdr;
+        orbit_tlm_pos_t recs[ORBIT_TLM_MAX_RECORDS];
+        esp_err_t ret = overflow_ ? ESP_ERR_INVALID_SIZE : orbit_tlm_decode(buf_.data(), buf_.size(), &hdr, recs);
+        if (ret != ESP_OK) {
+            (ret == ESP_ERR_INVALID_CRC ? cnt.bad_crc : cnt.bad_other)++;
+            return 0;
+        }
+        if (have_seq_ && hdr.seq != next_seq_) {
+            cnt.lost += (uint32_t)(hdr.seq - next_seq_);
+        }
+        have_seq_ = true;
+        next_seq_ = hdr.seq + 1;
+        cnt.frames++;
+        cnt.records += hdr.count;
+        on_frame(hdr, recs);
+        return 1;
+    }
+};
+
+static void print_frame(const orbit_tlm_hdr_t &hdr, const orbit_tlm_pos_t *recs) {
+    printf("#%u t=%.3f\n", (unsigned)hdr.seq, hdr.t_unix_ms * 1e-3);
+    for (size_t k = 0; k < hdr.count; k++) {
+        const orbit_tlm_pos_t &r = recs[k];
+        printf("  %6u  r=[%10.3f %10.3f %10.3f] km  v=[%7.4f %7.4f %7.4f] km/s  az %6.2f el %6.2f  "
+               "%8.1f km %+7.4f km/s\n",
+               (unsigned)r.norad_id, r.pos_km[0], r.pos_km[1], r.pos_km[2], r.vel_km_s[0], r.vel_km_s[1],
+               r.vel_km_s[2], r.az_deg, r.el_deg, r.range_km, r.range_rate_km_s);
+    }
+}
+
+static void print_stats(const counters_t &c, const counters_t &prev, double dt) {
+    printf("%8.0f msg/s %9.0f rec/s %10.0f B/s  total %llu msgs, %llu lost, %llu bad CRC, %llu malformed\n",
+           (c.frames - prev.frames) / dt, (c.records - prev.records) / dt, (c.bytes - prev.bytes) / dt,
+           (unsigned long long)c.frames, (unsigned long long)c.lost, (unsigned long long)c.bad_crc,
+           (unsigned long long)c.bad_other);
+}
+
+static int run_reader(const options_t &opt) {
+    int fd = open(opt.path, O_RDONLY | O_NOCTTY);
+    if (fd < 0 || !set_raw(fd, opt.baud)) {
+        fprintf(stderr, "Can't open %s\n", opt.path);
+        return 1;
+    }
+    frame_reader_t rd;
+    counters_t prev;
+    double t_prev = now_s();
+    uint8_t buf[4096];
+    ssize_t n;
+    while ((n = read(fd, buf, sizeof(buf))) > 0) {
+        rd.feed(buf, (size_t)n, [&](const orbit_tlm_hdr_t &hdr, const orbit_tlm_pos_t *recs) {
+            if (!opt.stats) {
+                print_frame(hdr, recs);
+            }
+        });
+        double t = now_s();
+        if (opt.stats && t - t_prev >= 1.0) {
+            print_stats(rd.cnt, prev, t - t_prev);
+            prev = rd.cnt;
+            t_prev = t;
+        }
+    }
+    fprintf(stderr, "%llu msgs, %llu records, %llu bytes, %llu lost, %llu bad CRC, %llu malformed\n",
+            (unsigned long long)rd.cnt.frames, (unsigned long long)rd.cnt.records, (unsigned long long)rd.cnt.bytes,
+            (unsigned long long)rd.cnt.lost, (unsigned long long)rd.cnt.bad_crc, (unsigned long long)rd.cnt.bad_other);
+    close(fd);
+    return 0;
+}
+
+static int run_loopback(const options_t &opt) {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+        perror("posix_openpt");
+        return 1;
+    }
+    int slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+    if (slave < 0 || !set_raw(slave, opt.baud) || !set_raw(master, opt.baud)) {
+        perror("pty");
+        return 1;
+    }
+
+    size_t sats = opt.sats < ORBIT_TLM_MAX_RECORDS ? opt.sats : ORBIT_TLM_MAX_RECORDS;
+    std::atomic<bool> stop(false);
+    std::atomic<bool> done(false);
+    std::atomic<size_t> frame_len(0);
+
+    // Device side: the same encoder, records changing every message
+    std::thread writer([&] {
+        orbit_tlm_pos_t recs[ORBIT_TLM_MAX_RECORDS] = {};
+        uint8_t frame[ORBIT_TLM_FRAME_MAX];
+        for (uint32_t seq = 0; !stop.load(std::memory_order_relaxed); seq++) {
+            for (size_t k = 0; k < sats; k++) {
+                recs[k].norad_id = (uint32_t)(25544 + k);
+                recs[k].pos_km[0] = 6778.0f + (float)(seq % 1000);
+                recs[k].az_deg = (float)(seq % 360);
+                recs[k].el_deg = (float)k;
+            }
+            size_t len;
+            orbit_tlm_encode(seq, 1765321200000LL + seq * 100LL, recs, sats, frame, &len);
+            frame_len.store(len, std::memory_order_relaxed);
+            for (size_t off = 0; off < len;) {
+                ssize_t w = write(master, frame + off, len - off);
+                if (w <= 0) {
+                    break;
+                }
+                off += (size_t)w;
+            }
+        }
+        done = true;
+    });
+
+    frame_reader_t rd;
+    uint64_t records_ok = 0;
+    uint8_t buf[4096];
+    double t0 = now_s();
+    while (now_s() - t0 < opt.seconds) {
+        ssize_t n = read(slave, buf, sizeof(buf));
+        if (n <= 0) {
+            break;
+        }
+        rd.feed(buf, (size_t)n, [&](const orbit_tlm_hdr_t &hdr, const orbit_tlm_pos_t *recs) {
+            bool ok = hdr.count == sats;
+            for (size_t k = 0; k < hdr.count && ok; k++) {
+                ok = recs[k].norad_id == 25544 + k && recs[k].az_deg == (float)(hdr.seq % 360);
+            }
+            records_ok += ok ? hdr.count : 0;
+        });
+    }
+    double dt = now_s() - t0;
+    // Keep draining until the writer sees stop, it may be blocked on a full pty
+    stop = true;
+    fcntl(slave, F_SETFL, fcntl(slave, F_GETFL) | O_NONBLOCK);
+    while (!done) {
+        if (read(slave, buf, sizeof(buf)) <= 0) {
+            std::this_thread::yield();
+        }
+    }
+    writer.join();
+    close(slave);
+    close(master);
+
+    const counters_t &c = rd.cnt;
+    double uart_bytes_s = opt.baud / 10.0; // 8N1
+    printf("loopback: %zu records/msg, %zu bytes/frame, %.1f s\n", sats, frame_len.load(), dt);
+    printf("  %.0f msg/s sustained (%.0f records/s, %.1f MB/s), %llu msgs, %llu lost, %llu bad CRC, "
+           "%llu malformed, %llu records checked %s\n",
+           c.frames / dt, c.records / dt, c.bytes / dt / 1e6, (unsigned long long)c.frames,
+           (unsigned long long)c.lost, (unsigned long long)c.bad_crc, (unsigned long long)c.bad_other,
+           (unsigned long long)records_ok, records_ok == c.records ? "ok" : "MISMATCH");
+    printf("  a UART at %d baud carries %.0f msg/s of this size\n", opt.baud,
+           frame_len ? uart_bytes_s / frame_len.load() : 0.0);
+    return (c.lost || c.bad_crc || c.bad_other || records_ok != c.records || c.frames == 0) ? 1 : 0;
+}
+
+static void usage(void) {
+    fprintf(stderr, "usage: tlm_decode <port|file> [--baud B] [--stats]\n"
+                    "       tlm_decode --loopback [--seconds S] [--sats N] [--baud B]\n");
+}
+
+int main(int argc, char **argv) {
+    options_t opt;
+    for (int i = 1; i < argc; i++) {
+        bool has_val = i + 1 < argc;
+        if (!strcmp(argv[i], "--baud") && has_val) {
+            opt.baud = atoi(argv[++i]);
+        } else if (!strcmp(argv[i], "--stats")) {
+            opt.stats = true;
+        } else if (!strcmp(argv[i], "--loopback")) {
+            opt.loopback = true;
+        } else if (!strcmp(argv[i], "--seconds") && has_val) {
+            opt.seconds = atof(argv[++i]);
+        } else if (!strcmp(argv[i], "--sats") && has_val) {
+            opt.sats = strtoul(argv[++i], nullptr, 10);
+        } else if (argv[i][0] != '-' && !opt.path) {
+            opt.path = argv[i];
+        } else {
+            usage();
+            return 1;
+        }
+    }
+
+    if (opt.loopback) {
+        return run_loopback(opt);
+    }
+    if (!opt.path) {
+        usage();
+        return 1;
+    }
+    return run_reader(opt);
+}